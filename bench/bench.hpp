@@ -0,0 +1,144 @@
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace bench {
+	// Each run works through n elements `inner` times and is timed in
+	// batches of batch_size elements; every batch is one sample, in
+	// nanoseconds per element so sizes compare. The percentiles are over
+	// the batches of all runs, so p99 is the tail of short stretches of
+	// operations rather than of whole runs.
+	struct result {
+		std::string	container;
+		std::string	impl;
+		std::string	op;
+		std::size_t	size;
+		std::size_t	reps;
+		std::size_t	samples;
+		double		median_ns;
+		double		p99_ns;
+		double		min_ns;
+	};
+
+	struct options {
+		std::size_t	min_size;
+		std::size_t	max_size;
+		std::size_t	reps;
+		std::string	filter;
+		bool		json;
+
+		options() : min_size(10), max_size(1000000), reps(11), filter(), json(false) {}
+	};
+
+	// defeats dead-code elimination of the measured loops
+	extern volatile std::size_t sink;
+
+	inline double now_ns() {
+		return std::chrono::duration<double, std::nano>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	static const std::size_t batch_size = 128;
+
+	// batch timings in nanoseconds per element
+	class samples {
+	public:
+		void add(double ns, std::size_t elements) {
+			if (elements)
+				_ns.push_back(ns / static_cast<double>(elements));
+		}
+		std::vector<double>& values() {
+			return _ns;
+		}
+	private:
+		std::vector<double> _ns;
+	};
+
+	// calls op(i) for every i below n, timing batch_size calls at a time
+	template <class Op>
+	void timed_batches(samples& s, std::size_t n, Op op) {
+		for (std::size_t first = 0; first < n; first += batch_size) {
+			std::size_t last = std::min(n, first + batch_size);
+			double start = now_ns();
+			for (std::size_t i = first; i < last; ++i)
+				op(i);
+			s.add(now_ns() - start, last - first);
+		}
+	}
+
+	// nearest-rank percentile of a sorted sample
+	inline double percentile(const std::vector<double>& sorted, double p) {
+		std::size_t rank = static_cast<std::size_t>(std::ceil(p / 100.0 * sorted.size()));
+		if (rank == 0)
+			rank = 1;
+		if (rank > sorted.size())
+			rank = sorted.size();
+		return sorted[rank - 1];
+	}
+
+	// enough inner iterations that one run covers roughly 10^5 elements
+	inline std::size_t inner_loops(std::size_t n) {
+		return n >= 100000 ? 1 : 100000 / n;
+	}
+
+	// big sizes get fewer repetitions so one run stays in minutes
+	inline std::size_t reps_for(const options& opt, std::size_t n) {
+		if (n >= 10000000)
+			return std::min<std::size_t>(opt.reps, 3);
+		if (n >= 1000000)
+			return std::min<std::size_t>(opt.reps, 5);
+		return opt.reps;
+	}
+
+	// fn(samples&, inner) runs the operation; the first, untimed run warms up
+	template <class Fn>
+	result measure(const options& opt, const char* container, const char* impl, const char* op,
+				   std::size_t n, Fn fn) {
+		std::size_t inner = inner_loops(n);
+		std::size_t reps = reps_for(opt, n);
+		samples warmup;
+		fn(warmup, 1);
+		samples s;
+		for (std::size_t r = 0; r < reps; ++r)
+			fn(s, inner);
+		std::vector<double>& v = s.values();
+		std::sort(v.begin(), v.end());
+		result res;
+		res.container = container;
+		res.impl = impl;
+		res.op = op;
+		res.size = n;
+		res.reps = reps;
+		res.samples = v.size();
+		res.median_ns = v.size() % 2 ? v[v.size() / 2] : (v[v.size() / 2 - 1] + v[v.size() / 2]) / 2;
+		res.p99_ns = percentile(v, 99);
+		res.min_ns = v.front();
+		return res;
+	}
+
+	inline void print_header(const options& opt) {
+		if (!opt.json)
+			std::printf("container,impl,op,size,reps,samples,median_ns,p99_ns,min_ns\n");
+	}
+
+	inline void print(const options& opt, const result& r) {
+		if (opt.json)
+			std::printf("{\"container\":\"%s\",\"impl\":\"%s\",\"op\":\"%s\",\"size\":%zu,\"reps\":%zu,"
+						"\"samples\":%zu,\"median_ns\":%.3f,\"p99_ns\":%.3f,\"min_ns\":%.3f}\n",
+						r.container.c_str(), r.impl.c_str(), r.op.c_str(), r.size, r.reps, r.samples,
+						r.median_ns, r.p99_ns, r.min_ns);
+		else
+			std::printf("%s,%s,%s,%zu,%zu,%zu,%.3f,%.3f,%.3f\n", r.container.c_str(), r.impl.c_str(),
+						r.op.c_str(), r.size, r.reps, r.samples, r.median_ns, r.p99_ns, r.min_ns);
+		std::fflush(stdout);
+	}
+}
+
+#endif
@@ -0,0 +1,13 @@
+#!/bin/zsh
+# usage: ./bench.sh [--min N] [--max N] [--reps N] [--filter container/impl/op] [--json]
+# prints one CSV (or JSON) line per container/impl/op/size
+if [ 'clear' = "$1" ]
+then
+	rm -rf bench
+	rm -rf bench.dSYM
+	echo "\033[38;5;412mDelete output files\033[0m"
+	return
+fi
+
+clang++ -std=c++17 -Wall -Wextra -Werror -O3 -DNDEBUG main.cpp -o bench || exit 1
+./bench "$@"
@@ -0,0 +1,314 @@
+#include "bench.hpp"
+#include "../vector/vector.hpp"
+#include "../map/map.hpp"
+#include "../set/set.hpp"
+#include "../frozen_map/frozen_map.hpp"
+#include "../frozen_set/frozen_set.hpp"
+#include "../concurrent_map/concurrent_map.hpp"
+#include "../persistent_map/persistent_map.hpp"
+#include "../unordered_map/unordered_map.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+volatile std::size_t bench::sink = 0;
+
+namespace {
+	// inputs for one size: keys are even numbers in random order, misses odd
+	struct data {
+		std::vector<int>	random;
+		std::vector<int>	sorted;
+		std::vector<int>	misses;
+
+		explicit data(std::size_t n) {
+			std::mt19937 gen(12345);
+			for (std::size_t i = 0; i < n; ++i) {
+				sorted.push_back(static_cast<int>(i * 2));
+				misses.push_back(static_cast<int>(i * 2 + 1));
+			}
+			random = sorted;
+			std::shuffle(random.begin(), random.end(), gen);
+			std::shuffle(misses.begin(), misses.end(), gen);
+		}
+	};
+
+	inline int key_of(int k) {
+		return k;
+	}
+	template <class P>
+	inline int key_of(const P& p) {
+		return p.first;
+	}
+
+	// builds a value_type for maps (pair) and sets (the key itself)
+	template <class C, class V = typename C::value_type>
+	struct make_value {
+		static V get(int k) {
+			return V(k, k);
+		}
+	};
+	template <class C>
+	struct make_value<C, int> {
+		static int get(int k) {
+			return k;
+		}
+	};
+
+	bool selected(const bench::options& opt, const char* container, const char* impl, const char* op) {
+		if (opt.filter.empty())
+			return true;
+		std::string name = std::string(container) + "/" + impl + "/" + op;
+		return name.find(opt.filter) != std::string::npos;
+	}
+
+	// setup of large sizes is expensive, so skip it when the filter rules out every op
+	template <std::size_t N>
+	bool any_selected(const bench::options& opt, const char* container, const char* impl, const char* const (&ops)[N]) {
+		for (std::size_t i = 0; i < N; ++i) {
+			if (selected(opt, container, impl, ops[i]))
+				return true;
+		}
+		return false;
+	}
+
+	// ordered and unordered associative containers share the same workload
+	template <class C>
+	struct assoc {
+		static C build(const std::vector<int>& keys) {
+			C c;
+			for (std::size_t i = 0; i < keys.size(); ++i)
+				c.insert(make_value<C>::get(keys[i]));
+			return c;
+		}
+		// the container is destroyed after its last batch, out of the timing
+		static void insert(bench::samples& s, const std::vector<int>& keys, std::size_t inner) {
+			for (std::size_t r = 0; r < inner; ++r) {
+				C c;
+				bench::timed_batches(s, keys.size(), [&](std::size_t i) { c.insert(make_value<C>::get(keys[i])); });
+				bench::sink += c.size();
+			}
+		}
+		static void find(bench::samples& s, const C& c, const std::vector<int>& keys, std::size_t inner) {
+			std::size_t hits = 0;
+			for (std::size_t r = 0; r < inner; ++r)
+				bench::timed_batches(s, keys.size(), [&](std::size_t i) { hits += c.find(keys[i]) != c.end(); });
+			bench::sink += hits;
+		}
+		static void iterate(bench::samples& s, const C& c, std::size_t inner) {
+			std::size_t sum = 0;
+			for (std::size_t r = 0; r < inner; ++r) {
+				typename C::const_iterator it = c.begin();
+				bench::timed_batches(s, c.size(), [&](std::size_t) { sum += key_of(*it++); });
+			}
+			bench::sink += sum;
+		}
+		static void erase(bench::samples& s, const C& c, const std::vector<int>& keys, std::size_t inner) {
+			for (std::size_t r = 0; r < inner; ++r) {
+				C victim(c);
+				bench::timed_batches(s, keys.size(), [&](std::size_t i) { victim.erase(keys[i]); });
+				bench::sink += victim.size();
+			}
+		}
+		// whole-container operations are one sample per run
+		static void copy(bench::samples& s, const C& c, std::size_t inner) {
+			for (std::size_t r = 0; r < inner; ++r) {
+				double start = bench::now_ns();
+				C dup(c);
+				s.add(bench::now_ns() - start, c.size());
+				bench::sink += dup.size();
+			}
+		}
+		static void range_insert(bench::samples& s, const std::vector<typename C::value_type>& values, std::size_t inner) {
+			for (std::size_t r = 0; r < inner; ++r) {
+				C c;
+				double start = bench::now_ns();
+				c.insert(values.begin(), values.end());
+				s.add(bench::now_ns() - start, values.size());
+				bench::sink += c.size();
+			}
+		}
+
+		static void run(const bench::options& opt, const char* container, const char* impl, std::size_t n) {
+			static const char* const ops[] = {"insert_random", "insert_sorted", "find_hit", "find_miss",
+				"iterate", "erase_random", "copy", "range_insert"};
+			if (!any_selected(opt, container, impl, ops))
+				return;
+			data d(n);
+			C full = build(d.random);
+			std::vector<typename C::value_type> values;
+			for (std::size_t i = 0; i < n; ++i)
+				values.push_back(make_value<C>::get(d.random[i]));
+			if (selected(opt, container, impl, "insert_random"))
+				bench::print(opt, bench::measure(opt, container, impl, "insert_random", n,
+					[&](bench::samples& s, std::size_t inner) { insert(s, d.random, inner); }));
+			if (selected(opt, container, impl, "insert_sorted"))
+				bench::print(opt, bench::measure(opt, container, impl, "insert_sorted", n,
+					[&](bench::samples& s, std::size_t inner) { insert(s, d.sorted, inner); }));
+			if (selected(opt, container, impl, "find_hit"))
+				bench::print(opt, bench::measure(opt, container, impl, "find_hit", n,
+					[&](bench::samples& s, std::size_t inner) { find(s, full, d.random, inner); }));
+			if (selected(opt, container, impl, "find_miss"))
+				bench::print(opt, bench::measure(opt, container, impl, "find_miss", n,
+					[&](bench::samples& s, std::size_t inner) { find(s, full, d.misses, inner); }));
+			if (selected(opt, container, impl, "iterate"))
+				bench::print(opt, bench::measure(opt, container, impl, "iterate", n,
+					[&](bench::samples& s, std::size_t inner) { iterate(s, full, inner); }));
+			if (selected(opt, container, impl, "erase_random"))
+				bench::print(opt, bench::measure(opt, container, impl, "erase_random", n,
+					[&](bench::samples& s, std::size_t inner) { erase(s, full, d.random, inner); }));
+			if (selected(opt, container, impl, "copy"))
+				bench::print(opt, bench::measure(opt, container, impl, "copy", n,
+					[&](bench::samples& s, std::size_t inner) { copy(s, full, inner); }));
+			if (selected(opt, container, impl, "range_insert"))
+				bench::print(opt, bench::measure(opt, container, impl, "range_insert", n,
+					[&](bench::samples& s, std::size_t inner) { range_insert(s, values, inner); }));
+		}
+	};
+
+	// any comparator but std::less keeps frozen containers on the Eytzinger layout
+	struct int_less {
+		bool operator()(int a, int b) const {
+			return a < b;
+		}
+	};
+
+	// read-only containers: built once, then only queried
+	template <class C>
+	struct lookup {
+		static void run(const bench::options& opt, const char* container, const char* impl, std::size_t n) {
+			static const char* const ops[] = {"find_hit", "find_miss", "iterate"};
+			if (!any_selected(opt, container, impl, ops))
+				return;
+			data d(n);
+			std::vector<typename C::value_type> values;
+			for (std::size_t i = 0; i < n; ++i)
+				values.push_back(make_value<C>::get(d.random[i]));
+			C full(values.begin(), values.end());
+			if (selected(opt, container, impl, "find_hit"))
+				bench::print(opt, bench::measure(opt, container, impl, "find_hit", n,
+					[&](bench::samples& s, std::size_t inner) { assoc<C>::find(s, full, d.random, inner); }));
+			if (selected(opt, container, impl, "find_miss"))
+				bench::print(opt, bench::measure(opt, container, impl, "find_miss", n,
+					[&](bench::samples& s, std::size_t inner) { assoc<C>::find(s, full, d.misses, inner); }));
+			if (selected(opt, container, impl, "iterate"))
+				bench::print(opt, bench::measure(opt, container, impl, "iterate", n,
+					[&](bench::samples& s, std::size_t inner) { assoc<C>::iterate(s, full, inner); }));
+		}
+	};
+
+	template <class V>
+	struct sequence {
+		static void push_back(bench::samples& s, std::size_t n, std::size_t inner) {
+			for (std::size_t r = 0; r < inner; ++r) {
+				V v;
+				bench::timed_batches(s, n, [&](std::size_t i) { v.push_back(static_cast<int>(i)); });
+				bench::sink += v.size();
+			}
+		}
+		static void iterate(bench::samples& s, const V& v, std::size_t inner) {
+			std::size_t sum = 0;
+			for (std::size_t r = 0; r < inner; ++r) {
+				typename V::const_iterator it = v.begin();
+				bench::timed_batches(s, v.size(), [&](std::size_t) { sum += *it++; });
+			}
+			bench::sink += sum;
+		}
+		static void copy(bench::samples& s, const V& v, std::size_t inner) {
+			for (std::size_t r = 0; r < inner; ++r) {
+				double start = bench::now_ns();
+				V dup(v);
+				s.add(bench::now_ns() - start, v.size());
+				bench::sink += dup.size();
+			}
+		}
+		static void range_insert(bench::samples& s, const V& v, std::size_t inner) {
+			for (std::size_t r = 0; r < inner; ++r) {
+				V dst;
+				double start = bench::now_ns();
+				dst.insert(dst.end(), v.begin(), v.end());
+				s.add(bench::now_ns() - start, v.size());
+				bench::sink += dst.size();
+			}
+		}
+		static void erase_back(bench::samples& s, const V& v, std::size_t inner) {
+			for (std::size_t r = 0; r < inner; ++r) {
+				V victim(v);
+				bench::timed_batches(s, v.size(), [&](std::size_t) { victim.erase(victim.end() - 1); });
+			}
+		}
+
+		static void run(const bench::options& opt, const char* container, const char* impl, std::size_t n) {
+			static const char* const ops[] = {"push_back", "iterate", "copy", "range_insert", "erase"};
+			if (!any_selected(opt, container, impl, ops))
+				return;
+			V full;
+			for (std::size_t i = 0; i < n; ++i)
+				full.push_back(static_cast<int>(i));
+			if (selected(opt, container, impl, "push_back"))
+				bench::print(opt, bench::measure(opt, container, impl, "push_back", n,
+					[&](bench::samples& s, std::size_t inner) { push_back(s, n, inner); }));
+			if (selected(opt, container, impl, "iterate"))
+				bench::print(opt, bench::measure(opt, container, impl, "iterate", n,
+					[&](bench::samples& s, std::size_t inner) { iterate(s, full, inner); }));
+			if (selected(opt, container, impl, "copy"))
+				bench::print(opt, bench::measure(opt, container, impl, "copy", n,
+					[&](bench::samples& s, std::size_t inner) { copy(s, full, inner); }));
+			if (selected(opt, container, impl, "range_insert"))
+				bench::print(opt, bench::measure(opt, container, impl, "range_insert", n,
+					[&](bench::samples& s, std::size_t inner) { range_insert(s, full, inner); }));
+			if (selected(opt, container, impl, "erase"))
+				bench::print(opt, bench::measure(opt, container, impl, "erase", n,
+					[&](bench::samples& s, std::size_t inner) { erase_back(s, full, inner); }));
+		}
+	};
+
+	void usage(const char* name) {
+		std::fprintf(stderr, "usage: %s [--min N] [--max N] [--reps N] [--filter container/impl/op] [--json]\n", name);
+		std::exit(1);
+	}
+}
+
+int main(int argc, char** argv) {
+	bench::options opt;
+	for (int i = 1; i < argc; ++i) {
+		if (!std::strcmp(argv[i], "--json"))
+			opt.json = true;
+		else if (i + 1 < argc && !std::strcmp(argv[i], "--min"))
+			opt.min_size = std::strtoul(argv[++i], 0, 10);
+		else if (i + 1 < argc && !std::strcmp(argv[i], "--max"))
+			opt.max_size = std::strtoul(argv[++i], 0, 10);
+		else if (i + 1 < argc && !std::strcmp(argv[i], "--reps"))
+			opt.reps = std::strtoul(argv[++i], 0, 10);
+		else if (i + 1 < argc && !std::strcmp(argv[i], "--filter"))
+			opt.filter = argv[++i];
+		else
+			usage(argv[0]);
+	}
+	if (opt.reps == 0 || opt.min_size == 0)
+		usage(argv[0]);
+	bench::print_header(opt);
+	for (std::size_t n = 10; n <= opt.max_size; n *= 10) {
+		if (n < opt.min_size)
+			continue;
+		sequence<ft::vector<int> >::run(opt, "vector", "ft", n);
+		sequence<std::vector<int> >::run(opt, "vector", "std", n);
+		assoc<ft::map<int, int> >::run(opt, "map", "ft", n);
+		assoc<ft::compact_map<int, int> >::run(opt, "map", "ft_compact", n);
+		assoc<ft::arena_map<int, int> >::run(opt, "map", "ft_arena", n);
+		assoc<ft::btree_map<int, int> >::run(opt, "map", "ft_btree", n);
+		lookup<ft::frozen_map<int, int> >::run(opt, "map", "ft_frozen", n);
+		assoc<ft::persistent_map<int, int> >::run(opt, "map", "ft_persistent", n);
+		lookup<ft::concurrent_map<int, int> >::run(opt, "map", "ft_concurrent", n);
+		assoc<std::map<int, int> >::run(opt, "map", "std", n);
+		assoc<ft::set<int> >::run(opt, "set", "ft", n);
+		lookup<ft::frozen_set<int> >::run(opt, "set", "ft_frozen", n);
+		lookup<ft::frozen_set<int, int_less> >::run(opt, "set", "ft_eytzinger", n);
+		assoc<std::set<int> >::run(opt, "set", "std", n);
+		assoc<ft::unordered_map<int, int> >::run(opt, "unordered_map", "ft", n);
+		assoc<std::unordered_map<int, int> >::run(opt, "unordered_map", "std", n);
+	}
+}
@@ -0,0 +1,176 @@
+#ifndef CONCURRENT_MAP_HPP
+#define CONCURRENT_MAP_HPP
+
+#include <iostream>
+#include <stdexcept>
+#include "../tree/skip_list.hpp"
+#include "../map/get_first.hpp"
+#include "../utility/type_traits.hpp"
+
+namespace ft {
+	// Ordered map any number of threads can read and write at once, with
+	// no lock: a lock-free skip list, where an insert or erase only
+	// changes the links around its own key. Elements are read-only, so a
+	// value is changed by erasing and inserting it again. Memory is freed
+	// by epochs: each call is safe on its own, but an iterator (from
+	// begin(), find(), insert() ...) may only be used while a guard taken
+	// before getting it is alive, as the element may be erased and freed
+	// otherwise. Iterators are forward only.
+	template <class Key, class T, class Compare = std::less<Key>, class Allocator = std::allocator<ft::pair<const Key, T> > >
+	class concurrent_map {
+	public:
+
+		// DEF
+
+		typedef Key									key_type;
+		typedef T									mapped_type;
+		typedef ft::pair<const Key, T>				value_type;
+		typedef std::size_t							size_type;
+		typedef std::ptrdiff_t						difference_type;
+		typedef Compare								key_compare;
+		typedef Allocator							allocator_type;
+		typedef const value_type&					reference;
+		typedef const value_type&					const_reference;
+		typedef typename Allocator::const_pointer	pointer;
+		typedef typename Allocator::const_pointer	const_pointer;
+	private:
+		typedef skipList<key_type, value_type, ft::get_first<value_type>, key_compare, allocator_type> list;
+		list _list;
+	public:
+		typedef typename list::iterator iterator;
+		typedef typename list::const_iterator const_iterator;
+
+		// GUARD CLASS
+
+		// Keeps every element reachable when it was made from being freed
+		// until it is destroyed; hold one per thread while using iterators.
+		class guard {
+		public:
+			explicit guard(const concurrent_map& m) : _guard(m._list.domain()) {}
+		private:
+			guard(const guard&);
+			guard& operator=(const guard&);
+
+			epoch_domain::guard _guard;
+		};
+
+		// VALUE COMPARE CLASS
+
+		class value_compare {
+			friend class concurrent_map;
+		public:
+			typedef bool result_type;
+			typedef value_type first_argument_type;
+			typedef value_type second_argument_type;
+
+			bool operator()(const value_type& lhs, const value_type& rhs) const {
+				return comp(lhs.first, rhs.first);
+			}
+
+		protected:
+			Compare comp;
+			value_compare(Compare c) : comp(c) {}
+		};
+
+		// CONSTRUCTORS + DESTRUCTOR
+
+		explicit concurrent_map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) :
+			_list(comp, alloc) {}
+
+		template<class InputIterator>
+		concurrent_map(InputIterator first, InputIterator last, const key_compare& comp = key_compare(),
+			const allocator_type& alloc = allocator_type()) : _list(comp, alloc) {
+			_list.insert(first, last);
+		}
+
+		// MEMBER FUNCTIONS
+
+		// by value: the element may be erased as soon as the lookup returns
+		mapped_type at(const key_type& k) const {
+			guard g(*this);
+			const_iterator it = _list.find(k);
+			if (it == _list.end())
+				throw std::out_of_range("concurrent_map::at");
+			return it->second;
+		}
+		const_iterator begin() const {
+			return _list.begin();
+		}
+		// erases the elements there when it starts; ones inserted meanwhile may stay
+		void clear() {
+			_list.clear();
+		}
+		size_type count(const key_type& k) const {
+			return _list.count(k);
+		}
+		template<class K, class = typename ft::transparent_key<Compare, K>::type>
+		size_type count(const K& k) const {
+			return _list.count(k);
+		}
+		bool empty() const {
+			return _list.empty();
+		}
+		const_iterator end() const {
+			return _list.end();
+		}
+		ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+			return ft::pair<const_iterator, const_iterator>(_list.lower_bound(k), _list.upper_bound(k));
+		}
+		template<class K, class = typename ft::transparent_key<Compare, K>::type>
+		ft::pair<const_iterator, const_iterator> equal_range(const K& k) const {
+			return ft::pair<const_iterator, const_iterator>(_list.lower_bound(k), _list.upper_bound(k));
+		}
+		size_type erase(const key_type& k) {
+			return _list.erase(k);
+		}
+		const_iterator find(const key_type& k) const {
+			return _list.find(k);
+		}
+		template<class K, class = typename ft::transparent_key<Compare, K>::type>
+		const_iterator find(const K& k) const {
+			return _list.find(k);
+		}
+		allocator_type get_allocator() const {
+			return _list.get_allocator();
+		}
+		ft::pair<const_iterator, bool> insert(const value_type& val) {
+			return _list.insert(val);
+		}
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last) {
+			_list.insert(first, last);
+		}
+		key_compare key_comp() const {
+			return _list.key_comp();
+		}
+		const_iterator lower_bound(const key_type& k) const {
+			return _list.lower_bound(k);
+		}
+		template<class K, class = typename ft::transparent_key<Compare, K>::type>
+		const_iterator lower_bound(const K& k) const {
+			return _list.lower_bound(k);
+		}
+		size_type max_size() const {
+			return _list.max_size();
+		}
+		// exact when no write is under way
+		size_type size() const {
+			return _list.size();
+		}
+		const_iterator upper_bound(const key_type& k) const {
+			return _list.upper_bound(k);
+		}
+		template<class K, class = typename ft::transparent_key<Compare, K>::type>
+		const_iterator upper_bound(const K& k) const {
+			return _list.upper_bound(k);
+		}
+		value_compare value_comp() const {
+			return value_compare(_list.key_comp());
+		}
+	private:
+		concurrent_map(const concurrent_map&);
+		concurrent_map& operator=(const concurrent_map&);
+	};
+}
+
+#endif
@@ -0,0 +1,135 @@
+#include "concurrent_map.hpp"
+#include "../vector/vector.hpp"
+#include <map>
+#include <string>
+#include <thread>
+
+template <class M>
+void print_map(const M &v)
+{
+	typename M::guard g(v);
+	typename M::const_iterator begin = v.begin();
+	typename M::const_iterator end = v.end();
+	std::cout << "size=\t\t" << v.size() << std::endl;
+	for (; begin != end; begin++)
+		std::cout << "\033[38;5;46m" << begin->first << "->" << begin->second << "\033[0m ";
+	std::cout << std::endl;
+}
+
+void map_test_basic() {
+	ft::pair<int, std::string> init[] = {
+		ft::pair<int, std::string>(5, "five"), ft::pair<int, std::string>(1, "one"), ft::pair<int, std::string>(3, "three")
+	};
+	ft::concurrent_map<int, std::string> m(init, init + 3);
+	print_map(m);
+	std::cout << m.insert(ft::pair<const int, std::string>(2, "two")).second
+		<< m.insert(ft::pair<const int, std::string>(2, "deux")).second << std::endl;
+	std::cout << m.erase(3) << m.erase(3) << m.count(3) << m.count(2) << " " << m.at(2) << std::endl;
+	{
+		ft::concurrent_map<int, std::string>::guard g(m);
+		std::cout << m.find(5)->second << " " << m.lower_bound(3)->first << " " << m.upper_bound(2)->first << " "
+			<< (m.upper_bound(5) == m.end()) << (m.find(4) == m.end()) << std::endl;
+		ft::pair<ft::concurrent_map<int, std::string>::const_iterator, ft::concurrent_map<int, std::string>::const_iterator>
+			r = m.equal_range(1);
+		std::cout << r.first->first << " " << r.second->first << std::endl;
+	}
+	try {
+		m.at(3);
+	}
+	catch (std::out_of_range&) {
+		std::cout << "out of range" << std::endl;
+	}
+	print_map(m);
+	m.clear();
+	print_map(m);
+	std::cout << m.empty() << std::endl;
+}
+
+// 32 producers insert interleaved keys while erasers and readers run; the
+// readers check that every walk is in order
+void map_test_threads() {
+	const int producers = 32;
+	const int per = 2000;
+	ft::concurrent_map<int, int> m;
+	std::atomic<bool> stop(false);
+	std::atomic<int> unordered(0);
+	std::atomic<int> erased(0);
+	ft::vector<std::thread*> threads;
+	for (int t = 0; t < 2; ++t) {
+		threads.push_back(new std::thread([&m, &stop, &unordered]() {
+			while (!stop.load()) {
+				ft::concurrent_map<int, int>::guard g(m);
+				int last = -1;
+				for (ft::concurrent_map<int, int>::const_iterator it = m.begin(); it != m.end(); ++it) {
+					if (it->first <= last || it->second != it->first * 2)
+						++unordered;
+					last = it->first;
+				}
+			}
+		}));
+	}
+	for (int t = 0; t < 2; ++t) {
+		threads.push_back(new std::thread([&m, &stop, &erased, t]() {
+			// odd keys congruent to t mod 4, retried until the producer got there
+			for (int k = 2 * t + 1; k < producers * per && !stop.load(); k += 4) {
+				while (!m.erase(k) && !stop.load())
+					std::this_thread::yield();
+				++erased;
+			}
+		}));
+	}
+	ft::vector<std::thread*> writers;
+	for (int t = 0; t < producers; ++t) {
+		writers.push_back(new std::thread([&m, t]() {
+			for (int i = 0; i < per; ++i) {
+				int k = i * producers + t;
+				m.insert(ft::pair<const int, int>(k, k * 2));
+			}
+		}));
+	}
+	for (std::size_t t = 0; t < writers.size(); ++t) {
+		writers[t]->join();
+		delete writers[t];
+	}
+	while (erased.load() < producers * per / 2)
+		std::this_thread::yield();
+	stop.store(true);
+	for (std::size_t t = 0; t < threads.size(); ++t) {
+		threads[t]->join();
+		delete threads[t];
+	}
+	ft::concurrent_map<int, int>::guard g(m);
+	bool same = true;
+	int k = 0;
+	for (ft::concurrent_map<int, int>::const_iterator it = m.begin(); same && it != m.end(); ++it, k += 2)
+		same = it->first == k && it->second == k * 2;
+	same = same && k == producers * per;
+	std::cout << "unordered " << unordered.load() << " same " << same << " size " << m.size() << std::endl;
+}
+
+// a thread holds more nested guards than there are reader slots; each
+// call inside takes one more
+void map_test_nested_guards() {
+	ft::concurrent_map<int, int> m;
+	for (int i = 0; i < 10; ++i)
+		m.insert(ft::pair<const int, int>(i, i * i));
+	ft::vector<ft::concurrent_map<int, int>::guard*> guards;
+	for (std::size_t i = 0; i < ft::epoch_domain::max_readers * 2; ++i)
+		guards.push_back(new ft::concurrent_map<int, int>::guard(m));
+	ft::concurrent_map<int, int>::const_iterator it = m.find(7);
+	std::thread eraser([&m]() {
+		m.erase(7);
+		m.insert(ft::pair<const int, int>(20, 400));
+	});
+	eraser.join();
+	std::cout << it->second << " " << m.count(7) << " " << m.at(20) << std::endl;
+	for (std::size_t i = 0; i < guards.size(); ++i)
+		delete guards[i];
+	std::cout << m.size() << std::endl;
+}
+
+int main() {
+	map_test_basic();
+	map_test_nested_guards();
+	map_test_threads();
+}
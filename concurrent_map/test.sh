@@ -0,0 +1,25 @@
+#!/bin/zsh
+if [ 'clear' = "$1" ]
+then
+	rm -rf ft_output
+	rm -rf a.out
+	rm -rf ft_concurrent_map
+	rm -rf a.out.dSYM
+	rm -rf concurrent_map.dSYM
+	echo "\033[38;5;412mDelete output files\033[0m"
+	return
+fi
+
+# no std counterpart: 32 producers insert while erasers and readers run,
+# and the readers count the walks that come out of order
+clear
+clang++ -Wall -Wextra -Werror -pthread main.cpp -o ft_concurrent_map -Ofast
+time ./ft_concurrent_map > ft_output
+
+if [ $? -eq 0 ] && grep "unordered 0 same 1" ft_output > /dev/null
+then
+	echo "\033[32mWalks 0 unordered OK!\033[0m"
+else
+	echo "\033[31mWalks unordered ERROR\033[0m"
+fi
+rm -rf ft_concurrent_map
@@ -0,0 +1,495 @@
+#ifndef FLAT_MAP_HPP
+#define FLAT_MAP_HPP
+
+#include <iostream>
+#include <algorithm>
+#include "../vector/vector.hpp"
+#include "../iterator/iterator_traits.hpp"
+#include "../tree/pair.hpp"
+#include "../utility/sorted_unique.hpp"
+
+namespace ft {
+	template <typename Key, typename T, bool Const>
+	class flat_map_iterator {
+	public:
+		typedef typename ft::conditional<Const, const T, T>::type			mapped_type;
+		typedef ft::pair<const Key, T>								value_type;
+		typedef ft::pair<const Key&, mapped_type&>					reference;
+		typedef std::ptrdiff_t										difference_type;
+		typedef std::random_access_iterator_tag						iterator_category;
+
+		// operator-> has to hand out the address of a pair of references
+		struct pointer {
+			reference ref;
+			explicit pointer(const reference& r) : ref(r) {}
+			const reference* operator->() const {
+				return &ref;
+			}
+		};
+
+		flat_map_iterator() : _key(0), _val(0) {}
+		flat_map_iterator(const Key* key, mapped_type* val) : _key(key), _val(val) {}
+		template<bool C>
+		flat_map_iterator(const flat_map_iterator<Key, T, C>& other) : _key(other.key_base()), _val(other.mapped_base()) {}
+
+		const Key* key_base() const {
+			return _key;
+		}
+		mapped_type* mapped_base() const {
+			return _val;
+		}
+		reference operator*() const {
+			return reference(*_key, *_val);
+		}
+		pointer operator->() const {
+			return pointer(**this);
+		}
+		reference operator[](difference_type n) const {
+			return reference(_key[n], _val[n]);
+		}
+		flat_map_iterator& operator++() {
+			++_key, ++_val;
+			return *this;
+		}
+		flat_map_iterator operator++(int) {
+			flat_map_iterator tmp = *this;
+			++_key, ++_val;
+			return tmp;
+		}
+		flat_map_iterator& operator--() {
+			--_key, --_val;
+			return *this;
+		}
+		flat_map_iterator operator--(int) {
+			flat_map_iterator tmp = *this;
+			--_key, --_val;
+			return tmp;
+		}
+		flat_map_iterator& operator+=(difference_type n) {
+			_key += n, _val += n;
+			return *this;
+		}
+		flat_map_iterator& operator-=(difference_type n) {
+			_key -= n, _val -= n;
+			return *this;
+		}
+		flat_map_iterator operator+(difference_type n) const {
+			return flat_map_iterator(_key + n, _val + n);
+		}
+		flat_map_iterator operator-(difference_type n) const {
+			return flat_map_iterator(_key - n, _val - n);
+		}
+		template <bool C>
+		difference_type operator-(const flat_map_iterator<Key, T, C>& other) const {
+			return _key - other.key_base();
+		}
+		template <bool C>
+		bool operator==(const flat_map_iterator<Key, T, C>& other) const {
+			return _key == other.key_base();
+		}
+		template <bool C>
+		bool operator!=(const flat_map_iterator<Key, T, C>& other) const {
+			return _key != other.key_base();
+		}
+		template <bool C>
+		bool operator<(const flat_map_iterator<Key, T, C>& other) const {
+			return _key < other.key_base();
+		}
+		template <bool C>
+		bool operator>(const flat_map_iterator<Key, T, C>& other) const {
+			return _key > other.key_base();
+		}
+		template <bool C>
+		bool operator<=(const flat_map_iterator<Key, T, C>& other) const {
+			return _key <= other.key_base();
+		}
+		template <bool C>
+		bool operator>=(const flat_map_iterator<Key, T, C>& other) const {
+			return _key >= other.key_base();
+		}
+	private:
+		const Key*		_key;
+		mapped_type*	_val;
+	};
+
+	// Sorted associative container on two parallel ft::vectors: the keys are
+	// contiguous, so lookups binary search a plain array, and the mapped
+	// values live in a second array at the same index.
+	template <class Key, class T, class Compare = std::less<Key>, class Allocator = std::allocator<ft::pair<const Key, T> > >
+	class flat_map {
+	public:
+
+		// DEF
+
+		typedef Key									key_type;
+		typedef T									mapped_type;
+		typedef ft::pair<const Key, T>				value_type;
+		typedef std::size_t							size_type;
+		typedef std::ptrdiff_t						difference_type;
+		typedef Compare								key_compare;
+		typedef Allocator							allocator_type;
+		typedef ft::pair<const Key&, T&>			reference;
+		typedef ft::pair<const Key&, const T&>		const_reference;
+		typedef typename Allocator::template rebind<Key>::other	key_allocator;
+		typedef typename Allocator::template rebind<T>::other	mapped_allocator;
+		typedef ft::vector<Key, key_allocator>		key_container_type;
+		typedef ft::vector<T, mapped_allocator>		mapped_container_type;
+		typedef flat_map_iterator<Key, T, false>	iterator;
+		typedef flat_map_iterator<Key, T, true>		const_iterator;
+		typedef ft::reverse_iterator<iterator>		reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>	const_reverse_iterator;
+		typedef typename iterator::pointer			pointer;
+		typedef typename const_iterator::pointer	const_pointer;
+
+		// VALUE COMPARE CLASS
+
+		class value_compare {
+			friend class flat_map;
+		public:
+			typedef bool result_type;
+			typedef value_type first_argument_type;
+			typedef value_type second_argument_type;
+
+			template <class P1, class P2>
+			bool operator()(const P1& lhs, const P2& rhs) const {
+				return comp(lhs.first, rhs.first);
+			}
+
+		protected:
+			Compare comp;
+			value_compare(Compare c) : comp(c) {}
+		};
+
+		// CONSTRUCTORS + DESTRUCTOR
+
+		explicit flat_map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) :
+			_keys(key_allocator(alloc)), _values(mapped_allocator(alloc)), _comp(comp), _allocator(alloc) {}
+
+		template<class InputIterator>
+		flat_map(InputIterator first, InputIterator last, const key_compare& comp = key_compare(),
+			const allocator_type& alloc = allocator_type()) :
+			_keys(key_allocator(alloc)), _values(mapped_allocator(alloc)), _comp(comp), _allocator(alloc) {
+			insert(first, last);
+		}
+
+		template<class InputIterator>
+		flat_map(ft::sorted_unique_t, InputIterator first, InputIterator last, const key_compare& comp = key_compare(),
+			const allocator_type& alloc = allocator_type()) :
+			_keys(key_allocator(alloc)), _values(mapped_allocator(alloc)), _comp(comp), _allocator(alloc) {
+			insert(ft::sorted_unique, first, last);
+		}
+
+		flat_map(const flat_map& x) : _keys(x._keys), _values(x._values), _comp(x._comp), _allocator(x._allocator) {}
+
+		// OPERATORS
+
+		flat_map& operator=(const flat_map& other) {
+			if (this != &other) {
+				_keys = other._keys;
+				_values = other._values;
+				_comp = other._comp;
+			}
+			return *this;
+		}
+		mapped_type& operator[](const key_type& k) {
+			size_type i = _lower_index(k);
+			if (i == _keys.size() || _comp(k, _keys[i]))
+				_insert_at(i, k, mapped_type());
+			return _values[i];
+		}
+
+		// MEMBER FUNCTIONS
+
+		iterator begin() {
+			return _make_iter(0);
+		}
+		const_iterator begin() const {
+			return _make_iter(0);
+		}
+		void clear() {
+			_keys.clear();
+			_values.clear();
+		}
+		size_type count(const key_type& k) const {
+			return find(k) == end() ? 0 : 1;
+		}
+		bool empty() const {
+			return _keys.empty();
+		}
+		iterator end() {
+			return _make_iter(_keys.size());
+		}
+		const_iterator end() const {
+			return _make_iter(_keys.size());
+		}
+		ft::pair<iterator, iterator> equal_range(const key_type& k) {
+			return ft::pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+		}
+		ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+			return ft::pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+		}
+		void erase(iterator position) {
+			size_type i = position - begin();
+			_keys.erase(_keys.begin() + i);
+			_values.erase(_values.begin() + i);
+		}
+		size_type erase(const key_type& k) {
+			iterator it = find(k);
+			if (it == end())
+				return 0;
+			erase(it);
+			return 1;
+		}
+		void erase(iterator first, iterator last) {
+			size_type f = first - begin();
+			size_type l = last - begin();
+			_keys.erase(_keys.begin() + f, _keys.begin() + l);
+			_values.erase(_values.begin() + f, _values.begin() + l);
+		}
+		iterator find(const key_type& k) {
+			size_type i = _lower_index(k);
+			return (i == _keys.size() || _comp(k, _keys[i])) ? end() : _make_iter(i);
+		}
+		const_iterator find(const key_type& k) const {
+			size_type i = _lower_index(k);
+			return (i == _keys.size() || _comp(k, _keys[i])) ? end() : _make_iter(i);
+		}
+		allocator_type get_allocator() const {
+			return _allocator;
+		}
+		ft::pair<iterator, bool> insert(const value_type& val) {
+			size_type i = _lower_index(val.first);
+			if (i != _keys.size() && !_comp(val.first, _keys[i]))
+				return ft::pair<iterator, bool>(_make_iter(i), false);
+			return ft::pair<iterator, bool>(_insert_at(i, val.first, val.second), true);
+		}
+		iterator insert(iterator position, const value_type& val) {
+			size_type i = position - begin();
+			if ((i == 0 || _comp(_keys[i - 1], val.first)) && (i == _keys.size() || _comp(val.first, _keys[i])))
+				return _insert_at(i, val.first, val.second);
+			return insert(val).first;
+		}
+		// batched insert: the new elements are sorted on the side and merged
+		// in one pass instead of shifting the arrays once per element
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last) {
+			ft::vector<ft::pair<Key, T> > batch;
+			for (; first != last; ++first)
+				batch.push_back(ft::pair<Key, T>((*first).first, (*first).second));
+			if (batch.empty())
+				return;
+			std::stable_sort(&batch[0], &batch[0] + batch.size(), _pair_compare(_comp));
+			size_type n = 1;
+			for (size_type i = 1; i < batch.size(); ++i) {
+				if (_comp(batch[n - 1].first, batch[i].first))
+					batch[n++] = batch[i];
+			}
+			batch.erase(batch.begin() + n, batch.end());
+			_merge(batch.begin(), batch.end());
+		}
+		template<class InputIterator>
+		void insert(ft::sorted_unique_t, InputIterator first, InputIterator last) {
+			_merge(first, last);
+		}
+		key_compare key_comp() const {
+			return _comp;
+		}
+		const key_container_type& keys() const {
+			return _keys;
+		}
+		iterator lower_bound(const key_type& k) {
+			return _make_iter(_lower_index(k));
+		}
+		const_iterator lower_bound(const key_type& k) const {
+			return _make_iter(_lower_index(k));
+		}
+		size_type max_size() const {
+			return _keys.max_size() < _values.max_size() ? _keys.max_size() : _values.max_size();
+		}
+		reverse_iterator rbegin() {
+			return reverse_iterator(end());
+		}
+		const_reverse_iterator rbegin() const {
+			return const_reverse_iterator(end());
+		}
+		reverse_iterator rend() {
+			return reverse_iterator(begin());
+		}
+		const_reverse_iterator rend() const {
+			return const_reverse_iterator(begin());
+		}
+		void reserve(size_type n) {
+			_keys.reserve(n);
+			_values.reserve(n);
+		}
+		size_type size() const {
+			return _keys.size();
+		}
+		void swap(flat_map& x) {
+			_keys.swap(x._keys);
+			_values.swap(x._values);
+			std::swap(_comp, x._comp);
+		}
+		iterator upper_bound(const key_type& k) {
+			return _make_iter(_upper_index(k));
+		}
+		const_iterator upper_bound(const key_type& k) const {
+			return _make_iter(_upper_index(k));
+		}
+		value_compare value_comp() const {
+			return value_compare(_comp);
+		}
+		const mapped_container_type& values() const {
+			return _values;
+		}
+		template<typename K, typename T1, typename Comp, typename Alloc>
+		friend bool operator==(const flat_map<K, T1, Comp, Alloc>& x, const flat_map<K, T1, Comp, Alloc>& y);
+	private:
+		key_container_type		_keys;
+		mapped_container_type	_values;
+		key_compare				_comp;
+		allocator_type			_allocator;
+
+		struct _pair_compare {
+			key_compare comp;
+			_pair_compare(const key_compare& c) : comp(c) {}
+			bool operator()(const ft::pair<Key, T>& x, const ft::pair<Key, T>& y) const {
+				return comp(x.first, y.first);
+			}
+		};
+
+		iterator _make_iter(size_type i) {
+			return iterator(_keys.begin().base() + i, _values.begin().base() + i);
+		}
+		const_iterator _make_iter(size_type i) const {
+			return const_iterator(_keys.begin().base() + i, _values.begin().base() + i);
+		}
+		size_type _lower_index(const key_type& k) const {
+			size_type lo = 0, len = _keys.size();
+			while (len > 0) {
+				size_type half = len / 2;
+				if (_comp(_keys[lo + half], k)) {
+					lo += half + 1;
+					len -= half + 1;
+				}
+				else
+					len = half;
+			}
+			return lo;
+		}
+		size_type _upper_index(const key_type& k) const {
+			size_type lo = 0, len = _keys.size();
+			while (len > 0) {
+				size_type half = len / 2;
+				if (!_comp(k, _keys[lo + half])) {
+					lo += half + 1;
+					len -= half + 1;
+				}
+				else
+					len = half;
+			}
+			return lo;
+		}
+		// the key goes back out if the value cannot go in, so the arrays
+		// never differ in length
+		iterator _insert_at(size_type i, const key_type& k, const mapped_type& v) {
+			_keys.insert(_keys.begin() + i, k);
+			try {
+				_values.insert(_values.begin() + i, v);
+			}
+			catch (...) {
+				_keys.erase(_keys.begin() + i);
+				throw;
+			}
+			return _make_iter(i);
+		}
+		// the length of [first, last) when it can be had without using up
+		// the range, else 0
+		template<class It>
+		static size_type _length(It first, It last, std::input_iterator_tag) {
+			(void)first, (void)last;
+			return 0;
+		}
+		template<class It>
+		static size_type _length(It first, It last, std::forward_iterator_tag) {
+			return std::distance(first, last);
+		}
+		// merges a sorted, duplicate free range into the arrays; on equal keys
+		// the element already in the map wins
+		template<class It>
+		void _merge(It first, It last) {
+			if (first == last)
+				return;
+			size_type extra = _length(first, last, typename ft::iterator_traits<It>::iterator_category());
+			if (empty() || _comp(_keys[size() - 1], (*first).first)) {
+				size_type n = size();
+				_keys.reserve(n + extra);
+				_values.reserve(n + extra);
+				try {
+					for (; first != last; ++first) {
+						_keys.push_back((*first).first);
+						_values.push_back((*first).second);
+					}
+				}
+				catch (...) {
+					_keys.erase(_keys.begin() + n, _keys.end());
+					_values.erase(_values.begin() + n, _values.end());
+					throw;
+				}
+				return;
+			}
+			key_container_type keys((key_allocator(_allocator)));
+			mapped_container_type values((mapped_allocator(_allocator)));
+			keys.reserve(size() + extra);
+			values.reserve(size() + extra);
+			size_type i = 0;
+			while (i < size() || first != last) {
+				if (first == last || (i < size() && !_comp((*first).first, _keys[i]))) {
+					if (first != last && !_comp(_keys[i], (*first).first))
+						++first;
+					keys.push_back(_keys[i]);
+					values.push_back(_values[i]);
+					++i;
+				}
+				else {
+					keys.push_back((*first).first);
+					values.push_back((*first).second);
+					++first;
+				}
+			}
+			_keys.swap(keys);
+			_values.swap(values);
+		}
+	};
+
+	template<typename K, typename T1, typename Comp, typename Alloc>
+	inline bool operator==(const flat_map<K, T1, Comp, Alloc> &x, const flat_map<K, T1, Comp, Alloc> &y) {
+		return x._keys == y._keys && x._values == y._values;
+	}
+	template<typename K, typename T1, typename Comp, typename Alloc>
+	inline bool operator!=(const flat_map<K, T1, Comp, Alloc> &x, const flat_map<K, T1, Comp, Alloc> &y) {
+		return !(x == y);
+	}
+	template<typename K, typename T1, typename Comp, typename Alloc>
+	inline bool operator<(const flat_map<K, T1, Comp, Alloc> &x, const flat_map<K, T1, Comp, Alloc> &y) {
+		return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+	}
+	template<typename K, typename T1, typename Comp, typename Alloc>
+	inline bool operator>(const flat_map<K, T1, Comp, Alloc> &x, const flat_map<K, T1, Comp, Alloc> &y) {
+		return y < x;
+	}
+	template<typename K, typename T1, typename Comp, typename Alloc>
+	inline bool operator<=(const flat_map<K, T1, Comp, Alloc> &x, const flat_map<K, T1, Comp, Alloc> &y) {
+		return !(y < x);
+	}
+	template<typename K, typename T1, typename Comp, typename Alloc>
+	inline bool operator>=(const flat_map<K, T1, Comp, Alloc> &x, const flat_map<K, T1, Comp, Alloc> &y) {
+		return !(x < y);
+	}
+	template<typename K, typename T1, typename Comp, typename Alloc>
+	inline void swap(flat_map<K, T1, Comp, Alloc> &x, flat_map<K, T1, Comp, Alloc> &y) {
+		x.swap(y);
+	}
+}
+
+#endif
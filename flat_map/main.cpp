@@ -0,0 +1,200 @@
+#include "flat_map.hpp"
+#include "../vector/vector.hpp"
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+template <class T1, class T2>
+void print_map(const ft::flat_map<T1, T2> &v)
+{
+	typename ft::flat_map<T1, T2>::const_iterator begin = v.begin();
+	typename ft::flat_map<T1, T2>::const_iterator end = v.end();
+	std::cout << "size=\t\t" << v.size() << std::endl;
+	for (; begin != end; begin++)
+		std::cout << "\033[38;5;46m" << begin->first << "->" << begin->second << "\033[0m ";
+	std::cout << std::endl;
+}
+
+// takes the sorted_unique overload where the map has one and falls back to
+// a plain range insert for the std build
+template <class M, class It>
+auto insert_sorted(M& m, It first, It last, int) -> decltype(m.insert(ft::sorted_unique, first, last), void()) {
+	m.insert(ft::sorted_unique, first, last);
+}
+template <class M, class It>
+void insert_sorted(M& m, It first, It last, long) {
+	m.insert(first, last);
+}
+
+void map_test_construct() {
+	ft::flat_map<char, int> one;
+	one['d'] = 70;
+	one['b'] = 30;
+	one['a'] = 10;
+	one['c'] = 50;
+	print_map(one);
+	ft::flat_map<char, int> two(one.begin(), one.end());
+	ft::flat_map<char, int> three(two);
+	three['e'] = 90;
+	two = three;
+	print_map(two);
+	std::cout << (one == two) << (two == three) << (one < two) << std::endl;
+}
+
+// every lookup past the largest key is checked against end()
+void map_test_lookup() {
+	ft::flat_map<int, std::string> m;
+	for (int i = 0; i < 50; ++i)
+		m[i * 4] = std::string(1, static_cast<char>('a' + i % 26));
+	const ft::flat_map<int, std::string>& cm = m;
+	int probes[] = {-1, 0, 3, 4, 97, 196, 197, 400};
+	for (int p = 0; p < 8; ++p) {
+		int k = probes[p];
+		ft::pair<ft::flat_map<int, std::string>::const_iterator, ft::flat_map<int, std::string>::const_iterator> r = cm.equal_range(k);
+		ft::flat_map<int, std::string>::iterator f = m.find(k);
+		ft::flat_map<int, std::string>::iterator up = m.upper_bound(k);
+		std::cout << k << ": " << (r.first == cm.end() ? std::string("end") : r.first->second) << " "
+			<< std::distance(r.first, r.second) << " " << (f == m.end() ? std::string("end") : f->second) << " "
+			<< (up == m.end() ? -1 : up->first) << " " << m.count(k) << std::endl;
+	}
+}
+
+void map_test_erase() {
+	ft::flat_map<int, int> a;
+	for (int i = 0; i < 1000; ++i)
+		a.insert(ft::pair<int, int>(i, i));
+	for (int i = 10; i < 50; ++i)
+		a.erase(i);
+	std::cout << a.erase(10) << a.erase(50) << " " << a.size() << std::endl;
+	ft::flat_map<int, int>::iterator first = a.lower_bound(100);
+	ft::flat_map<int, int>::iterator last = a.lower_bound(900);
+	a.erase(first, last);
+	a.erase(a.begin());
+	a.erase(a.find(999));
+	print_map(a);
+	a.erase(a.begin(), a.end());
+	std::cout << a.size() << " " << a.empty() << " " << (a.begin() == a.end()) << std::endl;
+}
+
+void map_test_sorted_construct() {
+	ft::vector<ft::pair<int, int> > sorted;
+	for (int i = 0; i < 1000; ++i)
+		sorted.push_back(ft::pair<int, int>(i * 2, i));
+	ft::flat_map<int, int> a(sorted.begin(), sorted.end());
+	print_map(a);
+	for (int i = 0; i < 2000; i += 5)
+		a.erase(i);
+	for (int i = 1; i < 2000; i += 9)
+		a[i] = -i;
+	print_map(a);
+	sorted.push_back(ft::pair<int, int>(7, 7));
+	sorted.push_back(ft::pair<int, int>(0, 100));
+	ft::flat_map<int, int> b(sorted.begin(), sorted.end());
+	print_map(b);
+}
+
+// sorted, duplicate free batches: appended past the end, merged in the
+// middle, and into an empty map
+void map_test_sorted_unique() {
+	ft::vector<ft::pair<int, std::string> > low;
+	ft::vector<ft::pair<int, std::string> > high;
+	ft::vector<ft::pair<int, std::string> > mixed;
+	for (int i = 0; i < 300; ++i) {
+		low.push_back(ft::pair<int, std::string>(i * 3, std::string(20, 'l')));
+		high.push_back(ft::pair<int, std::string>(1000 + i, std::string(20, 'h')));
+		mixed.push_back(ft::pair<int, std::string>(i * 5 + 1, std::string(20, 'm')));
+	}
+	ft::flat_map<int, std::string> m;
+	insert_sorted(m, low.begin(), low.end(), 0);
+	insert_sorted(m, high.begin(), high.end(), 0);
+	insert_sorted(m, mixed.begin(), mixed.end(), 0);
+	insert_sorted(m, low.begin(), low.begin() + 50, 0);
+	std::string seen;
+	for (ft::flat_map<int, std::string>::iterator it = m.begin(); it != m.end(); ++it)
+		seen += it->second[0];
+	std::cout << m.size() << " " << seen.substr(0, 40) << " " << m.begin()->first << " " << m.rbegin()->first
+		<< " " << m[16][0] << m[1][0] << m[1299][0] << std::endl;
+}
+
+void map_test_batch_insert() {
+	ft::vector<ft::pair<int, int> > batch;
+	for (int i = 0; i < 2000; ++i)
+		batch.push_back(ft::pair<int, int>(i * 7919 % 3001, i));
+	ft::flat_map<int, int> a;
+	for (int i = 0; i < 3000; i += 3)
+		a[i] = -i;
+	a.insert(batch.begin(), batch.end());
+	print_map(a);
+	ft::flat_map<int, int> b(batch.begin(), batch.end());
+	print_map(b);
+	b.insert(a.begin(), a.end());
+	print_map(b);
+	std::cout << (a == b) << " " << (a < b) << " " << (b < a) << std::endl;
+}
+
+// the iterators hand out pairs of references into the two arrays, so
+// writes through them land in the map
+void map_test_proxy_iterator() {
+	ft::flat_map<int, int> m;
+	for (int i = 0; i < 10; ++i)
+		m[i] = i;
+	for (ft::flat_map<int, int>::iterator it = m.begin(); it != m.end(); ++it)
+		it->second *= 10;
+	(*m.find(3)).second = -3;
+	m.rbegin()->second = 99;
+	ft::flat_map<int, int>::iterator mid = m.begin();
+	std::advance(mid, 5);
+	ft::pair<int, int> copy = *mid;
+	mid->second = 0;
+	ft::flat_map<int, int>::const_reverse_iterator crit = m.rbegin();
+	++crit;
+	std::cout << copy.first << "->" << copy.second << " " << crit->first << "->" << crit->second << " "
+		<< std::distance(m.begin(), mid) << " " << std::distance(mid, m.end()) << std::endl;
+	print_map(m);
+}
+
+// default construction fails once its budget is spent
+struct fragile {
+	static int budget;
+	std::string text;
+
+	fragile() : text("fresh") {
+		if (budget-- == 0)
+			throw std::runtime_error("fragile");
+	}
+};
+int fragile::budget = 0;
+
+void map_test_throwing_value() {
+	ft::flat_map<int, fragile> m;
+	fragile::budget = 3;
+	for (int i = 0; i < 6; ++i) {
+		try {
+			m[i * 10].text = "set";
+		}
+		catch (std::runtime_error& e) {
+			std::cout << e.what() << " at " << i << std::endl;
+		}
+	}
+	std::cout << m.size() << " " << m.count(30) << " " << m.count(40) << std::endl;
+	for (ft::flat_map<int, fragile>::iterator it = m.begin(); it != m.end(); ++it)
+		std::cout << it->first << "->" << it->second.text << " ";
+	std::cout << std::endl;
+	fragile::budget = -1;
+	ft::flat_map<int, std::string> words;
+	for (int i = 0; i < 10; ++i)
+		words[i] = std::string(40, static_cast<char>('a' + i));
+	std::cout << words.size() << " " << words[9] << std::endl;
+}
+
+int main() {
+	map_test_construct();
+	map_test_lookup();
+	map_test_erase();
+	map_test_sorted_construct();
+	map_test_sorted_unique();
+	map_test_batch_insert();
+	map_test_proxy_iterator();
+	map_test_throwing_value();
+}
@@ -0,0 +1,285 @@
+#ifndef FLAT_SET_HPP
+#define FLAT_SET_HPP
+
+#include <iostream>
+#include <algorithm>
+#include "../vector/vector.hpp"
+#include "../iterator/iterator_traits.hpp"
+#include "../tree/pair.hpp"
+#include "../utility/sorted_unique.hpp"
+
+namespace ft {
+	// Sorted associative container on a single ft::vector of keys.
+	template <class T, class Compare = std::less<T>, class Allocator = std::allocator<T> >
+	class flat_set {
+	public:
+
+		// DEF
+
+		typedef T									key_type;
+		typedef T									value_type;
+		typedef std::size_t							size_type;
+		typedef std::ptrdiff_t						difference_type;
+		typedef Compare								key_compare;
+		typedef Compare								value_compare;
+		typedef Allocator							allocator_type;
+		typedef const value_type&					reference;
+		typedef const value_type&					const_reference;
+		typedef typename Allocator::const_pointer	pointer;
+		typedef typename Allocator::const_pointer	const_pointer;
+		typedef ft::vector<T, Allocator>			container_type;
+		typedef typename container_type::const_iterator		iterator;
+		typedef typename container_type::const_iterator		const_iterator;
+		typedef ft::reverse_iterator<iterator>		reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>	const_reverse_iterator;
+
+		// CONSTRUCTORS + DESTRUCTOR
+
+		explicit flat_set(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) :
+			_keys(alloc), _comp(comp) {}
+
+		template<class InputIterator>
+		flat_set(InputIterator first, InputIterator last, const key_compare& comp = key_compare(),
+			const allocator_type& alloc = allocator_type()) : _keys(alloc), _comp(comp) {
+			insert(first, last);
+		}
+
+		template<class InputIterator>
+		flat_set(ft::sorted_unique_t, InputIterator first, InputIterator last, const key_compare& comp = key_compare(),
+			const allocator_type& alloc = allocator_type()) : _keys(alloc), _comp(comp) {
+			insert(ft::sorted_unique, first, last);
+		}
+
+		flat_set(const flat_set& x) : _keys(x._keys), _comp(x._comp) {}
+
+		// OPERATORS
+
+		flat_set& operator=(const flat_set& other) {
+			if (this != &other) {
+				_keys = other._keys;
+				_comp = other._comp;
+			}
+			return *this;
+		}
+
+		// MEMBER FUNCTIONS
+
+		iterator begin() const {
+			return _make_iter(0);
+		}
+		void clear() {
+			_keys.clear();
+		}
+		size_type count(const key_type& k) const {
+			return find(k) == end() ? 0 : 1;
+		}
+		bool empty() const {
+			return _keys.empty();
+		}
+		iterator end() const {
+			return _make_iter(_keys.size());
+		}
+		ft::pair<iterator, iterator> equal_range(const key_type& k) const {
+			return ft::pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+		}
+		void erase(iterator position) {
+			_keys.erase(_keys.begin() + (position - begin()));
+		}
+		size_type erase(const key_type& k) {
+			iterator it = find(k);
+			if (it == end())
+				return 0;
+			erase(it);
+			return 1;
+		}
+		void erase(iterator first, iterator last) {
+			_keys.erase(_keys.begin() + (first - begin()), _keys.begin() + (last - begin()));
+		}
+		iterator find(const key_type& k) const {
+			size_type i = _lower_index(k);
+			return (i == _keys.size() || _comp(k, _keys[i])) ? end() : _make_iter(i);
+		}
+		allocator_type get_allocator() const {
+			return _keys.get_allocator();
+		}
+		ft::pair<iterator, bool> insert(const value_type& val) {
+			size_type i = _lower_index(val);
+			if (i != _keys.size() && !_comp(val, _keys[i]))
+				return ft::pair<iterator, bool>(_make_iter(i), false);
+			_keys.insert(_keys.begin() + i, val);
+			return ft::pair<iterator, bool>(_make_iter(i), true);
+		}
+		iterator insert(iterator position, const value_type& val) {
+			size_type i = position - begin();
+			if ((i == 0 || _comp(_keys[i - 1], val)) && (i == _keys.size() || _comp(val, _keys[i]))) {
+				_keys.insert(_keys.begin() + i, val);
+				return _make_iter(i);
+			}
+			return insert(val).first;
+		}
+		// batched insert: the new keys are sorted on the side and merged in
+		// one pass instead of shifting the array once per key
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last) {
+			container_type batch;
+			for (; first != last; ++first)
+				batch.push_back(*first);
+			if (batch.empty())
+				return;
+			std::stable_sort(&batch[0], &batch[0] + batch.size(), _comp);
+			size_type n = 1;
+			for (size_type i = 1; i < batch.size(); ++i) {
+				if (_comp(batch[n - 1], batch[i]))
+					batch[n++] = batch[i];
+			}
+			batch.erase(batch.begin() + n, batch.end());
+			_merge(batch.begin(), batch.end());
+		}
+		template<class InputIterator>
+		void insert(ft::sorted_unique_t, InputIterator first, InputIterator last) {
+			_merge(first, last);
+		}
+		key_compare key_comp() const {
+			return _comp;
+		}
+		const container_type& keys() const {
+			return _keys;
+		}
+		iterator lower_bound(const key_type& k) const {
+			return _make_iter(_lower_index(k));
+		}
+		size_type max_size() const {
+			return _keys.max_size();
+		}
+		reverse_iterator rbegin() const {
+			return reverse_iterator(end());
+		}
+		reverse_iterator rend() const {
+			return reverse_iterator(begin());
+		}
+		void reserve(size_type n) {
+			_keys.reserve(n);
+		}
+		size_type size() const {
+			return _keys.size();
+		}
+		void swap(flat_set& x) {
+			_keys.swap(x._keys);
+			std::swap(_comp, x._comp);
+		}
+		iterator upper_bound(const key_type& k) const {
+			return _make_iter(_upper_index(k));
+		}
+		value_compare value_comp() const {
+			return _comp;
+		}
+		template<typename T1, typename Comp, typename Alloc>
+		friend bool operator==(const flat_set<T1, Comp, Alloc>& x, const flat_set<T1, Comp, Alloc>& y);
+		template<typename T1, typename Comp, typename Alloc>
+		friend bool operator<(const flat_set<T1, Comp, Alloc>& x, const flat_set<T1, Comp, Alloc>& y);
+	private:
+		container_type	_keys;
+		key_compare		_comp;
+
+		iterator _make_iter(size_type i) const {
+			return iterator(_keys.begin().base() + i);
+		}
+		size_type _lower_index(const key_type& k) const {
+			size_type lo = 0, len = _keys.size();
+			while (len > 0) {
+				size_type half = len / 2;
+				if (_comp(_keys[lo + half], k)) {
+					lo += half + 1;
+					len -= half + 1;
+				}
+				else
+					len = half;
+			}
+			return lo;
+		}
+		size_type _upper_index(const key_type& k) const {
+			size_type lo = 0, len = _keys.size();
+			while (len > 0) {
+				size_type half = len / 2;
+				if (!_comp(k, _keys[lo + half])) {
+					lo += half + 1;
+					len -= half + 1;
+				}
+				else
+					len = half;
+			}
+			return lo;
+		}
+		// the length of [first, last) when it can be had without using up
+		// the range, else 0
+		template<class It>
+		static size_type _length(It first, It last, std::input_iterator_tag) {
+			(void)first, (void)last;
+			return 0;
+		}
+		template<class It>
+		static size_type _length(It first, It last, std::forward_iterator_tag) {
+			return std::distance(first, last);
+		}
+		// merges a sorted, duplicate free range into the array; on equal keys
+		// the element already in the set wins
+		template<class It>
+		void _merge(It first, It last) {
+			if (first == last)
+				return;
+			size_type extra = _length(first, last, typename ft::iterator_traits<It>::iterator_category());
+			if (empty() || _comp(_keys[size() - 1], *first)) {
+				_keys.reserve(size() + extra);
+				for (; first != last; ++first)
+					_keys.push_back(*first);
+				return;
+			}
+			container_type keys(_keys.get_allocator());
+			keys.reserve(size() + extra);
+			size_type i = 0;
+			while (i < size() || first != last) {
+				if (first == last || (i < size() && !_comp(*first, _keys[i]))) {
+					if (first != last && !_comp(_keys[i], *first))
+						++first;
+					keys.push_back(_keys[i++]);
+				}
+				else {
+					keys.push_back(*first);
+					++first;
+				}
+			}
+			_keys.swap(keys);
+		}
+	};
+
+	template<typename T1, typename Comp, typename Alloc>
+	inline bool operator==(const flat_set<T1, Comp, Alloc> &x, const flat_set<T1, Comp, Alloc> &y) {
+		return x._keys == y._keys;
+	}
+	template<typename T1, typename Comp, typename Alloc>
+	inline bool operator!=(const flat_set<T1, Comp, Alloc> &x, const flat_set<T1, Comp, Alloc> &y) {
+		return !(x == y);
+	}
+	template<typename T1, typename Comp, typename Alloc>
+	inline bool operator<(const flat_set<T1, Comp, Alloc> &x, const flat_set<T1, Comp, Alloc> &y) {
+		return x._keys < y._keys;
+	}
+	template<typename T1, typename Comp, typename Alloc>
+	inline bool operator>(const flat_set<T1, Comp, Alloc> &x, const flat_set<T1, Comp, Alloc> &y) {
+		return y < x;
+	}
+	template<typename T1, typename Comp, typename Alloc>
+	inline bool operator<=(const flat_set<T1, Comp, Alloc> &x, const flat_set<T1, Comp, Alloc> &y) {
+		return !(y < x);
+	}
+	template<typename T1, typename Comp, typename Alloc>
+	inline bool operator>=(const flat_set<T1, Comp, Alloc> &x, const flat_set<T1, Comp, Alloc> &y) {
+		return !(x < y);
+	}
+	template<typename T1, typename Comp, typename Alloc>
+	inline void swap(flat_set<T1, Comp, Alloc> &x, flat_set<T1, Comp, Alloc> &y) {
+		x.swap(y);
+	}
+}
+
+#endif
@@ -0,0 +1,141 @@
+#include "flat_set.hpp"
+#include "../tree/pair.hpp"
+#include "../vector/vector.hpp"
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <string>
+
+template <class T1>
+void print_set(const ft::flat_set<T1> &v)
+{
+	typename ft::flat_set<T1>::const_iterator begin = v.begin();
+	typename ft::flat_set<T1>::const_iterator end = v.end();
+	std::cout << "size=\t\t" << v.size() << std::endl;
+	for (; begin != end; begin++)
+		std::cout << "\033[38;5;46m" << *begin << "\033[0m ";
+	std::cout << std::endl;
+}
+
+// takes the sorted_unique overload where the set has one and falls back to
+// a plain range insert for the std build
+template <class S, class It>
+auto insert_sorted(S& s, It first, It last, int) -> decltype(s.insert(ft::sorted_unique, first, last), void()) {
+	s.insert(ft::sorted_unique, first, last);
+}
+template <class S, class It>
+void insert_sorted(S& s, It first, It last, long) {
+	s.insert(first, last);
+}
+
+void set_test_construct() {
+	ft::flat_set<char> one;
+	one.insert('d');
+	one.insert('b');
+	one.insert('a');
+	one.insert('c');
+	print_set(one);
+	ft::flat_set<char> two(one.begin(), one.end());
+	ft::flat_set<char> three(two);
+	three.insert('e');
+	two = three;
+	print_set(two);
+	std::cout << (one == two) << (two == three) << (one < two) << std::endl;
+}
+
+// every lookup past the largest key is checked against end()
+void set_test_lookup() {
+	ft::flat_set<int> s;
+	for (int i = 0; i < 50; ++i)
+		s.insert(i * 4);
+	int probes[] = {-1, 0, 3, 4, 97, 196, 197, 400};
+	for (int p = 0; p < 8; ++p) {
+		int k = probes[p];
+		ft::pair<ft::flat_set<int>::iterator, ft::flat_set<int>::iterator> r = s.equal_range(k);
+		ft::flat_set<int>::iterator f = s.find(k);
+		ft::flat_set<int>::iterator up = s.upper_bound(k);
+		std::cout << k << ": " << (r.first == s.end() ? -1 : *r.first) << " " << std::distance(r.first, r.second) << " "
+			<< (f == s.end() ? -1 : *f) << " " << (up == s.end() ? -1 : *up) << " " << s.count(k) << std::endl;
+	}
+}
+
+void set_test_erase() {
+	ft::flat_set<int> a;
+	for (int i = 0; i < 1000; ++i)
+		a.insert(i);
+	for (int i = 10; i < 50; ++i)
+		a.erase(i);
+	std::cout << a.erase(10) << a.erase(50) << " " << a.size() << std::endl;
+	a.erase(a.lower_bound(100), a.lower_bound(900));
+	a.erase(a.begin());
+	a.erase(a.find(999));
+	print_set(a);
+	a.erase(a.begin(), a.end());
+	std::cout << a.size() << " " << a.empty() << " " << (a.begin() == a.end()) << std::endl;
+}
+
+void set_test_sorted_construct() {
+	ft::vector<int> sorted;
+	for (int i = 0; i < 1000; ++i)
+		sorted.push_back(i * 3);
+	ft::flat_set<int> a(sorted.begin(), sorted.end());
+	print_set(a);
+	for (int i = 0; i < 3000; i += 7)
+		a.erase(i);
+	for (int i = 1; i < 3000; i += 11)
+		a.insert(i);
+	print_set(a);
+	sorted.push_back(5);
+	sorted.push_back(3000);
+	sorted.push_back(0);
+	ft::flat_set<int> b(sorted.begin(), sorted.end());
+	print_set(b);
+}
+
+// sorted, duplicate free batches of heap-owning keys: appended past the
+// end, merged in the middle, and into an empty set
+void set_test_sorted_unique() {
+	ft::vector<std::string> low;
+	ft::vector<std::string> high;
+	ft::vector<std::string> mixed;
+	for (int i = 0; i < 300; ++i) {
+		low.push_back("a" + std::string(20, static_cast<char>('a' + i / 26 % 26)) + static_cast<char>('a' + i % 26));
+		high.push_back("z" + std::string(20, static_cast<char>('a' + i / 26 % 26)) + static_cast<char>('a' + i % 26));
+		mixed.push_back("a" + std::string(20, static_cast<char>('a' + i / 26 % 26)) + static_cast<char>('A' + i % 26));
+	}
+	ft::flat_set<std::string> s;
+	insert_sorted(s, low.begin(), low.end(), 0);
+	insert_sorted(s, high.begin(), high.end(), 0);
+	ft::vector<std::string> sorted_mixed(mixed);
+	std::sort(sorted_mixed.begin(), sorted_mixed.end());
+	insert_sorted(s, sorted_mixed.begin(), sorted_mixed.end(), 0);
+	insert_sorted(s, low.begin(), low.begin() + 50, 0);
+	std::cout << s.size() << " " << s.begin()->substr(20) << " " << s.rbegin()->substr(20) << " "
+		<< s.count(low[7]) << s.count(mixed[299]) << s.count("b") << " "
+		<< std::distance(s.begin(), s.lower_bound(high[0])) << std::endl;
+}
+
+void set_test_batch_insert() {
+	ft::vector<int> batch;
+	for (int i = 0; i < 2000; ++i)
+		batch.push_back(i * 7919 % 3001);
+	ft::flat_set<int> a;
+	for (int i = 0; i < 3000; i += 3)
+		a.insert(i);
+	a.insert(batch.begin(), batch.end());
+	print_set(a);
+	ft::flat_set<int> b(batch.begin(), batch.end());
+	print_set(b);
+	b.insert(a.begin(), a.end());
+	print_set(b);
+	std::cout << (a == b) << " " << (a < b) << " " << (b < a) << std::endl;
+}
+
+int main() {
+	set_test_construct();
+	set_test_lookup();
+	set_test_erase();
+	set_test_sorted_construct();
+	set_test_sorted_unique();
+	set_test_batch_insert();
+}
@@ -0,0 +1,176 @@
+#ifndef FROZEN_MAP_HPP
+#define FROZEN_MAP_HPP
+
+#include <iostream>
+#include "../tree/frozen_select.hpp"
+#include "../map/map.hpp"
+#include "../map/get_first.hpp"
+#include "../utility/sorted_unique.hpp"
+
+namespace ft {
+	// Read-only map built once from a range or an ft::map (see freeze),
+	// stored as one array of pairs laid out like frozen_set's keys.
+	template <class Key, class T, class Compare = std::less<Key>, class Allocator = std::allocator<ft::pair<const Key, T> > >
+	class frozen_map {
+	public:
+
+		// DEF
+
+		typedef Key									key_type;
+		typedef T									mapped_type;
+		typedef ft::pair<const Key, T>				value_type;
+		typedef std::size_t							size_type;
+		typedef std::ptrdiff_t						difference_type;
+		typedef Compare								key_compare;
+		typedef Allocator							allocator_type;
+		typedef const value_type&					reference;
+		typedef const value_type&					const_reference;
+		typedef typename Allocator::const_pointer	pointer;
+		typedef typename Allocator::const_pointer	const_pointer;
+	private:
+		typedef typename ft::frozen_select<key_type, value_type, ft::get_first<value_type>, key_compare, allocator_type>::type tree;
+		tree _tree;
+	public:
+		typedef typename tree::iterator iterator;
+		typedef typename tree::const_iterator const_iterator;
+		typedef typename tree::reverse_iterator reverse_iterator;
+		typedef typename tree::const_reverse_iterator const_reverse_iterator;
+
+		// VALUE COMPARE CLASS
+
+		class value_compare {
+			friend class frozen_map;
+		public:
+			typedef bool result_type;
+			typedef value_type first_argument_type;
+			typedef value_type second_argument_type;
+
+			bool operator()(const value_type& lhs, const value_type& rhs) const {
+				return comp(lhs.first, rhs.first);
+			}
+
+		protected:
+			Compare comp;
+			value_compare(Compare c) : comp(c) {}
+		};
+
+		// CONSTRUCTORS + DESTRUCTOR
+
+		explicit frozen_map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) :
+			_tree(comp, alloc) {}
+
+		template<class InputIterator>
+		frozen_map(InputIterator first, InputIterator last, const key_compare& comp = key_compare(),
+			const allocator_type& alloc = allocator_type()) : _tree(comp, alloc) {
+			_tree.assign(first, last);
+		}
+
+		template<class InputIterator>
+		frozen_map(ft::sorted_unique_t, InputIterator first, InputIterator last, const key_compare& comp = key_compare(),
+			const allocator_type& alloc = allocator_type()) : _tree(comp, alloc) {
+			_tree.assign_sorted(first, last);
+		}
+
+		template<class NodePolicy>
+		explicit frozen_map(const map<Key, T, Compare, Allocator, NodePolicy>& m) : _tree(m.key_comp(), m.get_allocator()) {
+			_tree.assign_sorted(m.begin(), m.end());
+		}
+
+		frozen_map(const frozen_map& x) : _tree(x._tree) {}
+
+		// OPERATORS
+
+		frozen_map& operator=(const frozen_map& other) {
+			_tree = other._tree;
+			return *this;
+		}
+
+		// MEMBER FUNCTIONS
+
+		const_iterator begin() const {
+			return _tree.begin();
+		}
+		size_type count(const key_type& k) const {
+			return _tree.find(k) == _tree.end() ? 0 : 1;
+		}
+		bool empty() const {
+			return _tree.size() == 0;
+		}
+		const_iterator end() const {
+			return _tree.end();
+		}
+		ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+			return ft::pair<const_iterator, const_iterator>(_tree.lower_bound(k), _tree.upper_bound(k));
+		}
+		const_iterator find(const key_type& k) const {
+			return _tree.find(k);
+		}
+		allocator_type get_allocator() const {
+			return _tree.get_allocator();
+		}
+		key_compare key_comp() const {
+			return _tree.key_comp();
+		}
+		const_iterator lower_bound(const key_type& k) const {
+			return _tree.lower_bound(k);
+		}
+		size_type max_size() const {
+			return _tree.max_size();
+		}
+		const_reverse_iterator rbegin() const {
+			return const_reverse_iterator(end());
+		}
+		const_reverse_iterator rend() const {
+			return const_reverse_iterator(begin());
+		}
+		size_type size() const {
+			return _tree.size();
+		}
+		void swap(frozen_map& x) {
+			_tree.swap(x._tree);
+		}
+		const_iterator upper_bound(const key_type& k) const {
+			return _tree.upper_bound(k);
+		}
+		value_compare value_comp() const {
+			return value_compare(_tree.key_comp());
+		}
+	};
+
+	template<typename K, typename T1, typename Comp, typename Alloc>
+	inline bool operator==(const frozen_map<K, T1, Comp, Alloc> &x, const frozen_map<K, T1, Comp, Alloc> &y) {
+		return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
+	}
+	template<typename K, typename T1, typename Comp, typename Alloc>
+	inline bool operator!=(const frozen_map<K, T1, Comp, Alloc> &x, const frozen_map<K, T1, Comp, Alloc> &y) {
+		return !(x == y);
+	}
+	template<typename K, typename T1, typename Comp, typename Alloc>
+	inline bool operator<(const frozen_map<K, T1, Comp, Alloc> &x, const frozen_map<K, T1, Comp, Alloc> &y) {
+		return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+	}
+	template<typename K, typename T1, typename Comp, typename Alloc>
+	inline bool operator>(const frozen_map<K, T1, Comp, Alloc> &x, const frozen_map<K, T1, Comp, Alloc> &y) {
+		return y < x;
+	}
+	template<typename K, typename T1, typename Comp, typename Alloc>
+	inline bool operator<=(const frozen_map<K, T1, Comp, Alloc> &x, const frozen_map<K, T1, Comp, Alloc> &y) {
+		return !(y < x);
+	}
+	template<typename K, typename T1, typename Comp, typename Alloc>
+	inline bool operator>=(const frozen_map<K, T1, Comp, Alloc> &x, const frozen_map<K, T1, Comp, Alloc> &y) {
+		return !(x < y);
+	}
+	template<typename K, typename T1, typename Comp, typename Alloc>
+	inline void swap(frozen_map<K, T1, Comp, Alloc> &x, frozen_map<K, T1, Comp, Alloc> &y) {
+		x.swap(y);
+	}
+
+	// read-only copy of m for lookup-heavy use; m is left as it was
+	template<typename K, typename T1, typename Comp, typename Alloc, typename NP>
+	inline frozen_map<K, T1, Comp, Alloc> freeze(const map<K, T1, Comp, Alloc, NP>& m) {
+		return frozen_map<K, T1, Comp, Alloc>(m);
+	}
+}
+
+#endif
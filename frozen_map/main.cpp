@@ -0,0 +1,132 @@
+#include "frozen_map.hpp"
+#include "../vector/vector.hpp"
+#include <map>
+
+template <class M>
+void print_map(const M &v)
+{
+	typename M::const_iterator begin = v.begin();
+	typename M::const_iterator end = v.end();
+	std::cout << "size=\t\t" << v.size() << std::endl;
+	for (; begin != end; begin++)
+		std::cout << "\033[38;5;46m" << begin->first << "->" << begin->second << "\033[0m ";
+	std::cout << std::endl;
+}
+
+void map_test_construct() {
+	ft::vector<ft::pair<int, std::string> > v;
+	v.push_back(ft::pair<int, std::string>(5, "five"));
+	v.push_back(ft::pair<int, std::string>(1, "one"));
+	v.push_back(ft::pair<int, std::string>(3, "three"));
+	v.push_back(ft::pair<int, std::string>(5, "cinq"));
+	v.push_back(ft::pair<int, std::string>(-2, "minus two"));
+	ft::frozen_map<int, std::string> one(v.begin(), v.end());
+	print_map(one);
+	ft::frozen_map<int, std::string> two(one);
+	ft::frozen_map<int, std::string> three;
+	print_map(three);
+	three = two;
+	print_map(three);
+	std::cout << (one == three) << " " << three.empty() << " " << one.count(5) << one.count(4) << std::endl;
+}
+
+// every tree shape up to 70 slots, probed on and between the keys
+void map_test_bounds() {
+	for (int n = 0; n <= 70; ++n) {
+		ft::vector<ft::pair<int, int> > v;
+		for (int i = 0; i < n; ++i)
+			v.push_back(ft::pair<int, int>(((i * 7) % n) * 2, i));
+		ft::frozen_map<int, int> m(v.begin(), v.end());
+		unsigned long long sum = 0;
+		for (int k = -1; k <= 2 * n; ++k) {
+			ft::frozen_map<int, int>::const_iterator lo = m.lower_bound(k);
+			ft::frozen_map<int, int>::const_iterator hi = m.upper_bound(k);
+			ft::frozen_map<int, int>::const_iterator f = m.find(k);
+			sum = sum * 31 + (lo == m.end() ? -1 : lo->first);
+			sum = sum * 31 + (hi == m.end() ? -1 : hi->second);
+			sum = sum * 31 + (f == m.end() ? -1 : f->second);
+		}
+		unsigned back = 0;
+		for (ft::frozen_map<int, int>::const_reverse_iterator it = m.rbegin(); it != m.rend(); ++it)
+			back = back * 7 + it->first + it->second;
+		std::cout << n << " " << sum << " " << back << std::endl;
+	}
+}
+
+void map_test_freeze() {
+	ft::map<std::string, int> source;
+	source["delta"] = 4;
+	source["alpha"] = 1;
+	source["charlie"] = 3;
+	source["bravo"] = 2;
+	print_map(ft::freeze(source));
+	ft::vector<ft::pair<std::string, int> > v;
+	for (ft::map<std::string, int>::iterator src = source.begin(); src != source.end(); ++src)
+		v.push_back(ft::pair<std::string, int>(src->first, src->second));
+	ft::frozen_map<std::string, int> copy(v.begin(), v.end());
+	ft::frozen_map<std::string, int>::const_iterator it = copy.find("charlie");
+	std::cout << it->second << " " << (--it)->first << " " << (copy.find("echo") == copy.end()) << std::endl;
+}
+
+// unsorted string keys go through the staged sort of the Eytzinger layout
+void map_test_unsorted_strings() {
+	ft::vector<ft::pair<std::string, std::string> > v;
+	for (int i = 0; i < 10; ++i) {
+		std::string key(1, static_cast<char>('j' - i));
+		v.push_back(ft::pair<std::string, std::string>(key + std::string(30, 'k'), key + std::string(30, 'v')));
+	}
+	ft::frozen_map<std::string, std::string> m(v.begin(), v.end());
+	print_map(m);
+	std::cout << m.lower_bound("c")->second.substr(0, 3) << " " << m.count("z") << std::endl;
+}
+
+void map_test_compare() {
+	ft::vector<ft::pair<char, int> > a;
+	ft::vector<ft::pair<char, int> > b;
+	for (int i = 0; i < 4; ++i) {
+		a.push_back(ft::pair<char, int>('a' + i, i));
+		b.push_back(ft::pair<char, int>('a' + i, i == 3 ? 9 : i));
+	}
+	ft::frozen_map<char, int> x(a.begin(), a.end());
+	ft::frozen_map<char, int> y(b.begin(), b.end());
+	std::cout << (x < y) << (y < x) << (x == y) << (x != y) << (x <= y) << (x >= y) << std::endl;
+	x.swap(y);
+	print_map(x);
+	print_map(y);
+	std::cout << x.value_comp()(*x.begin(), *y.rbegin()) << std::endl;
+}
+
+void map_test_wide_keys() {
+	ft::vector<ft::pair<unsigned long, std::string> > v;
+	for (unsigned long i = 0; i < 3000; ++i)
+		v.push_back(ft::pair<unsigned long, std::string>(i * i * 2654435761ul, std::string(1, 'a' + i % 26)));
+	v.push_back(ft::pair<unsigned long, std::string>(static_cast<unsigned long>(-1), "max"));
+	ft::frozen_map<unsigned long, std::string> m(v.begin(), v.end());
+	std::string seen;
+	for (unsigned long i = 0; i < 3000; i += 7) {
+		ft::frozen_map<unsigned long, std::string>::const_iterator it = m.upper_bound(i * i * 2654435761ul);
+		seen += it == m.end() ? "." : it->second;
+	}
+	std::cout << m.size() << " " << seen << " " << m.find(static_cast<unsigned long>(-1))->second
+		<< " " << m.count(12345) << std::endl;
+}
+
+// unsorted integer keys with repeats and heap-owning values, staged before the SIMD index is built
+void map_test_staged_values() {
+	ft::vector<ft::pair<int, std::string> > v;
+	for (int i = 0; i < 500; ++i)
+		v.push_back(ft::pair<int, std::string>(i * 37 % 101, std::string(40, static_cast<char>('a' + i % 26))));
+	ft::frozen_map<int, std::string> m(v.begin(), v.end());
+	std::cout << m.size() << " " << m.find(0)->second.substr(0, 2) << " " << m.rbegin()->first << " "
+		<< m.upper_bound(50)->second[0] << std::endl;
+}
+
+int main() {
+	map_test_construct();
+	map_test_bounds();
+	map_test_freeze();
+	map_test_unsorted_strings();
+	map_test_compare();
+	map_test_wide_keys();
+	map_test_staged_values();
+}
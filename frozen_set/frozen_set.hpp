@@ -0,0 +1,162 @@
+#ifndef FROZEN_SET_HPP
+#define FROZEN_SET_HPP
+
+#include <iostream>
+#include "../tree/frozen_select.hpp"
+#include "../set/set.hpp"
+#include "../set/ret_value.hpp"
+#include "../utility/sorted_unique.hpp"
+
+namespace ft {
+	// Read-only sorted set built once from a range or an ft::set (see
+	// freeze). Keys sit in one array in Eytzinger order, so find and the
+	// bounds are a short branch-free loop over mostly cached slots;
+	// iteration is still in key order. 32 and 64-bit integer keys under
+	// std::less get a sorted array with a SIMD-searched index instead
+	// (see simdTree).
+	template <class T, class Compare = std::less<T>, class Allocator = std::allocator<T> >
+	class frozen_set {
+	public:
+
+		// DEF
+
+		typedef T									key_type;
+		typedef T									value_type;
+		typedef std::size_t							size_type;
+		typedef std::ptrdiff_t						difference_type;
+		typedef Compare								key_compare;
+		typedef Compare								value_compare;
+		typedef Allocator							allocator_type;
+		typedef const value_type&					reference;
+		typedef const value_type&					const_reference;
+		typedef typename Allocator::const_pointer	pointer;
+		typedef typename Allocator::const_pointer	const_pointer;
+	private:
+		typedef typename ft::frozen_select<key_type, value_type, ft::ret_value<value_type>, key_compare, allocator_type>::type tree;
+		tree _tree;
+	public:
+		typedef typename tree::iterator iterator;
+		typedef typename tree::const_iterator const_iterator;
+		typedef typename tree::reverse_iterator reverse_iterator;
+		typedef typename tree::const_reverse_iterator const_reverse_iterator;
+
+		// CONSTRUCTORS + DESTRUCTOR
+
+		explicit frozen_set(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) :
+			_tree(comp, alloc) {}
+
+		template<class InputIterator>
+		frozen_set(InputIterator first, InputIterator last, const key_compare& comp = key_compare(),
+			const allocator_type& alloc = allocator_type()) : _tree(comp, alloc) {
+			_tree.assign(first, last);
+		}
+
+		template<class InputIterator>
+		frozen_set(ft::sorted_unique_t, InputIterator first, InputIterator last, const key_compare& comp = key_compare(),
+			const allocator_type& alloc = allocator_type()) : _tree(comp, alloc) {
+			_tree.assign_sorted(first, last);
+		}
+
+		template<class NodePolicy>
+		explicit frozen_set(const set<T, Compare, Allocator, NodePolicy>& s) : _tree(s.key_comp(), s.get_allocator()) {
+			_tree.assign_sorted(s.begin(), s.end());
+		}
+
+		frozen_set(const frozen_set& x) : _tree(x._tree) {}
+
+		// OPERATORS
+
+		frozen_set& operator=(const frozen_set& other) {
+			_tree = other._tree;
+			return *this;
+		}
+
+		// MEMBER FUNCTIONS
+
+		iterator begin() const {
+			return _tree.begin();
+		}
+		size_type count(const key_type& k) const {
+			return _tree.find(k) == _tree.end() ? 0 : 1;
+		}
+		bool empty() const {
+			return _tree.size() == 0;
+		}
+		iterator end() const {
+			return _tree.end();
+		}
+		ft::pair<iterator, iterator> equal_range(const key_type& k) const {
+			return ft::pair<iterator, iterator>(_tree.lower_bound(k), _tree.upper_bound(k));
+		}
+		iterator find(const key_type& k) const {
+			return _tree.find(k);
+		}
+		allocator_type get_allocator() const {
+			return _tree.get_allocator();
+		}
+		key_compare key_comp() const {
+			return _tree.key_comp();
+		}
+		iterator lower_bound(const key_type& k) const {
+			return _tree.lower_bound(k);
+		}
+		size_type max_size() const {
+			return _tree.max_size();
+		}
+		reverse_iterator rbegin() const {
+			return reverse_iterator(end());
+		}
+		reverse_iterator rend() const {
+			return reverse_iterator(begin());
+		}
+		size_type size() const {
+			return _tree.size();
+		}
+		void swap(frozen_set& x) {
+			_tree.swap(x._tree);
+		}
+		iterator upper_bound(const key_type& k) const {
+			return _tree.upper_bound(k);
+		}
+		value_compare value_comp() const {
+			return _tree.key_comp();
+		}
+	};
+
+	template<typename T1, typename Comp, typename Alloc>
+	inline bool operator==(const frozen_set<T1, Comp, Alloc> &x, const frozen_set<T1, Comp, Alloc> &y) {
+		return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
+	}
+	template<typename T1, typename Comp, typename Alloc>
+	inline bool operator!=(const frozen_set<T1, Comp, Alloc> &x, const frozen_set<T1, Comp, Alloc> &y) {
+		return !(x == y);
+	}
+	template<typename T1, typename Comp, typename Alloc>
+	inline bool operator<(const frozen_set<T1, Comp, Alloc> &x, const frozen_set<T1, Comp, Alloc> &y) {
+		return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+	}
+	template<typename T1, typename Comp, typename Alloc>
+	inline bool operator>(const frozen_set<T1, Comp, Alloc> &x, const frozen_set<T1, Comp, Alloc> &y) {
+		return y < x;
+	}
+	template<typename T1, typename Comp, typename Alloc>
+	inline bool operator<=(const frozen_set<T1, Comp, Alloc> &x, const frozen_set<T1, Comp, Alloc> &y) {
+		return !(y < x);
+	}
+	template<typename T1, typename Comp, typename Alloc>
+	inline bool operator>=(const frozen_set<T1, Comp, Alloc> &x, const frozen_set<T1, Comp, Alloc> &y) {
+		return !(x < y);
+	}
+	template<typename T1, typename Comp, typename Alloc>
+	inline void swap(frozen_set<T1, Comp, Alloc> &x, frozen_set<T1, Comp, Alloc> &y) {
+		x.swap(y);
+	}
+
+	// read-only copy of s for lookup-heavy use; s is left as it was
+	template<typename T1, typename Comp, typename Alloc, typename NP>
+	inline frozen_set<T1, Comp, Alloc> freeze(const set<T1, Comp, Alloc, NP>& s) {
+		return frozen_set<T1, Comp, Alloc>(s);
+	}
+}
+
+#endif
@@ -0,0 +1,133 @@
+#include "frozen_set.hpp"
+#include "../tree/pair.hpp"
+#include "../vector/vector.hpp"
+#include <set>
+
+template <class S>
+void print_set(const S &v)
+{
+	typename S::const_iterator begin = v.begin();
+	typename S::const_iterator end = v.end();
+	std::cout << "size=\t\t" << v.size() << std::endl;
+	for (; begin != end; begin++)
+		std::cout << "\033[38;5;46m" << *begin << "\033[0m ";
+	std::cout << std::endl;
+}
+
+void set_test_construct() {
+	int keys[] = {42, 7, 19, 7, 3, 100, 42, -5, 0, 19};
+	ft::frozen_set<int> one(keys, keys + 10);
+	print_set(one);
+	ft::frozen_set<int> two(one);
+	print_set(two);
+	ft::frozen_set<int> three;
+	print_set(three);
+	three = two;
+	print_set(three);
+	std::cout << (one == two) << " " << (one == three) << " " << three.empty() << std::endl;
+}
+
+// every tree shape up to 70 slots, probed on and between the keys
+void set_test_bounds() {
+	for (int n = 0; n <= 70; ++n) {
+		ft::vector<int> keys;
+		for (int i = n - 1; i >= 0; --i)
+			keys.push_back(i * 2);
+		ft::frozen_set<int> s(keys.begin(), keys.end());
+		unsigned long long sum = 0;
+		for (int k = -1; k <= 2 * n; ++k) {
+			ft::frozen_set<int>::iterator lo = s.lower_bound(k);
+			ft::frozen_set<int>::iterator hi = s.upper_bound(k);
+			sum = sum * 31 + (lo == s.end() ? -1 : *lo);
+			sum = sum * 31 + (hi == s.end() ? -1 : *hi);
+			sum = sum * 31 + (s.find(k) == s.end()) + s.count(k);
+			ft::pair<ft::frozen_set<int>::iterator, ft::frozen_set<int>::iterator> range = s.equal_range(k);
+			sum += (range.first == lo) + (range.second == hi);
+		}
+		unsigned back = 0;
+		for (ft::frozen_set<int>::reverse_iterator it = s.rbegin(); it != s.rend(); ++it)
+			back = back * 7 + *it;
+		std::cout << n << " " << sum << " " << back << std::endl;
+	}
+}
+
+void set_test_iterators() {
+	ft::vector<int> keys;
+	for (int i = 0; i < 12; ++i)
+		keys.push_back((i * 5) % 12);
+	ft::frozen_set<int> s(keys.begin(), keys.end());
+	ft::frozen_set<int>::iterator it = s.end();
+	while (it != s.begin()) {
+		--it;
+		std::cout << *it << " ";
+	}
+	std::cout << std::endl;
+	it = s.find(6);
+	it++;
+	std::cout << *it << " ";
+	it--;
+	it--;
+	std::cout << *it << std::endl;
+}
+
+void set_test_freeze() {
+	ft::set<int> source;
+	for (int i = 0; i < 20; ++i)
+		source.insert((i * 13) % 31);
+	print_set(ft::freeze(source));
+	ft::frozen_set<int> copy(source.begin(), source.end());
+	print_set(copy);
+	std::cout << source.size() << std::endl;
+}
+
+void set_test_compare() {
+	int a[] = {1, 2, 3};
+	int b[] = {1, 2, 4};
+	ft::frozen_set<int> x(a, a + 3);
+	ft::frozen_set<int> y(b, b + 3);
+	ft::frozen_set<int> z(a, a + 2);
+	std::cout << (x < y) << (y < x) << (z < x) << (x <= x) << (x > z) << (x >= y) << (x != y) << std::endl;
+	x.swap(y);
+	print_set(x);
+	print_set(y);
+}
+
+void set_test_comp() {
+	const char* words[] = {"pear", "apple", "fig", "kiwi", "banana", "fig"};
+	ft::frozen_set<std::string, std::greater<std::string> > s(words, words + 6);
+	print_set(s);
+	std::cout << *s.lower_bound("grape") << " " << *s.upper_bound("fig") << " " << s.count("kiwi") << std::endl;
+}
+
+// wide integer keys at the ends of their range and deep enough for four index levels
+template <class K>
+void set_test_integer_keys(K lo, K hi) {
+	ft::vector<K> keys;
+	for (K i = 0; i < 6000; ++i)
+		keys.push_back(static_cast<K>(i * 7919 % 6007));
+	keys.push_back(lo);
+	keys.push_back(hi);
+	keys.push_back(static_cast<K>(hi - 1));
+	ft::frozen_set<K> s(keys.begin(), keys.end());
+	unsigned long long sum = 0;
+	for (long long k = -3; k <= 6010; ++k) {
+		typename ft::frozen_set<K>::iterator it = s.lower_bound(static_cast<K>(k));
+		sum = sum * 31 + (it == s.end() ? 1 : static_cast<unsigned long long>(*it));
+		sum = sum * 31 + s.count(static_cast<K>(k));
+	}
+	std::cout << s.size() << " " << sum << " " << (s.upper_bound(hi) == s.end()) << " " << (*s.begin() == lo)
+		<< " " << (*s.upper_bound(lo) == 0) << " " << (*s.lower_bound(static_cast<K>(hi - 1)) == static_cast<K>(hi - 1)) << std::endl;
+}
+
+int main() {
+	set_test_construct();
+	set_test_bounds();
+	set_test_iterators();
+	set_test_freeze();
+	set_test_compare();
+	set_test_comp();
+	set_test_integer_keys<int>(-2147483647 - 1, 2147483647);
+	set_test_integer_keys<unsigned>(0, 4294967295u);
+	set_test_integer_keys<long long>(-9223372036854775807LL - 1, 9223372036854775807LL);
+	set_test_integer_keys<unsigned long>(0, static_cast<unsigned long>(-1));
+}
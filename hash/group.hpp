@@ -0,0 +1,116 @@
+#ifndef GROUP_HPP
+#define GROUP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
+
+namespace ft {
+	// Control byte of a hash table slot. Full slots store the low 7 bits of
+	// the hash (0..127); the special values are all negative so a signed
+	// compare separates them.
+	typedef signed char ctrl_t;
+
+	static const ctrl_t ctrl_empty = -128;
+	static const ctrl_t ctrl_deleted = -2;
+	static const ctrl_t ctrl_sentinel = -1;
+
+	inline bool ctrl_is_full(ctrl_t c) {
+		return c >= 0;
+	}
+
+	// Bit mask of matching positions inside a group, iterated low to high.
+	class bit_mask {
+	public:
+		explicit bit_mask(std::uint32_t mask) : _mask(mask) {}
+
+		operator bool() const {
+			return _mask != 0;
+		}
+		unsigned lowest() const {
+			return __builtin_ctz(_mask);
+		}
+		// zero counts are taken over the 16 group positions
+		unsigned leading_zeros() const {
+			return _mask == 0 ? 16 : __builtin_clz(_mask << 16);
+		}
+		unsigned trailing_zeros() const {
+			return _mask == 0 ? 16 : __builtin_ctz(_mask);
+		}
+		bit_mask& operator++() {
+			_mask &= _mask - 1;
+			return *this;
+		}
+	private:
+		std::uint32_t	_mask;
+	};
+
+	// Sixteen control bytes loaded at once; each query is one compare and
+	// one movemask on SSE2, a byte loop elsewhere.
+	struct group {
+		static const std::size_t width = 16;
+
+#ifdef __SSE2__
+		explicit group(const ctrl_t* pos) : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+		bit_mask match(ctrl_t h2) const {
+			return bit_mask(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)));
+		}
+		bit_mask match_empty() const {
+			return match(ctrl_empty);
+		}
+		bit_mask match_empty_or_deleted() const {
+			return bit_mask(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(ctrl_sentinel), ctrl)));
+		}
+		unsigned count_leading_empty_or_deleted() const {
+			std::uint32_t mask = _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(ctrl_sentinel), ctrl));
+			return __builtin_ctz(~mask);
+		}
+		__m128i	ctrl;
+#else
+		explicit group(const ctrl_t* pos) {
+			std::memcpy(ctrl, pos, width);
+		}
+
+		bit_mask match(ctrl_t h2) const {
+			std::uint32_t mask = 0;
+			for (std::size_t i = 0; i < width; ++i)
+				mask |= static_cast<std::uint32_t>(ctrl[i] == h2) << i;
+			return bit_mask(mask);
+		}
+		bit_mask match_empty() const {
+			return match(ctrl_empty);
+		}
+		bit_mask match_empty_or_deleted() const {
+			std::uint32_t mask = 0;
+			for (std::size_t i = 0; i < width; ++i)
+				mask |= static_cast<std::uint32_t>(ctrl[i] < ctrl_sentinel) << i;
+			return bit_mask(mask);
+		}
+		unsigned count_leading_empty_or_deleted() const {
+			unsigned i = 0;
+			while (i < width && ctrl[i] < ctrl_sentinel)
+				++i;
+			return i;
+		}
+		ctrl_t	ctrl[width];
+#endif
+	};
+
+	// Control bytes of a table that has never allocated: a sentinel followed
+	// by empties, so lookups miss and begin() == end() without branching.
+	inline ctrl_t* empty_group() {
+		alignas(16) static ctrl_t ctrl[group::width] = {
+			ctrl_sentinel, ctrl_empty, ctrl_empty, ctrl_empty,
+			ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty,
+			ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty,
+			ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty
+		};
+		return ctrl;
+	}
+}
+
+#endif
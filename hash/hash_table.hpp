@@ -0,0 +1,484 @@
+#ifndef HASH_TABLE_HPP
+#define HASH_TABLE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include "group.hpp"
+#include "../tree/pair.hpp"
+
+namespace ft {
+	template <typename T>
+	class hash_iterator {
+	public:
+		typedef T								value_type;
+		typedef T&								reference;
+		typedef T*								pointer;
+		typedef std::forward_iterator_tag		iterator_category;
+		typedef std::ptrdiff_t					difference_type;
+		typedef hash_iterator<T>				iterator;
+
+		hash_iterator() : ctrl(), slot() {}
+		hash_iterator(ctrl_t* c, T* s) : ctrl(c), slot(s) {}
+
+		reference operator*() const {
+			return *slot;
+		}
+		pointer operator->() const {
+			return slot;
+		}
+		iterator& operator++() {
+			++ctrl;
+			++slot;
+			skip_empty_or_deleted();
+			return *this;
+		}
+		iterator operator++(int) {
+			iterator tmp = *this;
+			++*this;
+			return tmp;
+		}
+		bool operator==(const iterator& x) const {
+			return ctrl == x.ctrl;
+		}
+		bool operator!=(const iterator& x) const {
+			return ctrl != x.ctrl;
+		}
+		// jumps over whole runs of free slots a group at a time; the sentinel
+		// after the last slot stops the walk
+		void skip_empty_or_deleted() {
+			while (*ctrl < ctrl_sentinel) {
+				unsigned shift = group(ctrl).count_leading_empty_or_deleted();
+				ctrl += shift;
+				slot += shift;
+			}
+		}
+
+		ctrl_t*	ctrl;
+		T*		slot;
+	};
+
+	template <typename T>
+	class hash_const_iterator {
+	public:
+		typedef T								value_type;
+		typedef const T&						reference;
+		typedef const T*						pointer;
+		typedef std::forward_iterator_tag		iterator_category;
+		typedef std::ptrdiff_t					difference_type;
+		typedef hash_const_iterator<T>			iterator;
+		typedef hash_iterator<T>				iterr;
+
+		hash_const_iterator() : ctrl(), slot() {}
+		hash_const_iterator(const ctrl_t* c, const T* s) : ctrl(c), slot(s) {}
+		hash_const_iterator(const iterr& iter) : ctrl(iter.ctrl), slot(iter.slot) {}
+
+		reference operator*() const {
+			return *slot;
+		}
+		pointer operator->() const {
+			return slot;
+		}
+		iterator& operator++() {
+			iterr it(const_cast<ctrl_t*>(ctrl), const_cast<T*>(slot));
+			++it;
+			ctrl = it.ctrl;
+			slot = it.slot;
+			return *this;
+		}
+		iterator operator++(int) {
+			iterator tmp = *this;
+			++*this;
+			return tmp;
+		}
+		bool operator==(const iterator& x) const {
+			return ctrl == x.ctrl;
+		}
+		bool operator!=(const iterator& x) const {
+			return ctrl != x.ctrl;
+		}
+
+		const ctrl_t*	ctrl;
+		const T*		slot;
+	};
+
+	template <typename Val>
+	inline bool operator==(const hash_iterator<Val>& x, const hash_const_iterator<Val>& y) {
+		return x.ctrl == y.ctrl;
+	}
+	template <typename Val>
+	inline bool operator!=(const hash_iterator<Val>& x, const hash_const_iterator<Val>& y) {
+		return x.ctrl != y.ctrl;
+	}
+
+	// Open-addressing hash table in the SwissTable layout: one control byte
+	// per slot plus a cloned copy of the first group after a sentinel, so a
+	// 16-byte group load at any slot index never wraps. Capacity is always
+	// 2^k - 1 and at most 7/8 of it is used.
+	template<typename Key, typename Val, typename KeyOfValue, typename Hash = std::hash<Key>,
+		typename KeyEqual = std::equal_to<Key>, typename Alloc = std::allocator<Val> >
+	class hashTable {
+		typedef typename Alloc::template rebind<ctrl_t>::other ctrl_allocator;
+	public:
+
+		typedef Val										value_type;
+		typedef Key										key_type;
+		typedef Hash									hasher;
+		typedef KeyEqual								key_equal;
+		typedef Alloc									allocator_type;
+		typedef value_type*								pointer;
+		typedef const value_type*						const_pointer;
+		typedef value_type&								reference;
+		typedef const value_type&						const_reference;
+		typedef std::size_t								size_type;
+		typedef std::ptrdiff_t							difference_type;
+		typedef hash_iterator<value_type>				iterator;
+		typedef hash_const_iterator<value_type>			const_iterator;
+
+		hashTable() : _ctrl(empty_group()), _slots(0), _capacity(0), _size(0), _growth_left(0),
+			_hash(), _eq(), _allocator(), _ctrlAlloc() {}
+		hashTable(size_type n, const hasher& hf, const key_equal& eql, const allocator_type& a = allocator_type()) :
+				_ctrl(empty_group()), _slots(0), _capacity(0), _size(0), _growth_left(0),
+				_hash(hf), _eq(eql), _allocator(a), _ctrlAlloc(a) {
+			if (n)
+				reserve(n);
+		}
+		hashTable(const hashTable& other) : _ctrl(empty_group()), _slots(0), _capacity(0), _size(0),
+				_growth_left(0), _hash(other._hash), _eq(other._eq), _allocator(other._allocator),
+				_ctrlAlloc(other._ctrlAlloc) {
+			reserve(other._size);
+			for (const_iterator it = other.begin(); it != other.end(); ++it) {
+				size_type h = _hash_of(KeyOfValue()(*it));
+				size_type i = _find_first_non_full(h);
+				_allocator.construct(_slots + i, *it);
+				_set_ctrl(i, _h2(h));
+				--_growth_left;
+				++_size;
+			}
+		}
+		hashTable& operator=(const hashTable& other) {
+			if (this != &other) {
+				hashTable tmp(other);
+				swap(tmp);
+			}
+			return *this;
+		}
+		~hashTable() {
+			_destroy_slots();
+			_deallocate();
+		}
+
+		iterator begin() {
+			iterator it(_ctrl, _slots);
+			it.skip_empty_or_deleted();
+			return it;
+		}
+		const_iterator begin() const {
+			return const_cast<hashTable*>(this)->begin();
+		}
+		size_type bucket_count() const {
+			return _capacity;
+		}
+		void clear() {
+			_destroy_slots();
+			if (_capacity) {
+				_reset_ctrl();
+				_growth_left = _growth(_capacity);
+			}
+			_size = 0;
+		}
+		size_type count(const key_type& k) const {
+			return find(k) == end() ? 0 : 1;
+		}
+		bool empty() const {
+			return _size == 0;
+		}
+		iterator end() {
+			return iterator(_ctrl + _capacity, _slots + _capacity);
+		}
+		const_iterator end() const {
+			return const_iterator(_ctrl + _capacity, _slots + _capacity);
+		}
+		ft::pair<iterator, iterator> equal_range(const key_type& k) {
+			iterator it = find(k);
+			if (it == end())
+				return ft::pair<iterator, iterator>(it, it);
+			iterator next = it;
+			return ft::pair<iterator, iterator>(it, ++next);
+		}
+		ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+			const_iterator it = find(k);
+			if (it == end())
+				return ft::pair<const_iterator, const_iterator>(it, it);
+			const_iterator next = it;
+			return ft::pair<const_iterator, const_iterator>(it, ++next);
+		}
+		void erase(iterator position) {
+			size_type i = position.ctrl - _ctrl;
+			_allocator.destroy(_slots + i);
+			--_size;
+			// the slot can go back to empty when no probe ever ran past it,
+			// i.e. the window of 16 around it was never completely full
+			size_type before = (i - group::width) & _capacity;
+			bit_mask empty_after = group(_ctrl + i).match_empty();
+			bit_mask empty_before = group(_ctrl + before).match_empty();
+			if (empty_before && empty_after
+				&& empty_after.trailing_zeros() + empty_before.leading_zeros() < group::width) {
+				_set_ctrl(i, ctrl_empty);
+				++_growth_left;
+			}
+			else
+				_set_ctrl(i, ctrl_deleted);
+		}
+		size_type erase(const key_type& k) {
+			iterator it = find(k);
+			if (it == end())
+				return 0;
+			erase(it);
+			return 1;
+		}
+		void erase(iterator first, iterator last) {
+			while (first != last)
+				erase(first++);
+		}
+		iterator find(const key_type& k) {
+			return _find(k, _hash_of(k));
+		}
+		const_iterator find(const key_type& k) const {
+			return const_cast<hashTable*>(this)->find(k);
+		}
+		allocator_type get_allocator() const {
+			return _allocator;
+		}
+		hasher hash_function() const {
+			return _hash;
+		}
+		ft::pair<iterator, bool> insert(const value_type& val) {
+			size_type h = _hash_of(KeyOfValue()(val));
+			ft::pair<size_type, bool> res = _find_or_prepare_insert(KeyOfValue()(val), h);
+			if (res.second) {
+				_allocator.construct(_slots + res.first, val);
+				_commit_insert(res.first, h);
+			}
+			return ft::pair<iterator, bool>(iterator(_ctrl + res.first, _slots + res.first), res.second);
+		}
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last) {
+			for (; first != last; ++first)
+				insert(*first);
+		}
+		key_equal key_eq() const {
+			return _eq;
+		}
+		float load_factor() const {
+			return _capacity ? static_cast<float>(_size) / _capacity : 0.0f;
+		}
+		float max_load_factor() const {
+			return 0.875f;
+		}
+		size_type max_size() const {
+			return _allocator.max_size();
+		}
+		// rebuilds the table with room for at least n slots, dropping tombstones
+		void rehash(size_type n) {
+			size_type cap = group::width - 1;
+			while (cap < n || _growth(cap) < _size)
+				cap = cap * 2 + 1;
+			if (_size == 0 && n == 0) {
+				_destroy_slots();
+				_deallocate();
+				_ctrl = empty_group(), _slots = 0;
+				_capacity = 0, _growth_left = 0;
+				return;
+			}
+			_resize(cap);
+		}
+		void reserve(size_type n) {
+			if (n <= _size + _growth_left)
+				return;
+			size_type cap = group::width - 1;
+			while (_growth(cap) < n)
+				cap = cap * 2 + 1;
+			_resize(cap);
+		}
+		size_type size() const {
+			return _size;
+		}
+		void swap(hashTable& sw) {
+			std::swap(_ctrl, sw._ctrl);
+			std::swap(_slots, sw._slots);
+			std::swap(_capacity, sw._capacity);
+			std::swap(_size, sw._size);
+			std::swap(_growth_left, sw._growth_left);
+			std::swap(_hash, sw._hash);
+			std::swap(_eq, sw._eq);
+			std::swap(_allocator, sw._allocator);
+			std::swap(_ctrlAlloc, sw._ctrlAlloc);
+		}
+		// inserts (k, mapped(args...)) unless k is present, so with no args
+		// the mapped value is value-initialised; nothing is built on a hit
+		template<class... Args>
+		ft::pair<iterator, bool> try_emplace(const key_type& k, Args&&... args) {
+			size_type h = _hash_of(k);
+			ft::pair<size_type, bool> res = _find_or_prepare_insert(k, h);
+			if (res.second) {
+				_allocator.construct(_slots + res.first, ft::emplace_second, k, std::forward<Args>(args)...);
+				_commit_insert(res.first, h);
+			}
+			return ft::pair<iterator, bool>(iterator(_ctrl + res.first, _slots + res.first), res.second);
+		}
+
+	private:
+		ctrl_t*			_ctrl;
+		Val*			_slots;
+		size_type		_capacity;
+		size_type		_size;
+		size_type		_growth_left;
+		hasher			_hash;
+		key_equal		_eq;
+		allocator_type	_allocator;
+		ctrl_allocator	_ctrlAlloc;
+
+		static size_type _growth(size_type cap) {
+			return cap - cap / 8;
+		}
+		// std::hash is the identity for integers; the multiply spreads the
+		// key over all bits so both H1 and H2 see entropy
+		size_type _hash_of(const key_type& k) const {
+			unsigned long long x = static_cast<unsigned long long>(_hash(k)) * 0x9E3779B97F4A7C15ULL;
+			return static_cast<size_type>(x ^ (x >> 32));
+		}
+		static size_type _h1(size_type h) {
+			return h >> 7;
+		}
+		static ctrl_t _h2(size_type h) {
+			return static_cast<ctrl_t>(h & 0x7f);
+		}
+		void _set_ctrl(size_type i, ctrl_t c) {
+			_ctrl[i] = c;
+			if (i < group::width - 1)
+				_ctrl[_capacity + 1 + i] = c;
+		}
+		void _reset_ctrl() {
+			for (size_type i = 0; i < _capacity + group::width; ++i)
+				_ctrl[i] = ctrl_empty;
+			_ctrl[_capacity] = ctrl_sentinel;
+		}
+		iterator _find(const key_type& k, size_type h) {
+			ctrl_t h2 = _h2(h);
+			size_type offset = _h1(h) & _capacity;
+			for (size_type step = group::width; ; step += group::width) {
+				group g(_ctrl + offset);
+				for (bit_mask m = g.match(h2); m; ++m) {
+					size_type i = (offset + m.lowest()) & _capacity;
+					if (_eq(KeyOfValue()(_slots[i]), k))
+						return iterator(_ctrl + i, _slots + i);
+				}
+				if (g.match_empty())
+					return end();
+				offset = (offset + step) & _capacity;
+			}
+		}
+		size_type _find_first_non_full(size_type h) const {
+			size_type offset = _h1(h) & _capacity;
+			for (size_type step = group::width; ; step += group::width) {
+				bit_mask m = group(_ctrl + offset).match_empty_or_deleted();
+				if (m)
+					return (offset + m.lowest()) & _capacity;
+				offset = (offset + step) & _capacity;
+			}
+		}
+		// index of k if present (second == false), otherwise of the slot it
+		// should be constructed in, growing the table first if needed
+		ft::pair<size_type, bool> _find_or_prepare_insert(const key_type& k, size_type h) {
+			iterator it = _find(k, h);
+			if (it != end())
+				return ft::pair<size_type, bool>(it.ctrl - _ctrl, false);
+			size_type i = _find_first_non_full(h);
+			if (_growth_left == 0 && _ctrl[i] != ctrl_deleted) {
+				_rehash_and_grow();
+				i = _find_first_non_full(h);
+			}
+			return ft::pair<size_type, bool>(i, true);
+		}
+		void _commit_insert(size_type i, size_type h) {
+			if (_ctrl[i] == ctrl_empty)
+				--_growth_left;
+			_set_ctrl(i, _h2(h));
+			++_size;
+		}
+		// mostly tombstones: rebuild at the same size; otherwise double
+		void _rehash_and_grow() {
+			if (_capacity > group::width && _size * 32 <= _capacity * 25)
+				_resize(_capacity);
+			else
+				_resize(_capacity ? _capacity * 2 + 1 : group::width - 1);
+		}
+		void _resize(size_type new_cap) {
+			ctrl_t* old_ctrl = _ctrl;
+			Val* old_slots = _slots;
+			size_type old_cap = _capacity;
+			_ctrl = _ctrlAlloc.allocate(new_cap + group::width);
+			try {
+				_slots = _allocator.allocate(new_cap);
+			}
+			catch (...) {
+				_ctrlAlloc.deallocate(_ctrl, new_cap + group::width);
+				_ctrl = old_ctrl;
+				throw;
+			}
+			_capacity = new_cap;
+			_reset_ctrl();
+			_growth_left = _growth(new_cap) - _size;
+			for (size_type i = 0; i < old_cap; ++i) {
+				if (!ctrl_is_full(old_ctrl[i]))
+					continue;
+				size_type h = _hash_of(KeyOfValue()(old_slots[i]));
+				size_type j = _find_first_non_full(h);
+				_allocator.construct(_slots + j, std::move_if_noexcept(old_slots[i]));
+				_allocator.destroy(old_slots + i);
+				_set_ctrl(j, _h2(h));
+			}
+			if (old_cap) {
+				_ctrlAlloc.deallocate(old_ctrl, old_cap + group::width);
+				_allocator.deallocate(old_slots, old_cap);
+			}
+		}
+		void _destroy_slots() {
+			for (size_type i = 0; i < _capacity; ++i) {
+				if (ctrl_is_full(_ctrl[i]))
+					_allocator.destroy(_slots + i);
+			}
+		}
+		void _deallocate() {
+			if (_capacity) {
+				_ctrlAlloc.deallocate(_ctrl, _capacity + group::width);
+				_allocator.deallocate(_slots, _capacity);
+			}
+		}
+	};
+
+	// equal when every element of x is found in y with the same value
+	template<typename Key, typename Val, typename KeyOfValue, typename Hash, typename KeyEqual, typename Alloc>
+	inline bool operator==(const hashTable<Key, Val, KeyOfValue, Hash, KeyEqual, Alloc>& x,
+						   const hashTable<Key, Val, KeyOfValue, Hash, KeyEqual, Alloc>& y) {
+		typedef typename hashTable<Key, Val, KeyOfValue, Hash, KeyEqual, Alloc>::const_iterator const_iterator;
+		if (x.size() != y.size())
+			return false;
+		for (const_iterator it = x.begin(); it != x.end(); ++it) {
+			const_iterator other = y.find(KeyOfValue()(*it));
+			if (other == y.end() || !(*other == *it))
+				return false;
+		}
+		return true;
+	}
+	template<typename Key, typename Val, typename KeyOfValue, typename Hash, typename KeyEqual, typename Alloc>
+	inline bool operator!=(const hashTable<Key, Val, KeyOfValue, Hash, KeyEqual, Alloc>& x,
+						   const hashTable<Key, Val, KeyOfValue, Hash, KeyEqual, Alloc>& y) {
+		return !(x == y);
+	}
+}
+
+#endif
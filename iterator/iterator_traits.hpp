@@ -1,6 +1,9 @@
 #ifndef ITERATOR_TRAITS_HPP
 #define ITERATOR_TRAITS_HPP
 
+#include <cstddef>
+#include <iterator>
+
 namespace ft {
 	template<class Iter>
 	struct iterator_traits {
@@ -22,8 +25,8 @@ namespace ft {
 	struct iterator_traits<const T*> {
 		typedef std::ptrdiff_t difference_type;
 		typedef T value_type;
-		typedef T* pointer;
-		typedef T& reference;
+		typedef const T* pointer;
+		typedef const T& reference;
 		typedef std::random_access_iterator_tag iterator_category;
 	};
 }
@@ -32,7 +32,9 @@ namespace ft {
 			return *--tmp;
 		}
 		pointer operator->() const {
-			return &(operator*());
+			Iter tmp = _it;
+			--tmp;
+			return _arrow(tmp);
 		}
 		reference operator[](difference_type n) const {
 			return *(*this + n);
@@ -71,6 +73,16 @@ namespace ft {
 		}
 	protected:
 		Iter _it;
+	private:
+		// a pointer is its own arrow; class iterators may hand back a proxy
+		template<class P>
+		static P* _arrow(P* it) {
+			return it;
+		}
+		template<class I>
+		static pointer _arrow(I it) {
+			return it.operator->();
+		}
 	};
 	template <class Iter1, class Iter2>
 	inline bool operator==(const reverse_iterator<Iter1>& x, const reverse_iterator<Iter2>& y) {
@@ -1,6 +1,7 @@
 #include "map.hpp"
 #include "../vector/vector.hpp"
 #include <map>
+#include <mutex>
 
 template <class T1, class T2>
 void print_map(ft::map<T1, T2> &v)
@@ -412,6 +413,389 @@ void map_test_comp() {
 	}
 }
 
+void map_test_pool_allocator() {
+	typedef ft::map<int, std::string, std::less<int>, ft::pool_allocator<ft::pair<const int, std::string> > > pool_map;
+	pool_map a;
+	for (int i = 0; i < 5000; ++i)
+		a.insert(ft::pair<int, std::string>(i, std::string(i % 40, 'x')));
+	for (int i = 100; i < 4900; ++i)
+		a.erase(i);
+	for (int i = 200; i < 300; ++i)
+		a[i] = "reused";
+	pool_map b;
+	b[-1] = "other";
+	a.swap(b);
+	std::cout << a.size() << " " << b.size() << std::endl;
+	for (pool_map::iterator it = b.begin(); it != b.end(); ++it)
+		std::cout << it->first << "->" << it->second << " ";
+	std::cout << std::endl;
+	b.clear();
+	b[7] = "after clear";
+	std::cout << b.size() << " " << b.begin()->second << std::endl;
+
+	ft::map<int, int, std::less<int>, ft::pool_allocator<ft::pair<const int, int> > > c;
+	for (int i = 0; i < 100000; ++i)
+		c[i * 7 % 100003] = i;
+	std::cout << c.size() << " " << c.begin()->first << " " << c.rbegin()->first << std::endl;
+	c.clear();
+	std::cout << c.size() << std::endl;
+}
+
+void map_test_sorted_construct() {
+	ft::vector<ft::pair<int, int> > sorted;
+	for (int i = 0; i < 1000; ++i)
+		sorted.push_back(ft::pair<int, int>(i * 2, i));
+	ft::map<int, int> a(sorted.begin(), sorted.end());
+	print_map(a);
+	for (int i = 0; i < 2000; i += 5)
+		a.erase(i);
+	for (int i = 1; i < 2000; i += 9)
+		a[i] = -i;
+	print_map(a);
+	sorted.push_back(ft::pair<int, int>(7, 7));
+	sorted.push_back(ft::pair<int, int>(0, 100));
+	ft::map<int, int> b(sorted.begin(), sorted.end());
+	print_map(b);
+}
+
+void map_test_rank_select() {
+	ft::ranked_map<int, int> m;
+	for (int i = 0; i < 2000; ++i)
+		m[(i * 37) % 2003] = i;
+	for (int i = 0; i < 2003; i += 7)
+		m.erase(i);
+	m.erase(m.find(1000), m.find(1100));
+	// reference answers come from walking the map in order
+	bool ok = true;
+	std::size_t idx = 0;
+	for (ft::ranked_map<int, int>::iterator it = m.begin(); it != m.end(); ++it, ++idx) {
+		if (m.select(idx) != it || m.rank(it->first) != idx)
+			ok = false;
+	}
+	std::cout << m.size() << " " << ok << " " << (m.select(m.size()) == m.end()) << std::endl;
+	std::size_t walk = 0;
+	for (ft::ranked_map<int, int>::iterator it = m.lower_bound(100); it != m.lower_bound(1500); ++it)
+		++walk;
+	std::cout << m.count_range(100, 1500) << " " << walk << " " << m.count_range(1500, 100) << std::endl;
+	ft::ranked_map<int, int> copy(m);
+	const ft::ranked_map<int, int>& c = copy;
+	std::cout << c.select(0)->first << " " << c.select(c.size() - 1)->first << " " << c.rank(5000) << std::endl;
+}
+
+void map_test_try_emplace() {
+	ft::map<std::string, int> counts;
+	const char* words[] = {"b", "a", "c", "a", "b", "a", "d"};
+	for (int i = 0; i < 7; ++i)
+		++counts[words[i]];
+	print_map(counts);
+	ft::pair<ft::map<std::string, int>::iterator, bool> r = counts.try_emplace("a", 100);
+	std::cout << r.first->first << " " << r.first->second << " " << r.second << std::endl;
+	r = counts.try_emplace("e", 5);
+	std::cout << r.first->first << " " << r.first->second << " " << r.second << std::endl;
+	r = counts.try_emplace("f");
+	std::cout << r.first->first << " " << r.first->second << " " << r.second << std::endl;
+	r = counts.insert_or_assign("a", 42);
+	std::cout << r.first->first << " " << r.first->second << " " << r.second << std::endl;
+	r = counts.insert_or_assign("0", -1);
+	std::cout << r.first->first << " " << r.first->second << " " << r.second << std::endl;
+	print_map(counts);
+
+	ft::map<int, std::string> names;
+	for (int i = 0; i < 1000; ++i)
+		names.try_emplace(i * 7 % 1000, 3, 'x');
+	std::string s("moved");
+	names.insert_or_assign(3, std::move(s));
+	std::cout << names.size() << " " << names[3] << " " << names[4] << " " << names[999].size() << std::endl;
+
+	// the mapped value is built inside the node, so it need not be movable
+	ft::map<int, std::mutex> locks;
+	for (int i = 0; i < 7; ++i)
+		std::cout << locks.try_emplace(i % 3).second;
+	locks[1].lock();
+	locks[4].lock();
+	locks[1].unlock();
+	locks[4].unlock();
+	std::cout << " " << locks.size() << " " << locks.count(4) << std::endl;
+}
+
+// ranked_map stays ft under the std substitution of test.sh
+void map_test_algebra() {
+	ft::ranked_map<int, char> a;
+	ft::ranked_map<int, char> b;
+	for (int i = 0; i < 3000; i += 2)
+		a[i] = 'a';
+	for (int i = 0; i < 3000; i += 3)
+		b[i] = 'b';
+	ft::ranked_map<int, char> u = set_union(a, b);
+	ft::ranked_map<int, char> n = set_intersection(a, b);
+	ft::ranked_map<int, char> d = set_difference(a, b);
+	ft::ranked_map<int, char> x = set_symmetric_difference(b, a);
+	std::cout << u.size() << " " << n.size() << " " << d.size() << " " << x.size() << std::endl;
+	std::cout << u[6] << u[3] << u[4] << n[6] << d[4] << x[3] << x[4] << std::endl;
+	std::size_t ok = 0;
+	for (int i = 0; i < 3000; ++i) {
+		bool in_a = i % 2 == 0;
+		bool in_b = i % 3 == 0;
+		ok += u.count(i) == (in_a || in_b) && n.count(i) == (in_a && in_b)
+			&& d.count(i) == (in_a && !in_b) && x.count(i) == (in_a != in_b);
+	}
+	std::cout << ok << " " << u.rank(3000) << " " << (*n.select(1)).first << std::endl;
+	ft::ranked_map<int, char> few;
+	few[9] = 'f';
+	few[10] = 'f';
+	std::cout << set_intersection(few, a).size() << set_intersection(a, few).begin()->second
+		<< set_difference(few, a).begin()->first << std::endl;
+}
+
+// ranked_map stays ft under the std substitution of test.sh
+void map_test_split_join() {
+	ft::ranked_map<int, int> m;
+	for (int i = 0; i < 500; ++i)
+		m[i] = i * i;
+	ft::ranked_map<int, int> upper;
+	m.split(123, upper);
+	std::cout << m.size() << " " << upper.size() << " " << m.rbegin()->first << " " << upper.begin()->first
+		<< " " << upper.rank(200) << " " << (*upper.select(10)).second << std::endl;
+	ft::ranked_map<int, int> tail;
+	upper.split(490, tail);
+	m.join(tail);
+	std::cout << m.size() << " " << upper.size() << " " << tail.size() << " " << m.rank(495) << std::endl;
+	ft::ranked_map<int, int> mid;
+	m.split(0, mid);
+	std::cout << m.empty() << " " << mid.size() << std::endl;
+
+	// pooled trees free only their own nodes, so elements are copied across
+	// and must outlive the tree they came from
+	typedef ft::ranked_map<int, std::string, std::less<int>, ft::pool_allocator<ft::pair<const int, std::string> > > pool_map;
+	pool_map joined;
+	{
+		pool_map p;
+		for (int i = 0; i < 300; ++i)
+			p[i] = std::string(30 + i % 7, static_cast<char>('a' + i % 26));
+		pool_map high;
+		p.split(150, high);
+		pool_map low;
+		low.swap(p);
+		low.join(high);
+		std::cout << low.size() << " " << high.size() << " " << p.size() << std::endl;
+		pool_map rest;
+		low.split(100, rest);
+		joined.join(rest);
+	}
+	std::cout << joined.size() << " " << joined.begin()->first << " " << joined.rbegin()->second.substr(0, 3)
+		<< " " << joined.rank(250) << " " << (*joined.select(5)).second.size() << std::endl;
+}
+
+void map_test_erase_range() {
+	ft::map<int, int> m;
+	for (int i = 0; i < 5000; ++i)
+		m[(i * 7919) % 5000] = i;
+	m.erase(m.lower_bound(100), m.lower_bound(4000));
+	m.erase(m.begin(), m.lower_bound(50));
+	m.erase(m.lower_bound(4990), m.end());
+	m.erase(m.lower_bound(60), m.lower_bound(65));
+	long long sum = 0;
+	for (ft::map<int, int>::iterator it = m.begin(); it != m.end(); ++it)
+		sum += it->first * 7 + it->second;
+	std::cout << m.size() << " " << sum << " " << m.begin()->first << " " << m.rbegin()->first << std::endl;
+	for (int i = 0; i < 200; ++i)
+		m[i * 3] = i;
+	m.erase(m.find(150), m.find(3000));
+	std::cout << m.size() << " " << m.count(147) << m.count(150) << m.count(3000) << std::endl;
+}
+
+void map_test_node_handle() {
+	ft::map<int, std::string> a;
+	ft::map<int, std::string> b;
+	for (int i = 0; i < 10; ++i) {
+		a[i] = std::string(i + 1, 'a');
+		b[i * 2] = std::string(i + 1, 'b');
+	}
+	ft::map<int, std::string>::node_type nh = a.extract(3);
+	std::cout << nh.empty() << " " << nh.key() << " " << nh.mapped() << " " << a.size() << " " << a.count(3) << std::endl;
+	nh.key() = 30;
+	nh.mapped() += "!";
+	ft::map<int, std::string>::insert_return_type r = b.insert(std::move(nh));
+	std::cout << r.inserted << " " << r.position->first << " " << r.position->second << " " << r.node.empty() << " " << nh.empty() << std::endl;
+	nh = a.extract(a.find(4));
+	r = b.insert(std::move(nh));
+	std::cout << r.inserted << " " << r.position->second << " " << r.node.empty() << " " << r.node.mapped() << std::endl;
+	std::cout << a.extract(100).empty() << " " << b.insert(ft::map<int, std::string>::node_type()).inserted << std::endl;
+	ft::map<int, std::string>::iterator it = a.insert(a.end(), a.extract(a.begin()));
+	std::cout << it->first << " " << a.size() << std::endl;
+	a.merge(b);
+	print_map(a);
+	print_map(b);
+	b.merge(a);
+	print_map(a);
+	print_map(b);
+}
+
+// compact_map stays ft under the std substitution of test.sh
+void map_test_compact_nodes() {
+	ft::compact_map<int, int> m;
+	for (int i = 0; i < 3000; ++i)
+		m[(i * 37) % 3000] = i;
+	for (int i = 0; i < 3000; i += 4)
+		m.erase(i);
+	m.erase(m.lower_bound(1000), m.lower_bound(2500));
+	ft::compact_map<int, int> copy(m);
+	long long sum = 0;
+	int prev = -1;
+	bool sorted = true;
+	for (ft::compact_map<int, int>::reverse_iterator it = copy.rbegin(); it != copy.rend(); ++it) {
+		sum += it->first * 3 + it->second;
+		if (prev != -1 && it->first >= prev)
+			sorted = false;
+		prev = it->first;
+	}
+	std::cout << copy.size() << " " << sum << " " << sorted << " " << (copy == m) << std::endl;
+}
+
+// arena_map stays ft as well; begin() is kept across the buffer regrowing
+void map_test_arena_nodes() {
+	ft::arena_map<int, int> m;
+	m[-1] = 0;
+	ft::arena_map<int, int>::iterator first = m.begin();
+	for (int i = 0; i < 3000; ++i)
+		m[(i * 37) % 3000] = i;
+	for (int i = 0; i < 3000; i += 4)
+		m.erase(i);
+	m.erase(m.lower_bound(1000), m.lower_bound(2500));
+	for (int i = 0; i < 500; ++i)
+		m.insert(ft::make_pair(i * 6, -i));
+	ft::arena_map<int, int> copy(m);
+	ft::arena_map<int, int> other;
+	other.swap(copy);
+	long long sum = 0;
+	int prev = -1;
+	bool sorted = true;
+	for (ft::arena_map<int, int>::reverse_iterator it = other.rbegin(); it != other.rend(); ++it) {
+		sum += it->first * 3 + it->second;
+		if (prev != -1 && it->first >= prev)
+			sorted = false;
+		prev = it->first;
+	}
+	std::cout << first->first << " " << other.size() << " " << copy.size() << " " << sum << " "
+		<< sorted << " " << (other == m) << std::endl;
+}
+
+// btree_map stays ft too; enough keys for a three-level tree
+void map_test_btree_nodes() {
+	ft::btree_map<int, int> m;
+	for (int i = 0; i < 20000; ++i)
+		m[(i * 7919) % 20000] = i;
+	for (int i = 0; i < 20000; i += 3)
+		m.erase(i);
+	m.erase(m.lower_bound(5000), m.lower_bound(15000));
+	for (int i = 0; i < 4000; ++i)
+		m.insert(m.end(), ft::make_pair(20000 + i, -i));
+	ft::btree_map<int, int> copy(m);
+	long long sum = 0;
+	int prev = -1;
+	bool sorted = true;
+	for (ft::btree_map<int, int>::reverse_iterator it = copy.rbegin(); it != copy.rend(); ++it) {
+		sum += it->first * 3 + it->second;
+		if (prev != -1 && it->first >= prev)
+			sorted = false;
+		prev = it->first;
+	}
+	std::cout << copy.size() << " " << sum << " " << sorted << " " << (copy == m) << " "
+		<< m.lower_bound(5000)->first << " " << (m.find(3) == m.end()) << std::endl;
+	// erase hands back the successor, as the values behind it shift
+	for (ft::btree_map<int, int>::iterator it = m.begin(); it != m.end();) {
+		if (it->first % 2)
+			it = m.erase(it);
+		else
+			++it;
+	}
+	ft::btree_map<int, int>::iterator odd = m.begin();
+	while (odd != m.end() && odd->first % 2 == 0)
+		++odd;
+	std::cout << m.size() << " " << (odd == m.end()) << " " << m.begin()->first << std::endl;
+}
+
+// a key that counts its constructions, looked up by plain int
+static int tracked_built = 0;
+
+struct tracked_key {
+	int id;
+	tracked_key() : id(0) {}
+	tracked_key(int i) : id(i) {
+		++tracked_built;
+	}
+	tracked_key(const tracked_key& other) : id(other.id) {
+		++tracked_built;
+	}
+};
+
+struct tracked_less {
+	typedef void is_transparent;
+	bool operator()(const tracked_key& a, const tracked_key& b) const {
+		return a.id < b.id;
+	}
+	bool operator()(const tracked_key& a, int b) const {
+		return a.id < b;
+	}
+	bool operator()(int a, const tracked_key& b) const {
+		return a < b.id;
+	}
+};
+
+template <class M>
+void map_transparent_lookups(const M& m) {
+	int built = tracked_built;
+	unsigned long long sum = 0;
+	for (int k = -2; k < 205; ++k) {
+		typename M::const_iterator it = m.find(k);
+		sum = sum * 3 + (it == m.end() ? -1 : it->second);
+		sum += m.count(k);
+		typename M::const_iterator lo = m.lower_bound(k);
+		typename M::const_iterator hi = m.upper_bound(k);
+		sum = sum * 5 + (lo == m.end() ? -1 : lo->first.id) + (hi == m.end() ? -1 : hi->first.id);
+		sum += (m.equal_range(k).first == lo) + (m.equal_range(k).second == hi);
+	}
+	std::cout << sum << " " << tracked_built - built << std::endl;
+}
+
+void map_test_transparent() {
+	ft::map<tracked_key, int, tracked_less> m;
+	for (int i = 0; i < 200; i += 3)
+		m.insert(ft::pair<const tracked_key, int>(tracked_key(i), i * 2));
+	map_transparent_lookups(m);
+	ft::arena_map<tracked_key, int, tracked_less> arena;
+	ft::btree_map<tracked_key, int, tracked_less> btree;
+	for (int i = 0; i < 200; i += 3) {
+		arena.insert(ft::make_pair(tracked_key(i), i * 2));
+		btree.insert(ft::make_pair(tracked_key(i), i * 2));
+	}
+	map_transparent_lookups(arena);
+	map_transparent_lookups(btree);
+	ft::map<std::string, int, std::less<> > words;
+	words["pear"] = 1;
+	words["fig"] = 2;
+	words["apple"] = 3;
+	const char* probe = "fig";
+	std::cout << words.find(probe)->second << " " << words.count("kiwi") << " " << words.lower_bound("b")->first << std::endl;
+}
+
+// big enough for the copy to clone subtrees on several threads
+void map_test_copy_large() {
+	ft::map<int, int> m;
+	for (int i = 0; i < 200000; ++i)
+		m.insert(ft::pair<int, int>((i * 7919) % 200000, i));
+	ft::map<int, int> copy(m);
+	ft::map<int, int> assigned;
+	assigned[-1] = -1;
+	assigned = copy;
+	copy.erase(0);
+	long sum = 0;
+	for (ft::map<int, int>::iterator it = copy.begin(); it != copy.end(); ++it)
+		sum += it->first ^ it->second;
+	std::cout << m.size() << " " << copy.size() << " " << assigned.size() << " " << (assigned == m) << " "
+		<< (copy == m) << " " << sum << " " << copy.begin()->first << " " << assigned.rbegin()->first << std::endl;
+}
+
 int main() {
 	map_simple_test();
 	map_test_reverse_iterators();
@@ -428,4 +812,17 @@ int main() {
 	map_test_find();
 	map_test_element_access();
 	map_test_comp();
+	map_test_pool_allocator();
+	map_test_sorted_construct();
+	map_test_rank_select();
+	map_test_try_emplace();
+	map_test_algebra();
+	map_test_split_join();
+	map_test_erase_range();
+	map_test_node_handle();
+	map_test_compact_nodes();
+	map_test_arena_nodes();
+	map_test_btree_nodes();
+	map_test_transparent();
+	map_test_copy_large();
 }
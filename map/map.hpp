@@ -2,11 +2,12 @@
 #define FT_CONTAINERS_MAP_HPP
 
 #include <iostream>
-#include "../tree/rbtree.hpp"
+#include "../tree/tree_select.hpp"
 #include "get_first.hpp"
 
 namespace ft {
-	template <class Key, class T, class Compare = std::less<Key>, class Allocator = std::allocator<ft::pair<const Key, T> > >
+	template <class Key, class T, class Compare = std::less<Key>, class Allocator = std::allocator<ft::pair<const Key, T> >,
+		class NodePolicy = ft::plain_nodes>
 	class map {
 	public:
 
@@ -24,7 +25,7 @@ namespace ft {
 		typedef typename Allocator::pointer			pointer;
 		typedef typename Allocator::const_pointer	const_pointer;
 	private:
-		typedef rbTree<key_type, value_type, ft::get_first<value_type>, key_compare, allocator_type> tree;
+		typedef typename ft::tree_select<key_type, value_type, ft::get_first<value_type>, key_compare, allocator_type, NodePolicy>::type tree;
 		tree _tree;
 		allocator_type _allocator;
 	public:
@@ -32,6 +33,8 @@ namespace ft {
 		typedef typename tree::const_iterator const_iterator;
 		typedef typename tree::reverse_iterator reverse_iterator;
 		typedef typename tree::const_reverse_iterator const_reverse_iterator;
+		typedef typename tree::node_handle node_type;
+		typedef typename tree::insert_return_type insert_return_type;
 
 		// VALUE COMPARE CLASS
 
@@ -64,18 +67,22 @@ namespace ft {
 			_tree.insert(first, last);
 		}
 
+		template<class InputIterator>
+		map(ft::sorted_unique_t, InputIterator first, InputIterator last, const key_compare& comp = key_compare(),
+			const allocator_type& alloc = allocator_type()) : _tree(comp, alloc) {
+			_tree.insert(ft::sorted_unique, first, last);
+		}
+
 		map(const map& x) : _tree(x._tree) {}
 
 		// OPERATORS
 
 		map& operator=(const map& other) {
             _tree = other._tree;
+            return *this;
         }
 		mapped_type& operator[] (const key_type& k) {
-            iterator i = lower_bound(k);
-            if (i == end() || key_comp()(k, (*i).first))
-                i = insert(i, value_type(k, mapped_type()));
-            return (*i).second;
+            return (*_tree.try_emplace(k).first).second;
         }
 		// MEMBER FUNCTIONS
 		iterator begin() {
@@ -90,6 +97,15 @@ namespace ft {
 		size_type count(const key_type& k) const {
 			return _tree.count(k);
 		}
+		// with a transparent key_compare these also take any key it can compare
+		template<class K, class = typename ft::transparent_key<Compare, K>::type>
+		size_type count(const K& k) const {
+			return _tree.count(k);
+		}
+		// the range queries below need NodePolicy = ft::counted_nodes
+		size_type count_range(const key_type& lo, const key_type& hi) const {
+			return _tree.count_range(lo, hi);
+		}
 		bool empty() const {
 			return _tree.empty();
 		}
@@ -102,11 +118,21 @@ namespace ft {
 		ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
 			return _tree.equal_range(k);
 		}
+		template<class K, class = typename ft::transparent_key<Compare, K>::type>
+		ft::pair<const_iterator, const_iterator> equal_range(const K& k) const {
+			return _tree.equal_range(k);
+		}
 		ft::pair<iterator, iterator> equal_range(const key_type& k) {
 			return _tree.equal_range(k);
 		}
-		void erase(iterator position) {
-            _tree.erase(position);
+		template<class K, class = typename ft::transparent_key<Compare, K>::type>
+		ft::pair<iterator, iterator> equal_range(const K& k) {
+			return _tree.equal_range(k);
+		}
+		// the next element: with btree_nodes the erase moves its
+		// neighbours, so m.erase(it++) is not safe but it = m.erase(it) is
+		iterator erase(iterator position) {
+            return _tree.erase(position);
         }
 		size_type erase(const key_type& k) {
             return _tree.erase(k);
@@ -114,12 +140,26 @@ namespace ft {
 		void erase(iterator first, iterator last) {
             _tree.erase(first, last);
         }
+		node_type extract(const_iterator position) {
+			return _tree.extract(position);
+		}
+		node_type extract(const key_type& k) {
+			return _tree.extract(k);
+		}
 		iterator find(const key_type& k) {
 			return _tree.find(k);
 		}
+		template<class K, class = typename ft::transparent_key<Compare, K>::type>
+		iterator find(const K& k) {
+			return _tree.find(k);
+		}
 		const_iterator find(const key_type& k) const {
 			return _tree.find(k);
 		}
+		template<class K, class = typename ft::transparent_key<Compare, K>::type>
+		const_iterator find(const K& k) const {
+			return _tree.find(k);
+		}
 		allocator_type get_allocator() const {
 			return _tree.get_allocator();
 		}
@@ -133,18 +173,48 @@ namespace ft {
 		void insert(InputIterator first, InputIterator last) {
 			_tree.insert(first, last);
 		}
+		insert_return_type insert(node_type&& nh) {
+			return _tree.insert(std::move(nh));
+		}
+		iterator insert(const_iterator position, node_type&& nh) {
+			return _tree.insert(position, std::move(nh));
+		}
+		template<class M>
+		ft::pair<iterator, bool> insert_or_assign(const key_type& k, M&& obj) {
+			return _tree.insert_or_assign(k, std::forward<M>(obj));
+		}
+		// appends right, whose keys must all be greater, and empties it;
+		// throws std::invalid_argument when the ranges overlap
+		void join(map& right) {
+			_tree.join(right._tree);
+		}
 		key_compare key_comp() const {
             return _tree.key_comp();
         }
 		iterator lower_bound(const key_type& k) {
 			return _tree.lower_bound(k);
 		}
+		template<class K, class = typename ft::transparent_key<Compare, K>::type>
+		iterator lower_bound(const K& k) {
+			return _tree.lower_bound(k);
+		}
 		const_iterator lower_bound(const key_type& k) const {
 			return _tree.lower_bound(k);
 		}
+		template<class K, class = typename ft::transparent_key<Compare, K>::type>
+		const_iterator lower_bound(const K& k) const {
+			return _tree.lower_bound(k);
+		}
+		// takes over the elements of source whose keys are missing here
+		void merge(map& source) {
+			_tree.merge(source._tree);
+		}
 		size_type max_size() const {
 			return _allocator.max_size();
 		}
+		size_type rank(const key_type& k) const {
+			return _tree.rank(k);
+		}
 		reverse_iterator rbegin() {
 			return _tree.rbegin();
 		}
@@ -157,55 +227,132 @@ namespace ft {
 		const_reverse_iterator rend() const {
 			return _tree.rend();
 		}
+		iterator select(size_type i) {
+			return _tree.select(i);
+		}
+		const_iterator select(size_type i) const {
+			return _tree.select(i);
+		}
 		size_type size() const {
 			return _tree.size();
 		}
+		// keeps the keys less than k and moves the rest into upper: O(log n)
+		// with counted_nodes (ranked_map), otherwise also linear in the
+		// smaller half, whose size has to be recounted
+		void split(const key_type& k, map& upper) {
+			_tree.split(k, upper._tree);
+		}
 		void swap(map& x) {
 			_tree.swap(x._tree);
         }
+		template<class... Args>
+		ft::pair<iterator, bool> try_emplace(const key_type& k, Args&&... args) {
+			return _tree.try_emplace(k, std::forward<Args>(args)...);
+		}
 		iterator upper_bound(const key_type& k) {
 			return _tree.upper_bound(k);
 		}
+		template<class K, class = typename ft::transparent_key<Compare, K>::type>
+		iterator upper_bound(const K& k) {
+			return _tree.upper_bound(k);
+		}
 		const_iterator upper_bound(const key_type& k) const {
 			return _tree.upper_bound(k);
 		}
+		template<class K, class = typename ft::transparent_key<Compare, K>::type>
+		const_iterator upper_bound(const K& k) const {
+			return _tree.upper_bound(k);
+		}
 		value_compare value_comp() const {
             return value_compare(_tree.key_comp());
         }
-		template<typename K, typename T1, typename Comp, typename Alloc>
-        friend bool operator==(const map<K, T1, Comp, Alloc>& x, const map<K, T1, Comp, Alloc>& y);
-        template<typename K, typename T1, typename Comp, typename Alloc>
-        friend bool operator<(const map<K, T1, Comp, Alloc>& x, const map<K, T1, Comp, Alloc>& y);
+		template<typename K, typename T1, typename Comp, typename Alloc, typename NP>
+        friend bool operator==(const map<K, T1, Comp, Alloc, NP>& x, const map<K, T1, Comp, Alloc, NP>& y);
+        template<typename K, typename T1, typename Comp, typename Alloc, typename NP>
+        friend bool operator<(const map<K, T1, Comp, Alloc, NP>& x, const map<K, T1, Comp, Alloc, NP>& y);
+		template<typename K, typename T1, typename Comp, typename Alloc, typename NP>
+		friend map<K, T1, Comp, Alloc, NP> set_difference(const map<K, T1, Comp, Alloc, NP>& x, const map<K, T1, Comp, Alloc, NP>& y);
+		template<typename K, typename T1, typename Comp, typename Alloc, typename NP>
+		friend map<K, T1, Comp, Alloc, NP> set_intersection(const map<K, T1, Comp, Alloc, NP>& x, const map<K, T1, Comp, Alloc, NP>& y);
+		template<typename K, typename T1, typename Comp, typename Alloc, typename NP>
+		friend map<K, T1, Comp, Alloc, NP> set_symmetric_difference(const map<K, T1, Comp, Alloc, NP>& x, const map<K, T1, Comp, Alloc, NP>& y);
+		template<typename K, typename T1, typename Comp, typename Alloc, typename NP>
+		friend map<K, T1, Comp, Alloc, NP> set_union(const map<K, T1, Comp, Alloc, NP>& x, const map<K, T1, Comp, Alloc, NP>& y);
 	};
 
-    template<typename K, typename T1, typename Comp, typename Alloc>
-    inline bool operator==(const map<K, T1, Comp, Alloc> &x, const map<K, T1, Comp, Alloc> &y) {
+    template<typename K, typename T1, typename Comp, typename Alloc, typename NP>
+    inline bool operator==(const map<K, T1, Comp, Alloc, NP> &x, const map<K, T1, Comp, Alloc, NP> &y) {
         return x._tree == y._tree;
     }
-    template<typename K, typename T1, typename Comp, typename Alloc>
-    inline bool operator!=(const map<K, T1, Comp, Alloc> &x, const map<K, T1, Comp, Alloc> &y) {
+    template<typename K, typename T1, typename Comp, typename Alloc, typename NP>
+    inline bool operator!=(const map<K, T1, Comp, Alloc, NP> &x, const map<K, T1, Comp, Alloc, NP> &y) {
         return !(x == y);
     }
-    template<typename K, typename T1, typename Comp, typename Alloc>
-    inline bool operator<(const map<K, T1, Comp, Alloc> &x, const map<K, T1, Comp, Alloc> &y) {
+    template<typename K, typename T1, typename Comp, typename Alloc, typename NP>
+    inline bool operator<(const map<K, T1, Comp, Alloc, NP> &x, const map<K, T1, Comp, Alloc, NP> &y) {
         return x._tree < y._tree;
     }
-    template<typename K, typename T1, typename Comp, typename Alloc>
-    inline bool operator>(const map<K, T1, Comp, Alloc> &x, const map<K, T1, Comp, Alloc> &y) {
+    template<typename K, typename T1, typename Comp, typename Alloc, typename NP>
+    inline bool operator>(const map<K, T1, Comp, Alloc, NP> &x, const map<K, T1, Comp, Alloc, NP> &y) {
         return y < x;
     }
-    template<typename K, typename T1, typename Comp, typename Alloc>
-    inline bool operator<=(const map<K, T1, Comp, Alloc> &x, const map<K, T1, Comp, Alloc> &y) {
+    template<typename K, typename T1, typename Comp, typename Alloc, typename NP>
+    inline bool operator<=(const map<K, T1, Comp, Alloc, NP> &x, const map<K, T1, Comp, Alloc, NP> &y) {
         return !(y < x);
     }
-    template<typename K, typename T1, typename Comp, typename Alloc>
-    inline bool operator>=(const map<K, T1, Comp, Alloc> &x, const map<K, T1, Comp, Alloc> &y) {
+    template<typename K, typename T1, typename Comp, typename Alloc, typename NP>
+    inline bool operator>=(const map<K, T1, Comp, Alloc, NP> &x, const map<K, T1, Comp, Alloc, NP> &y) {
         return !(x < y);
     }
-    template<typename K, typename T1, typename Comp, typename Alloc>
-    inline void swap(const map<K, T1, Comp, Alloc> &x, const map<K, T1, Comp, Alloc> &y) {
+    template<typename K, typename T1, typename Comp, typename Alloc, typename NP>
+    inline void swap(map<K, T1, Comp, Alloc, NP> &x, map<K, T1, Comp, Alloc, NP> &y) {
         x.swap(y);
     }
+
+	// Linear set algebra: both sides are walked in order and the result is
+	// linked into a balanced tree; keys present in both take x's value.
+	template<typename K, typename T1, typename Comp, typename Alloc, typename NP>
+	inline map<K, T1, Comp, Alloc, NP> set_difference(const map<K, T1, Comp, Alloc, NP>& x, const map<K, T1, Comp, Alloc, NP>& y) {
+		map<K, T1, Comp, Alloc, NP> res(x.key_comp());
+		res._tree.assign_difference(x._tree, y._tree);
+		return res;
+	}
+	template<typename K, typename T1, typename Comp, typename Alloc, typename NP>
+	inline map<K, T1, Comp, Alloc, NP> set_intersection(const map<K, T1, Comp, Alloc, NP>& x, const map<K, T1, Comp, Alloc, NP>& y) {
+		map<K, T1, Comp, Alloc, NP> res(x.key_comp());
+		res._tree.assign_intersection(x._tree, y._tree);
+		return res;
+	}
+	template<typename K, typename T1, typename Comp, typename Alloc, typename NP>
+	inline map<K, T1, Comp, Alloc, NP> set_symmetric_difference(const map<K, T1, Comp, Alloc, NP>& x, const map<K, T1, Comp, Alloc, NP>& y) {
+		map<K, T1, Comp, Alloc, NP> res(x.key_comp());
+		res._tree.assign_symmetric_difference(x._tree, y._tree);
+		return res;
+	}
+	template<typename K, typename T1, typename Comp, typename Alloc, typename NP>
+	inline map<K, T1, Comp, Alloc, NP> set_union(const map<K, T1, Comp, Alloc, NP>& x, const map<K, T1, Comp, Alloc, NP>& y) {
+		map<K, T1, Comp, Alloc, NP> res(x.key_comp());
+		res._tree.assign_union(x._tree, y._tree);
+		return res;
+	}
+
+	// map that also answers rank, select and count_range in O(log n)
+	template <class Key, class T, class Compare = std::less<Key>, class Allocator = std::allocator<ft::pair<const Key, T> > >
+	using ranked_map = map<Key, T, Compare, Allocator, ft::counted_nodes>;
+
+	// map whose nodes keep the colour in the parent pointer: 8 bytes less each
+	template <class Key, class T, class Compare = std::less<Key>, class Allocator = std::allocator<ft::pair<const Key, T> > >
+	using compact_map = map<Key, T, Compare, Allocator, ft::compact_nodes>;
+
+	// map on arenaTree: nodes in one buffer, linked by 32-bit index; no
+	// node handles, split/join, set algebra or rank queries
+	template <class Key, class T, class Compare = std::less<Key>, class Allocator = std::allocator<ft::pair<const Key, T> > >
+	using arena_map = map<Key, T, Compare, Allocator, ft::arena_nodes>;
+
+	// map on a B+-tree with 256-byte nodes: far fewer cache misses per lookup
+	// on large trees, but insert and erase invalidate other iterators
+	template <class Key, class T, class Compare = std::less<Key>, class Allocator = std::allocator<ft::pair<const Key, T> > >
+	using btree_map = map<Key, T, Compare, Allocator, ft::btree_nodes<> >;
 }
 
 #endif
\ No newline at end of file
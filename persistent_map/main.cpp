@@ -0,0 +1,130 @@
+#include "persistent_map.hpp"
+#include "../vector/vector.hpp"
+#include <map>
+#include <vector>
+
+template <class M>
+void print_map(const M &v)
+{
+	typename M::const_iterator begin = v.begin();
+	typename M::const_iterator end = v.end();
+	std::cout << "size=\t\t" << v.size() << std::endl;
+	for (; begin != end; begin++)
+		std::cout << "\033[38;5;46m" << begin->first << "->" << begin->second << "\033[0m ";
+	std::cout << std::endl;
+}
+
+void map_test_construct() {
+	ft::vector<ft::pair<int, std::string> > v;
+	v.push_back(ft::pair<int, std::string>(5, "five"));
+	v.push_back(ft::pair<int, std::string>(1, "one"));
+	v.push_back(ft::pair<int, std::string>(3, "three"));
+	v.push_back(ft::pair<int, std::string>(5, "cinq"));
+	ft::persistent_map<int, std::string> one(v.begin(), v.end());
+	print_map(one);
+	ft::persistent_map<int, std::string> two(one);
+	ft::persistent_map<int, std::string> three;
+	print_map(three);
+	three = two;
+	print_map(three);
+	std::cout << (one == three) << " " << three.empty() << " " << one.count(5) << one.count(4) << std::endl;
+}
+
+void map_test_modify() {
+	ft::persistent_map<int, int> m;
+	for (int i = 0; i < 1000; ++i) {
+		ft::pair<ft::persistent_map<int, int>::const_iterator, bool> res = m.insert(ft::pair<const int, int>((i * 37) % 1000, i));
+		if (!res.second || res.first->second != i)
+			std::cout << "insert " << i << std::endl;
+	}
+	std::cout << m.insert(ft::pair<const int, int>(7, 0)).second << " " << m.at(7) << std::endl;
+	std::cout << m.insert_or_assign(7, -7).second << " " << m.insert_or_assign(1000, 1000).second << " " << m.at(7) << std::endl;
+	for (int i = 0; i < 1000; i += 3)
+		m.erase(i);
+	std::cout << m.erase(3) << " " << m.erase(4) << " " << m.size() << std::endl;
+	m.erase(m.find(500));
+	m.erase(m.begin());
+	long long sum = 0;
+	for (ft::persistent_map<int, int>::const_reverse_iterator it = m.rbegin(); it != m.rend(); ++it)
+		sum = sum * 7 % 1000000007 + it->first * 3 + it->second;
+	std::cout << m.size() << " " << sum << " " << m.begin()->first << " " << m.rbegin()->first << std::endl;
+	try {
+		m.at(3);
+	}
+	catch (std::out_of_range&) {
+		std::cout << "out of range" << std::endl;
+	}
+	m.clear();
+	std::cout << m.size() << " " << (m.begin() == m.end()) << std::endl;
+}
+
+// copies must not see later writes to either side
+void map_test_copies() {
+	ft::persistent_map<int, int> m;
+	for (int i = 0; i < 200; ++i)
+		m.insert(ft::pair<const int, int>(i, i));
+	std::vector<ft::persistent_map<int, int> > versions;
+	for (int round = 0; round < 5; ++round) {
+		versions.push_back(m);
+		for (int i = round; i < 200; i += 5)
+			m.erase(i);
+		for (int i = 0; i < 40; ++i)
+			m.insert_or_assign(200 + round * 40 + i, round);
+		m.insert_or_assign(round * 5 + 1, -round);
+	}
+	versions[2].insert_or_assign(-1, -1);
+	versions[3].clear();
+	for (std::size_t v = 0; v < versions.size(); ++v) {
+		long long sum = 0;
+		for (ft::persistent_map<int, int>::const_iterator it = versions[v].begin(); it != versions[v].end(); ++it)
+			sum += it->first * 1000 + it->second;
+		std::cout << v << ": " << versions[v].size() << " " << sum << std::endl;
+	}
+	print_map(versions[4]);
+	print_map(m);
+}
+
+void map_test_bounds() {
+	ft::persistent_map<int, char> m;
+	for (int i = 0; i < 26; ++i)
+		m.insert(ft::pair<const int, char>(i * 4, 'a' + i));
+	const ft::persistent_map<int, char> c(m);
+	for (int k = -2; k < 110; k += 3) {
+		ft::persistent_map<int, char>::const_iterator lo = c.lower_bound(k);
+		ft::persistent_map<int, char>::const_iterator hi = c.upper_bound(k);
+		std::cout << (lo == c.end() ? '.' : lo->second) << (hi == c.end() ? '.' : hi->second)
+			<< (c.find(k) == c.end()) << (c.equal_range(k).second == hi) << " ";
+	}
+	std::cout << std::endl;
+	ft::persistent_map<int, char>::const_iterator it = c.end();
+	--it;
+	std::cout << it->first << " ";
+	it--;
+	std::cout << it->first << " " << (++it)->first << " " << (++it == c.end()) << std::endl;
+}
+
+void map_test_compare() {
+	ft::persistent_map<char, int> x;
+	ft::persistent_map<char, int> y;
+	for (int i = 0; i < 4; ++i) {
+		x.insert(ft::pair<const char, int>('a' + i, i));
+		y.insert(ft::pair<const char, int>('a' + i, i == 3 ? 9 : i));
+	}
+	std::cout << (x < y) << (y < x) << (x == y) << (x != y) << (x <= y) << (x >= y) << std::endl;
+	ft::persistent_map<char, int> z(x);
+	std::cout << (z == x) << " ";
+	z.insert_or_assign('a', 0);
+	std::cout << (z == x) << std::endl;
+	x.swap(y);
+	print_map(x);
+	print_map(y);
+	std::cout << x.value_comp()(*x.begin(), *y.rbegin()) << std::endl;
+}
+
+int main() {
+	map_test_construct();
+	map_test_modify();
+	map_test_copies();
+	map_test_bounds();
+	map_test_compare();
+}
@@ -0,0 +1,222 @@
+#ifndef PERSISTENT_MAP_HPP
+#define PERSISTENT_MAP_HPP
+
+#include <iostream>
+#include <stdexcept>
+#include "../tree/persistent_tree.hpp"
+#include "../map/get_first.hpp"
+#include "../utility/algorithm.hpp"
+#include "../utility/type_traits.hpp"
+
+namespace ft {
+	// Map with O(1) copies. A copy (or snapshot()) shares every node with
+	// the map it came from; later writes to either side copy only the
+	// O(log n) nodes on their path, so a snapshot stays a consistent,
+	// unchanging view that other threads can read while the original
+	// keeps taking writes. Elements are read-only through iterators, and
+	// a write invalidates this map's iterators, not a snapshot's.
+	template <class Key, class T, class Compare = std::less<Key>, class Allocator = std::allocator<ft::pair<const Key, T> > >
+	class persistent_map {
+	public:
+
+		// DEF
+
+		typedef Key									key_type;
+		typedef T									mapped_type;
+		typedef ft::pair<const Key, T>				value_type;
+		typedef std::size_t							size_type;
+		typedef std::ptrdiff_t						difference_type;
+		typedef Compare								key_compare;
+		typedef Allocator							allocator_type;
+		typedef const value_type&					reference;
+		typedef const value_type&					const_reference;
+		typedef typename Allocator::const_pointer	pointer;
+		typedef typename Allocator::const_pointer	const_pointer;
+	private:
+		typedef persistentTree<key_type, value_type, ft::get_first<value_type>, key_compare, allocator_type> tree;
+		tree _tree;
+	public:
+		typedef typename tree::iterator iterator;
+		typedef typename tree::const_iterator const_iterator;
+		typedef typename tree::reverse_iterator reverse_iterator;
+		typedef typename tree::const_reverse_iterator const_reverse_iterator;
+
+		// VALUE COMPARE CLASS
+
+		class value_compare {
+			friend class persistent_map;
+		public:
+			typedef bool result_type;
+			typedef value_type first_argument_type;
+			typedef value_type second_argument_type;
+
+			bool operator()(const value_type& lhs, const value_type& rhs) const {
+				return comp(lhs.first, rhs.first);
+			}
+
+		protected:
+			Compare comp;
+			value_compare(Compare c) : comp(c) {}
+		};
+
+		// CONSTRUCTORS + DESTRUCTOR
+
+		explicit persistent_map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) :
+			_tree(comp, alloc) {}
+
+		template<class InputIterator>
+		persistent_map(InputIterator first, InputIterator last, const key_compare& comp = key_compare(),
+			const allocator_type& alloc = allocator_type()) : _tree(comp, alloc) {
+			_tree.insert(first, last);
+		}
+
+		// O(1): shares x's nodes
+		persistent_map(const persistent_map& x) : _tree(x._tree) {}
+
+		// OPERATORS
+
+		persistent_map& operator=(const persistent_map& other) {
+			_tree = other._tree;
+			return *this;
+		}
+
+		// MEMBER FUNCTIONS
+
+		const mapped_type& at(const key_type& k) const {
+			const_iterator it = _tree.find(k);
+			if (it == _tree.end())
+				throw std::out_of_range("persistent_map::at");
+			return it->second;
+		}
+		const_iterator begin() const {
+			return _tree.begin();
+		}
+		void clear() {
+			_tree.clear();
+		}
+		size_type count(const key_type& k) const {
+			return _tree.count(k);
+		}
+		template<class K, class = typename ft::transparent_key<Compare, K>::type>
+		size_type count(const K& k) const {
+			return _tree.count(k);
+		}
+		bool empty() const {
+			return _tree.empty();
+		}
+		const_iterator end() const {
+			return _tree.end();
+		}
+		ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+			return _tree.equal_range(k);
+		}
+		template<class K, class = typename ft::transparent_key<Compare, K>::type>
+		ft::pair<const_iterator, const_iterator> equal_range(const K& k) const {
+			return _tree.equal_range(k);
+		}
+		// the key is copied first: erasing may free the node it lives in
+		void erase(const_iterator position) {
+			key_type k = position->first;
+			_tree.erase(k);
+		}
+		size_type erase(const key_type& k) {
+			return _tree.erase(k);
+		}
+		const_iterator find(const key_type& k) const {
+			return _tree.find(k);
+		}
+		template<class K, class = typename ft::transparent_key<Compare, K>::type>
+		const_iterator find(const K& k) const {
+			return _tree.find(k);
+		}
+		allocator_type get_allocator() const {
+			return _tree.get_allocator();
+		}
+		ft::pair<const_iterator, bool> insert(const value_type& val) {
+			return _tree.insert(val);
+		}
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last) {
+			_tree.insert(first, last);
+		}
+		template<class M>
+		ft::pair<const_iterator, bool> insert_or_assign(const key_type& k, M&& obj) {
+			return _tree.insert_or_assign(k, std::forward<M>(obj));
+		}
+		key_compare key_comp() const {
+			return _tree.key_comp();
+		}
+		const_iterator lower_bound(const key_type& k) const {
+			return _tree.lower_bound(k);
+		}
+		template<class K, class = typename ft::transparent_key<Compare, K>::type>
+		const_iterator lower_bound(const K& k) const {
+			return _tree.lower_bound(k);
+		}
+		size_type max_size() const {
+			return _tree.max_size();
+		}
+		const_reverse_iterator rbegin() const {
+			return _tree.rbegin();
+		}
+		const_reverse_iterator rend() const {
+			return _tree.rend();
+		}
+		// true while neither map has been written since one was copied
+		// from the other
+		bool shares(const persistent_map& other) const {
+			return _tree.shares(other._tree);
+		}
+		size_type size() const {
+			return _tree.size();
+		}
+		// the same as a copy; named for readers handed a view
+		persistent_map snapshot() const {
+			return *this;
+		}
+		void swap(persistent_map& x) {
+			_tree.swap(x._tree);
+		}
+		const_iterator upper_bound(const key_type& k) const {
+			return _tree.upper_bound(k);
+		}
+		template<class K, class = typename ft::transparent_key<Compare, K>::type>
+		const_iterator upper_bound(const K& k) const {
+			return _tree.upper_bound(k);
+		}
+		value_compare value_comp() const {
+			return value_compare(_tree.key_comp());
+		}
+	};
+
+	template<typename K, typename T1, typename Comp, typename Alloc>
+	inline bool operator==(const persistent_map<K, T1, Comp, Alloc> &x, const persistent_map<K, T1, Comp, Alloc> &y) {
+		return x.shares(y) || (x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin()));
+	}
+	template<typename K, typename T1, typename Comp, typename Alloc>
+	inline bool operator!=(const persistent_map<K, T1, Comp, Alloc> &x, const persistent_map<K, T1, Comp, Alloc> &y) {
+		return !(x == y);
+	}
+	template<typename K, typename T1, typename Comp, typename Alloc>
+	inline bool operator<(const persistent_map<K, T1, Comp, Alloc> &x, const persistent_map<K, T1, Comp, Alloc> &y) {
+		return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+	}
+	template<typename K, typename T1, typename Comp, typename Alloc>
+	inline bool operator>(const persistent_map<K, T1, Comp, Alloc> &x, const persistent_map<K, T1, Comp, Alloc> &y) {
+		return y < x;
+	}
+	template<typename K, typename T1, typename Comp, typename Alloc>
+	inline bool operator<=(const persistent_map<K, T1, Comp, Alloc> &x, const persistent_map<K, T1, Comp, Alloc> &y) {
+		return !(y < x);
+	}
+	template<typename K, typename T1, typename Comp, typename Alloc>
+	inline bool operator>=(const persistent_map<K, T1, Comp, Alloc> &x, const persistent_map<K, T1, Comp, Alloc> &y) {
+		return !(x < y);
+	}
+	template<typename K, typename T1, typename Comp, typename Alloc>
+	inline void swap(persistent_map<K, T1, Comp, Alloc> &x, persistent_map<K, T1, Comp, Alloc> &y) {
+		x.swap(y);
+	}
+}
+
+#endif
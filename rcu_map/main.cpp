@@ -0,0 +1,108 @@
+#include "rcu_map.hpp"
+#include <map>
+#include <thread>
+
+template <class R>
+void print_map(const R &v)
+{
+	typename R::const_iterator begin = v.begin();
+	typename R::const_iterator end = v.end();
+	std::cout << "size=\t\t" << v.size() << std::endl;
+	for (; begin != end; begin++)
+		std::cout << "\033[38;5;46m" << begin->first << "->" << begin->second << "\033[0m ";
+	std::cout << std::endl;
+}
+
+void map_test_publish() {
+	ft::pair<int, std::string> init[] = {
+		ft::pair<int, std::string>(2, "two"), ft::pair<int, std::string>(1, "one"), ft::pair<int, std::string>(3, "three")
+	};
+	ft::rcu_map<int, std::string> m(init, init + 3);
+	ft::rcu_map<int, std::string>::reader before(m);
+	m.insert_or_assign(2, "deux");
+	m.insert(ft::pair<const int, std::string>(4, "four"));
+	m.erase(1);
+	std::cout << m.size() << " " << m.count(4) << " " << m.at(2) << std::endl;
+	ft::persistent_map<int, std::string> old = m.snapshot();
+	m.publish();
+	ft::rcu_map<int, std::string>::reader after(m);
+	print_map(before);
+	print_map(after);
+	print_map(old);
+	std::cout << m.size() << " " << m.count(4) << " " << m.at(2) << " " << after.find(3)->second << " "
+		<< (after.lower_bound(5) == after.end()) << std::endl;
+	try {
+		m.at(1);
+	}
+	catch (std::out_of_range&) {
+		std::cout << "out of range" << std::endl;
+	}
+	m.clear();
+	m.publish();
+	std::cout << m.size() << " " << after.size() << std::endl;
+}
+
+// every batch keeps the values summing to zero; readers must never see half a batch
+void map_test_readers() {
+	ft::rcu_map<int, long> m;
+	std::map<int, long> expect;
+	std::atomic<bool> stop(false);
+	std::atomic<int> torn(0);
+	std::atomic<long> reads(0);
+	ft::vector<std::thread*> readers;
+	for (int t = 0; t < 4; ++t) {
+		readers.push_back(new std::thread([&m, &stop, &torn, &reads]() {
+			long last = 0;
+			while (!stop.load()) {
+				ft::rcu_map<int, long>::reader r(m);
+				long sum = 0;
+				for (ft::rcu_map<int, long>::const_iterator it = r.begin(); it != r.end(); ++it)
+					sum += it->second;
+				long gen = r.count(-1) ? r.at(-1) : 0;
+				if (sum != 0 || gen < last)
+					++torn;
+				last = gen;
+				++reads;
+			}
+		}));
+	}
+	for (long gen = 1; gen <= 2000; ++gen) {
+		int k = static_cast<int>(gen * 7919 % 997);
+		long v = (gen % 3 == 0) ? 0 : gen;
+		std::map<int, long>::iterator a = expect.find(k);
+		std::map<int, long>::iterator b = expect.find(k + 1000);
+		long shift = (a == expect.end() ? 0 : a->second) + (b == expect.end() ? 0 : b->second);
+		m.insert_or_assign(k, v);
+		m.insert_or_assign(k + 1000, -v + shift);
+		expect[k] = v;
+		expect[k + 1000] = -v + shift;
+		if (gen % 5 == 0) {
+			long d = expect.count(k + 1000) ? expect[k + 1000] : 0;
+			m.erase(k + 1000);
+			expect.erase(k + 1000);
+			m.insert_or_assign(k + 2000, d);
+			expect[k + 2000] = d;
+		}
+		m.insert_or_assign(-1, gen);
+		m.insert_or_assign(-2, -gen);
+		expect[-1] = gen;
+		expect[-2] = -gen;
+		m.publish();
+	}
+	stop.store(true);
+	for (std::size_t t = 0; t < readers.size(); ++t) {
+		readers[t]->join();
+		delete readers[t];
+	}
+	ft::rcu_map<int, long>::reader r(m);
+	bool same = r.size() == expect.size();
+	std::map<int, long>::iterator e = expect.begin();
+	for (ft::rcu_map<int, long>::const_iterator it = r.begin(); same && it != r.end(); ++it, ++e)
+		same = it->first == e->first && it->second == e->second;
+	std::cout << "torn " << torn.load() << " same " << same << " size " << r.size() << " read " << (reads.load() > 0) << std::endl;
+}
+
+int main() {
+	map_test_publish();
+	map_test_readers();
+}
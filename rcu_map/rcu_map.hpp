@@ -0,0 +1,206 @@
+#ifndef RCU_MAP_HPP
+#define RCU_MAP_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include "../persistent_map/persistent_map.hpp"
+#include "../utility/epoch.hpp"
+#include "../vector/vector.hpp"
+
+namespace ft {
+	// Ordered map for many reader threads and few writes. Readers take a
+	// reader, which pins the latest published version without a lock and
+	// reads it like a const persistent_map. Writes go to a private draft
+	// and become visible together, with one atomic pointer swap, on
+	// publish(); versions share all untouched nodes, so publishing a batch
+	// of b writes costs O(b log n), and a version is freed once no reader
+	// can still be on it. Writers are serialized by a mutex that readers
+	// never touch.
+	template <class Key, class T, class Compare = std::less<Key>, class Allocator = std::allocator<ft::pair<const Key, T> > >
+	class rcu_map {
+	public:
+
+		// DEF
+
+		typedef persistent_map<Key, T, Compare, Allocator>	map_type;
+		typedef Key											key_type;
+		typedef T											mapped_type;
+		typedef typename map_type::value_type				value_type;
+		typedef std::size_t									size_type;
+		typedef Compare										key_compare;
+		typedef Allocator									allocator_type;
+		typedef typename map_type::const_iterator			const_iterator;
+		typedef typename map_type::const_reverse_iterator	const_reverse_iterator;
+
+		// READER CLASS
+
+		// Pins the version published last when it was made; iterators and
+		// references it hands out are good until it is destroyed.
+		class reader {
+		public:
+			typedef typename rcu_map::const_iterator			const_iterator;
+			typedef typename rcu_map::const_reverse_iterator	const_reverse_iterator;
+
+			explicit reader(const rcu_map& m) : _guard(m._domain), _version(m._current.load(std::memory_order_seq_cst)) {}
+
+			const mapped_type& at(const key_type& k) const {
+				return _version->at(k);
+			}
+			const_iterator begin() const {
+				return _version->begin();
+			}
+			size_type count(const key_type& k) const {
+				return _version->count(k);
+			}
+			bool empty() const {
+				return _version->empty();
+			}
+			const_iterator end() const {
+				return _version->end();
+			}
+			ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+				return _version->equal_range(k);
+			}
+			const_iterator find(const key_type& k) const {
+				return _version->find(k);
+			}
+			const_iterator lower_bound(const key_type& k) const {
+				return _version->lower_bound(k);
+			}
+			const_reverse_iterator rbegin() const {
+				return _version->rbegin();
+			}
+			const_reverse_iterator rend() const {
+				return _version->rend();
+			}
+			size_type size() const {
+				return _version->size();
+			}
+			const_iterator upper_bound(const key_type& k) const {
+				return _version->upper_bound(k);
+			}
+			const map_type& view() const {
+				return *_version;
+			}
+		private:
+			reader(const reader&);
+			reader& operator=(const reader&);
+
+			epoch_domain::guard	_guard;
+			const map_type*		_version;
+		};
+
+		// CONSTRUCTORS + DESTRUCTOR
+
+		explicit rcu_map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) :
+			_current(new map_type(comp, alloc)), _draft(comp, alloc) {}
+
+		template<class InputIterator>
+		rcu_map(InputIterator first, InputIterator last, const key_compare& comp = key_compare(),
+			const allocator_type& alloc = allocator_type()) : _current(0), _draft(first, last, comp, alloc) {
+			_current.store(new map_type(_draft), std::memory_order_relaxed);
+		}
+
+		// no reader may be left
+		~rcu_map() {
+			delete _current.load(std::memory_order_relaxed);
+			for (size_type i = 0; i < _retired.size(); ++i)
+				delete _retired[i].version;
+		}
+
+		// MEMBER FUNCTIONS
+
+		// one-off reads, each on the version published last
+		mapped_type at(const key_type& k) const {
+			reader r(*this);
+			return r.at(k);
+		}
+		size_type count(const key_type& k) const {
+			reader r(*this);
+			return r.count(k);
+		}
+		size_type size() const {
+			reader r(*this);
+			return r.size();
+		}
+		// the published version as a map of its own, kept after the reader is gone
+		map_type snapshot() const {
+			reader r(*this);
+			return r.view();
+		}
+
+		// writes to the draft; readers see none of them before publish()
+		void clear() {
+			std::lock_guard<std::mutex> lock(_write);
+			_draft.clear();
+		}
+		size_type erase(const key_type& k) {
+			std::lock_guard<std::mutex> lock(_write);
+			return _draft.erase(k);
+		}
+		bool insert(const value_type& val) {
+			std::lock_guard<std::mutex> lock(_write);
+			return _draft.insert(val).second;
+		}
+		template<class M>
+		bool insert_or_assign(const key_type& k, M&& obj) {
+			std::lock_guard<std::mutex> lock(_write);
+			return _draft.insert_or_assign(k, std::forward<M>(obj)).second;
+		}
+		// makes the draft the version new readers get, then frees the
+		// versions no reader is left on
+		void publish() {
+			std::lock_guard<std::mutex> lock(_write);
+			map_type* next = new map_type(_draft);
+			map_type* old = _current.exchange(next, std::memory_order_seq_cst);
+			retired r;
+			r.version = old;
+			r.epoch = _domain.advance();
+			try {
+				_retired.push_back(r);
+			}
+			catch (...) {
+				_retire_now(r);
+				throw;
+			}
+			_reclaim();
+		}
+	private:
+		struct retired {
+			map_type*		version;
+			std::uint64_t	epoch;
+		};
+
+		mutable epoch_domain		_domain;
+		std::atomic<map_type*>		_current;
+		map_type					_draft;
+		ft::vector<retired>			_retired;
+		std::mutex					_write;
+
+		rcu_map(const rcu_map&);
+		rcu_map& operator=(const rcu_map&);
+
+		void _reclaim() {
+			std::uint64_t oldest = _domain.oldest();
+			size_type kept = 0;
+			for (size_type i = 0; i < _retired.size(); ++i) {
+				if (_retired[i].epoch <= oldest)
+					delete _retired[i].version;
+				else
+					_retired[kept++] = _retired[i];
+			}
+			while (_retired.size() > kept)
+				_retired.pop_back();
+		}
+		// last resort when the retired list cannot grow: wait out the readers
+		void _retire_now(const retired& r) {
+			while (_domain.oldest() < r.epoch)
+				std::this_thread::yield();
+			delete r.version;
+		}
+	};
+}
+
+#endif
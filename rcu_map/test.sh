@@ -0,0 +1,25 @@
+#!/bin/zsh
+if [ 'clear' = "$1" ]
+then
+	rm -rf ft_output
+	rm -rf a.out
+	rm -rf ft_rcu_map
+	rm -rf a.out.dSYM
+	rm -rf rcu_map.dSYM
+	echo "\033[38;5;412mDelete output files\033[0m"
+	return
+fi
+
+# no std counterpart: the reader threads check every version they see
+# against the writer's invariant and count the ones that break it
+clear
+clang++ -Wall -Wextra -Werror -pthread main.cpp -o ft_rcu_map -Ofast
+time ./ft_rcu_map > ft_output
+
+if [ $? -eq 0 ] && grep "torn 0 same 1" ft_output > /dev/null
+then
+	echo "\033[32mReaders 0 torn OK!\033[0m"
+else
+	echo "\033[31mReaders torn ERROR\033[0m"
+fi
+rm -rf ft_rcu_map
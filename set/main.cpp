@@ -2,6 +2,8 @@
 #include "../tree/pair.hpp"
 #include "../vector/vector.hpp"
 #include <set>
+#include <algorithm>
+#include <vector>
 
 template <class T1>
 void print_set(ft::set<T1> &v)
@@ -391,6 +393,179 @@ void set_test_comp() {
 	}
 }
 
+void set_test_sorted_construct() {
+	ft::vector<int> sorted;
+	for (int i = 0; i < 1000; ++i)
+		sorted.push_back(i * 3);
+	ft::set<int> a(sorted.begin(), sorted.end());
+	print_set(a);
+	for (int i = 0; i < 3000; i += 7)
+		a.erase(i);
+	for (int i = 1; i < 3000; i += 11)
+		a.insert(i);
+	print_set(a);
+	sorted.push_back(5);
+	sorted.push_back(3000);
+	sorted.push_back(0);
+	ft::set<int> b(sorted.begin(), sorted.end());
+	print_set(b);
+}
+
+void set_test_rank_select() {
+	ft::vector<int> sorted;
+	for (int i = 0; i < 3000; ++i)
+		sorted.push_back(i * 3);
+	ft::ranked_set<int> s(sorted.begin(), sorted.end());
+	for (int i = 0; i < 9000; i += 11)
+		s.erase(i);
+	for (int i = 1; i < 9000; i += 13)
+		s.insert(i);
+	bool ok = true;
+	std::size_t idx = 0;
+	for (ft::ranked_set<int>::iterator it = s.begin(); it != s.end(); ++it, ++idx) {
+		if (s.select(idx) != it || s.rank(*it) != idx || s.rank(*it + 1) != idx + 1)
+			ok = false;
+	}
+	std::cout << s.size() << " " << ok << std::endl;
+	std::cout << *s.select(s.size() / 2) << " " << s.count_range(0, 9000) << " " << s.count_range(42, 43) << std::endl;
+}
+
+// ranked_set keeps ft under the std substitution of test.sh, so the results
+// are checked against the std algorithms on plain vectors
+bool same(const ft::ranked_set<int>& s, const std::vector<int>& v) {
+	if (s.size() != v.size() || !std::equal(v.begin(), v.end(), s.begin()))
+		return false;
+	for (std::size_t i = 0; i < v.size(); ++i) {
+		if (s.rank(v[i]) != i)
+			return false;
+	}
+	return true;
+}
+
+void set_test_algebra() {
+	ft::ranked_set<int> a;
+	ft::ranked_set<int> b;
+	ft::ranked_set<int> small;
+	for (int i = 0; i < 20000; i += 2)
+		a.insert(i);
+	for (int i = 0; i < 30000; i += 3)
+		b.insert(i);
+	small.insert(-1);
+	small.insert(4);
+	small.insert(5);
+	small.insert(19998);
+	std::vector<int> va(a.begin(), a.end());
+	std::vector<int> vb(b.begin(), b.end());
+	std::vector<int> vs(small.begin(), small.end());
+	std::vector<int> out;
+	std::set_union(va.begin(), va.end(), vb.begin(), vb.end(), std::back_inserter(out));
+	std::cout << set_union(a, b).size() << " " << same(set_union(a, b), out) << std::endl;
+	out.clear();
+	std::set_intersection(va.begin(), va.end(), vb.begin(), vb.end(), std::back_inserter(out));
+	std::cout << set_intersection(a, b).size() << " " << same(set_intersection(a, b), out) << std::endl;
+	out.clear();
+	std::set_difference(va.begin(), va.end(), vb.begin(), vb.end(), std::back_inserter(out));
+	std::cout << set_difference(a, b).size() << " " << same(set_difference(a, b), out) << std::endl;
+	out.clear();
+	std::set_symmetric_difference(va.begin(), va.end(), vb.begin(), vb.end(), std::back_inserter(out));
+	std::cout << set_symmetric_difference(a, b).size() << " " << same(set_symmetric_difference(a, b), out) << std::endl;
+	out.clear();
+	std::set_intersection(vs.begin(), vs.end(), va.begin(), va.end(), std::back_inserter(out));
+	std::cout << same(set_intersection(small, a), out) << same(set_intersection(a, small), out) << std::endl;
+	out.clear();
+	std::set_difference(vs.begin(), vs.end(), va.begin(), va.end(), std::back_inserter(out));
+	std::cout << same(set_difference(small, a), out) << " " << set_difference(small, a).size() << std::endl;
+	ft::ranked_set<int> empty;
+	std::cout << set_union(empty, empty).size() << set_intersection(a, empty).size()
+		<< (set_difference(a, empty) == a) << (set_union(empty, a) == a) << std::endl;
+	ft::ranked_set<int> joined = set_union(a, small);
+	std::cout << joined.size() << " " << *joined.begin() << std::endl;
+}
+
+void print_ranked(const ft::ranked_set<int>& s) {
+	std::cout << "size=\t\t" << s.size() << std::endl;
+	for (ft::ranked_set<int>::const_iterator it = s.begin(); it != s.end(); ++it)
+		std::cout << *it << " ";
+	std::cout << std::endl;
+}
+
+// ranked_set stays ft under the std substitution of test.sh
+void set_test_split_join() {
+	ft::ranked_set<int> s;
+	for (int i = 0; i < 100; ++i)
+		s.insert(i * 2);
+	ft::ranked_set<int> upper;
+	upper.insert(-5);
+	s.split(61, upper);
+	print_ranked(s);
+	print_ranked(upper);
+	upper.split(1000, s);
+	print_ranked(upper);
+	print_ranked(s);
+	s.insert(-10);
+	s.insert(-4);
+	s.join(upper);
+	print_ranked(s);
+	print_ranked(upper);
+	std::cout << s.rank(100) << " " << *s.select(2) << std::endl;
+	ft::ranked_set<int> low;
+	low.insert(7);
+	try {
+		low.join(s);
+	}
+	catch (std::invalid_argument&) {
+		std::cout << "invalid_argument " << low.size() << " " << s.size() << std::endl;
+	}
+}
+
+void set_test_node_handle() {
+	ft::set<int> a;
+	ft::set<int> b;
+	for (int i = 0; i < 20; ++i) {
+		a.insert(i);
+		b.insert(i * 3);
+	}
+	ft::set<int>::node_type nh = a.extract(5);
+	std::cout << nh.value() << " " << a.size() << std::endl;
+	nh.value() = 100;
+	ft::set<int>::insert_return_type r = b.insert(std::move(nh));
+	std::cout << r.inserted << " " << *r.position << " " << r.node.empty() << std::endl;
+	r = b.insert(a.extract(a.begin()));
+	std::cout << r.inserted << " " << *r.position << " " << r.node.value() << std::endl;
+	a.merge(b);
+	print_set(a);
+	print_set(b);
+}
+
+// std::less<> looks std::string keys up by const char* without building a string
+void set_test_transparent() {
+	const char* words[] = {"pear", "apple", "fig", "kiwi", "banana", "plum"};
+	ft::set<std::string, std::less<> > s(words, words + 6);
+	const ft::set<std::string, std::less<> >& cs = s;
+	std::cout << *s.find("fig") << " " << (s.find("grape") == s.end()) << " " << s.count("kiwi") << s.count("lime") << " "
+		<< *s.lower_bound("c") << " " << *cs.upper_bound("kiwi") << " " << *cs.equal_range("pear").first << " "
+		<< (cs.equal_range("orange").first == cs.equal_range("orange").second) << std::endl;
+	ft::btree_set<std::string, std::less<> > b(words, words + 6);
+	std::cout << *b.lower_bound("c") << " " << b.count("plum") << " " << (b.find("zz") == b.end()) << std::endl;
+}
+
+// big enough for the copy to clone subtrees on several threads
+void set_test_copy_large() {
+	ft::set<int> s;
+	for (int i = 0; i < 200000; ++i)
+		s.insert((i * 7919) % 200000);
+	ft::set<int> copy(s);
+	ft::set<int> assigned;
+	assigned.insert(-1);
+	assigned = copy;
+	copy.erase(0);
+	long sum = 0;
+	for (ft::set<int>::iterator it = copy.begin(); it != copy.end(); ++it)
+		sum += *it;
+	std::cout << s.size() << " " << copy.size() << " " << assigned.size() << " " << (assigned == s) << " "
+		<< (copy == s) << " " << sum << " " << *copy.begin() << " " << *assigned.rbegin() << std::endl;
+}
+
 int main() {
 	set_simple_test();
 	set_test_reverse_iterators();
@@ -406,4 +581,11 @@ int main() {
 	set_test_swap();
 	set_test_find();
 	set_test_comp();
+	set_test_sorted_construct();
+	set_test_rank_select();
+	set_test_algebra();
+	set_test_split_join();
+	set_test_node_handle();
+	set_test_transparent();
+	set_test_copy_large();
 }
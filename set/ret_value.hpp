@@ -0,0 +1,16 @@
+#ifndef RET_VALUE_HPP
+#define RET_VALUE_HPP
+
+namespace ft {
+	template <typename T>
+	struct ret_value {
+		T& operator()(T& value) {
+			return value;
+		}
+		const T& operator()(const T& value) const {
+			return value;
+		}
+	};
+}
+
+#endif
@@ -2,20 +2,12 @@
 #define SET_HPP
 
 #include <iostream>
-#include "../tree/rbtree.hpp"
+#include "../tree/tree_select.hpp"
+#include "ret_value.hpp"
 
 namespace ft {
-	template <typename T>
-	struct ret_value {
-		T& operator()(T& value) {
-			return value;
-		}
-		const T& operator()(const T& value) const {
-			return value;
-		}
-	};
-
-	template <class T, class Compare = std::less<T>, class Allocator = std::allocator<T> >
+	template <class T, class Compare = std::less<T>, class Allocator = std::allocator<T>,
+		class NodePolicy = ft::plain_nodes>
 	class set {
 	public:
 
@@ -32,7 +24,7 @@ namespace ft {
 		typedef typename Allocator::pointer			pointer;
 		typedef typename Allocator::const_pointer	const_pointer;
 	private:
-		typedef rbTree<key_type, value_type, ft::ret_value<value_type>, key_compare, allocator_type> tree;
+		typedef typename ft::tree_select<key_type, value_type, ft::ret_value<value_type>, key_compare, allocator_type, NodePolicy>::type tree;
 		tree _tree;
 		allocator_type _allocator;
 	public:
@@ -40,6 +32,8 @@ namespace ft {
 		typedef typename tree::const_iterator const_iterator;
 		typedef typename tree::reverse_iterator reverse_iterator;
 		typedef typename tree::const_reverse_iterator const_reverse_iterator;
+		typedef typename tree::node_handle node_type;
+		typedef typename tree::insert_return_type insert_return_type;
 
 		// CONSTRUCTORS + DESTRUCTOR
 
@@ -51,12 +45,19 @@ namespace ft {
 			_tree.insert(first, last);
 		}
 
+		template<class InputIterator>
+		set(ft::sorted_unique_t, InputIterator first, InputIterator last, const key_compare& comp = key_compare(),
+			const allocator_type& alloc = allocator_type()) : _tree(comp, alloc) {
+			_tree.insert(ft::sorted_unique, first, last);
+		}
+
 		set(const set& x) : _tree(x._tree) {}
 
 		// OPERATORS
 
 		set& operator=(const set& other) {
 			_tree = other._tree;
+			return *this;
 		}
 		// MEMBER FUNCTIONS
 		iterator begin() {
@@ -71,6 +72,15 @@ namespace ft {
 		size_type count(const key_type& k) const {
 			return _tree.count(k);
 		}
+		// with a transparent key_compare these also take any key it can compare
+		template<class K, class = typename ft::transparent_key<Compare, K>::type>
+		size_type count(const K& k) const {
+			return _tree.count(k);
+		}
+		// the range queries below need NodePolicy = ft::counted_nodes
+		size_type count_range(const key_type& lo, const key_type& hi) const {
+			return _tree.count_range(lo, hi);
+		}
 		bool empty() const {
 			return _tree.empty();
 		}
@@ -83,11 +93,20 @@ namespace ft {
 		ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
 			return _tree.equal_range(k);
 		}
+		template<class K, class = typename ft::transparent_key<Compare, K>::type>
+		ft::pair<const_iterator, const_iterator> equal_range(const K& k) const {
+			return _tree.equal_range(k);
+		}
 		ft::pair<iterator, iterator> equal_range(const key_type& k) {
 			return _tree.equal_range(k);
 		}
-		void erase(iterator position) {
-			_tree.erase(position);
+		template<class K, class = typename ft::transparent_key<Compare, K>::type>
+		ft::pair<iterator, iterator> equal_range(const K& k) {
+			return _tree.equal_range(k);
+		}
+		// the next element; see map::erase
+		iterator erase(iterator position) {
+			return _tree.erase(position);
 		}
 		size_type erase(const key_type& k) {
 			return _tree.erase(k);
@@ -95,12 +114,26 @@ namespace ft {
 		void erase(iterator first, iterator last) {
 			_tree.erase(first, last);
 		}
+		node_type extract(const_iterator position) {
+			return _tree.extract(position);
+		}
+		node_type extract(const key_type& k) {
+			return _tree.extract(k);
+		}
 		iterator find(const key_type& k) {
 			return _tree.find(k);
 		}
+		template<class K, class = typename ft::transparent_key<Compare, K>::type>
+		iterator find(const K& k) {
+			return _tree.find(k);
+		}
 		const_iterator find(const key_type& k) const {
 			return _tree.find(k);
 		}
+		template<class K, class = typename ft::transparent_key<Compare, K>::type>
+		const_iterator find(const K& k) const {
+			return _tree.find(k);
+		}
 		allocator_type get_allocator() const {
 			return _tree.get_allocator();
 		}
@@ -114,18 +147,44 @@ namespace ft {
 		void insert(InputIterator first, InputIterator last) {
 			_tree.insert(first, last);
 		}
+		insert_return_type insert(node_type&& nh) {
+			return _tree.insert(std::move(nh));
+		}
+		iterator insert(const_iterator position, node_type&& nh) {
+			return _tree.insert(position, std::move(nh));
+		}
+		// appends right, whose keys must all be greater, and empties it;
+		// throws std::invalid_argument when the ranges overlap
+		void join(set& right) {
+			_tree.join(right._tree);
+		}
 		key_compare key_comp() const {
 			return _tree.key_comp();
 		}
 		iterator lower_bound(const key_type& k) {
 			return _tree.lower_bound(k);
 		}
+		template<class K, class = typename ft::transparent_key<Compare, K>::type>
+		iterator lower_bound(const K& k) {
+			return _tree.lower_bound(k);
+		}
 		const_iterator lower_bound(const key_type& k) const {
 			return _tree.lower_bound(k);
 		}
+		template<class K, class = typename ft::transparent_key<Compare, K>::type>
+		const_iterator lower_bound(const K& k) const {
+			return _tree.lower_bound(k);
+		}
+		// takes over the elements of source whose keys are missing here
+		void merge(set& source) {
+			_tree.merge(source._tree);
+		}
 		size_type max_size() const {
 			return _allocator.max_size();
 		}
+		size_type rank(const key_type& k) const {
+			return _tree.rank(k);
+		}
 		reverse_iterator rbegin() {
 			return _tree.rbegin();
 		}
@@ -138,55 +197,128 @@ namespace ft {
 		const_reverse_iterator rend() const {
 			return _tree.rend();
 		}
+		iterator select(size_type i) {
+			return _tree.select(i);
+		}
+		const_iterator select(size_type i) const {
+			return _tree.select(i);
+		}
 		size_type size() const {
 			return _tree.size();
 		}
+		// keeps the keys less than k and moves the rest into upper: O(log n)
+		// with counted_nodes (ranked_set), otherwise also linear in the
+		// smaller half, whose size has to be recounted
+		void split(const key_type& k, set& upper) {
+			_tree.split(k, upper._tree);
+		}
 		void swap(set& x) {
 			_tree.swap(x._tree);
 		}
 		iterator upper_bound(const key_type& k) {
 			return _tree.upper_bound(k);
 		}
+		template<class K, class = typename ft::transparent_key<Compare, K>::type>
+		iterator upper_bound(const K& k) {
+			return _tree.upper_bound(k);
+		}
 		const_iterator upper_bound(const key_type& k) const {
 			return _tree.upper_bound(k);
 		}
+		template<class K, class = typename ft::transparent_key<Compare, K>::type>
+		const_iterator upper_bound(const K& k) const {
+			return _tree.upper_bound(k);
+		}
 		value_compare value_comp() const {
 			return value_compare(_tree.key_comp());
 		}
-		template<typename T1, typename Comp, typename Alloc>
-		friend bool operator==(const set<T1, Comp, Alloc>& x, const set<T1, Comp, Alloc>& y);
-		template<typename T1, typename Comp, typename Alloc>
-		friend bool operator<(const set<T1, Comp, Alloc>& x, const set<T1, Comp, Alloc>& y);
+		template<typename T1, typename Comp, typename Alloc, typename NP>
+		friend bool operator==(const set<T1, Comp, Alloc, NP>& x, const set<T1, Comp, Alloc, NP>& y);
+		template<typename T1, typename Comp, typename Alloc, typename NP>
+		friend bool operator<(const set<T1, Comp, Alloc, NP>& x, const set<T1, Comp, Alloc, NP>& y);
+		template<typename T1, typename Comp, typename Alloc, typename NP>
+		friend set<T1, Comp, Alloc, NP> set_difference(const set<T1, Comp, Alloc, NP>& x, const set<T1, Comp, Alloc, NP>& y);
+		template<typename T1, typename Comp, typename Alloc, typename NP>
+		friend set<T1, Comp, Alloc, NP> set_intersection(const set<T1, Comp, Alloc, NP>& x, const set<T1, Comp, Alloc, NP>& y);
+		template<typename T1, typename Comp, typename Alloc, typename NP>
+		friend set<T1, Comp, Alloc, NP> set_symmetric_difference(const set<T1, Comp, Alloc, NP>& x, const set<T1, Comp, Alloc, NP>& y);
+		template<typename T1, typename Comp, typename Alloc, typename NP>
+		friend set<T1, Comp, Alloc, NP> set_union(const set<T1, Comp, Alloc, NP>& x, const set<T1, Comp, Alloc, NP>& y);
 	};
 
-	template<typename T1, typename Comp, typename Alloc>
-	inline bool operator==(const set<T1, Comp, Alloc> &x, const set<T1, Comp, Alloc> &y) {
+	template<typename T1, typename Comp, typename Alloc, typename NP>
+	inline bool operator==(const set<T1, Comp, Alloc, NP> &x, const set<T1, Comp, Alloc, NP> &y) {
 		return x._tree == y._tree;
 	}
-	template<typename T1, typename Comp, typename Alloc>
-	inline bool operator!=(const set<T1, Comp, Alloc> &x, const set<T1, Comp, Alloc> &y) {
+	template<typename T1, typename Comp, typename Alloc, typename NP>
+	inline bool operator!=(const set<T1, Comp, Alloc, NP> &x, const set<T1, Comp, Alloc, NP> &y) {
 		return !(x == y);
 	}
-	template<typename T1, typename Comp, typename Alloc>
-	inline bool operator<(const set<T1, Comp, Alloc> &x, const set<T1, Comp, Alloc> &y) {
+	template<typename T1, typename Comp, typename Alloc, typename NP>
+	inline bool operator<(const set<T1, Comp, Alloc, NP> &x, const set<T1, Comp, Alloc, NP> &y) {
 		return x._tree < y._tree;
 	}
-	template<typename T1, typename Comp, typename Alloc>
-	inline bool operator>(const set<T1, Comp, Alloc> &x, const set<T1, Comp, Alloc> &y) {
+	template<typename T1, typename Comp, typename Alloc, typename NP>
+	inline bool operator>(const set<T1, Comp, Alloc, NP> &x, const set<T1, Comp, Alloc, NP> &y) {
 		return y < x;
 	}
-	template<typename T1, typename Comp, typename Alloc>
-	inline bool operator<=(const set<T1, Comp, Alloc> &x, const set<T1, Comp, Alloc> &y) {
+	template<typename T1, typename Comp, typename Alloc, typename NP>
+	inline bool operator<=(const set<T1, Comp, Alloc, NP> &x, const set<T1, Comp, Alloc, NP> &y) {
 		return !(y < x);
 	}
-	template<typename T1, typename Comp, typename Alloc>
-	inline bool operator>=(const set<T1, Comp, Alloc> &x, const set<T1, Comp, Alloc> &y) {
+	template<typename T1, typename Comp, typename Alloc, typename NP>
+	inline bool operator>=(const set<T1, Comp, Alloc, NP> &x, const set<T1, Comp, Alloc, NP> &y) {
 		return !(x < y);
 	}
-	template<typename T1, typename Comp, typename Alloc>
-	inline void swap(const set<T1, Comp, Alloc> &x, const set<T1, Comp, Alloc> &y) {
+	template<typename T1, typename Comp, typename Alloc, typename NP>
+	inline void swap(set<T1, Comp, Alloc, NP> &x, set<T1, Comp, Alloc, NP> &y) {
 		x.swap(y);
 	}
+
+	// Linear set algebra: both sides are walked in order and the result is
+	// linked into a balanced tree; keys present in both take x's value.
+	template<typename T1, typename Comp, typename Alloc, typename NP>
+	inline set<T1, Comp, Alloc, NP> set_difference(const set<T1, Comp, Alloc, NP>& x, const set<T1, Comp, Alloc, NP>& y) {
+		set<T1, Comp, Alloc, NP> res(x.key_comp());
+		res._tree.assign_difference(x._tree, y._tree);
+		return res;
+	}
+	template<typename T1, typename Comp, typename Alloc, typename NP>
+	inline set<T1, Comp, Alloc, NP> set_intersection(const set<T1, Comp, Alloc, NP>& x, const set<T1, Comp, Alloc, NP>& y) {
+		set<T1, Comp, Alloc, NP> res(x.key_comp());
+		res._tree.assign_intersection(x._tree, y._tree);
+		return res;
+	}
+	template<typename T1, typename Comp, typename Alloc, typename NP>
+	inline set<T1, Comp, Alloc, NP> set_symmetric_difference(const set<T1, Comp, Alloc, NP>& x, const set<T1, Comp, Alloc, NP>& y) {
+		set<T1, Comp, Alloc, NP> res(x.key_comp());
+		res._tree.assign_symmetric_difference(x._tree, y._tree);
+		return res;
+	}
+	template<typename T1, typename Comp, typename Alloc, typename NP>
+	inline set<T1, Comp, Alloc, NP> set_union(const set<T1, Comp, Alloc, NP>& x, const set<T1, Comp, Alloc, NP>& y) {
+		set<T1, Comp, Alloc, NP> res(x.key_comp());
+		res._tree.assign_union(x._tree, y._tree);
+		return res;
+	}
+
+	// set that also answers rank, select and count_range in O(log n)
+	template <class T, class Compare = std::less<T>, class Allocator = std::allocator<T> >
+	using ranked_set = set<T, Compare, Allocator, ft::counted_nodes>;
+
+	// set whose nodes keep the colour in the parent pointer: 8 bytes less each
+	template <class T, class Compare = std::less<T>, class Allocator = std::allocator<T> >
+	using compact_set = set<T, Compare, Allocator, ft::compact_nodes>;
+
+	// set on arenaTree: nodes in one buffer, linked by 32-bit index; no
+	// node handles, split/join, set algebra or rank queries
+	template <class T, class Compare = std::less<T>, class Allocator = std::allocator<T> >
+	using arena_set = set<T, Compare, Allocator, ft::arena_nodes>;
+
+	// set on a B+-tree with 256-byte nodes: far fewer cache misses per lookup
+	// on large trees, but insert and erase invalidate other iterators
+	template <class T, class Compare = std::less<T>, class Allocator = std::allocator<T> >
+	using btree_set = set<T, Compare, Allocator, ft::btree_nodes<> >;
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "sharded_map.hpp"
+#include <map>
+#include <string>
+
+void map_test_basic() {
+	ft::sharded_map<int, std::string, 4> m;
+	std::cout << m.insert(ft::pair<const int, std::string>(1, "one")) << m.insert(ft::pair<const int, std::string>(1, "un"))
+		<< m.insert_or_assign(2, "two") << m.insert_or_assign(2, "deux") << std::endl;
+	std::cout << m.size() << " " << m.count(1) << m.count(3) << " " << m.at(1) << " " << m.at(2) << std::endl;
+	std::cout << m.visit(1, [](ft::pair<const int, std::string>& v) { v.second += "!"; }) << m.visit(3,
+		[](ft::pair<const int, std::string>& v) { v.second += "?"; }) << " " << m.at(1) << std::endl;
+	try {
+		m.at(3);
+	}
+	catch (std::out_of_range&) {
+		std::cout << "out of range" << std::endl;
+	}
+	std::cout << m.erase(1) << m.erase(1) << " " << m.size() << std::endl;
+	m.clear();
+	std::cout << m.empty() << std::endl;
+}
+
+// with range shards the shards hold consecutive key ranges, so a serial
+// for_each sees every key in order
+void map_test_range() {
+	int bounds[] = {10, 20, 30};
+	ft::pair<int, int> init[] = {
+		ft::pair<int, int>(25, 0), ft::pair<int, int>(3, 0), ft::pair<int, int>(40, 0), ft::pair<int, int>(10, 0),
+		ft::pair<int, int>(19, 0), ft::pair<int, int>(-5, 0), ft::pair<int, int>(30, 0)
+	};
+	ft::range_shard<int> part(bounds, bounds + 3);
+	ft::sharded_map<int, int, 4, ft::range_shard<int> > m(init, init + 7, part);
+	std::cout << part(-5, 4) << part(10, 4) << part(29, 4) << part(99, 4) << part(99, 2) << std::endl;
+	m.for_each([](const ft::pair<const int, int>& v) { std::cout << v.first << " "; });
+	std::cout << std::endl;
+}
+
+// enough elements for bulk work to fan out across threads
+void map_test_bulk() {
+	const int n = 200000;
+	ft::vector<ft::pair<int, long> > values;
+	for (int i = 0; i < n; ++i)
+		values.push_back(ft::pair<int, long>((i * 7919) % n, i));
+	ft::sharded_map<int, long, 8> m;
+	m.insert(values.begin(), values.end());
+	std::atomic<long> keys(0);
+	m.for_each([&keys](ft::pair<const int, long>& v) {
+		keys += v.first;
+		v.second = -v.second;
+	});
+	long values_sum = 0;
+	for (int i = 0; i < n; i += 1000)
+		values_sum += m.at(i);
+	std::cout << m.size() << " " << keys.load() << " " << (values_sum <= 0) << std::endl;
+	try {
+		m.for_each([](const ft::pair<const int, long>& v) {
+			if (v.first == 4242)
+				throw std::runtime_error("stop");
+		});
+	}
+	catch (std::runtime_error& e) {
+		std::cout << e.what() << std::endl;
+	}
+	m.clear();
+	std::cout << m.size() << std::endl;
+}
+
+int main() {
+	map_test_basic();
+	map_test_range();
+	map_test_bulk();
+}
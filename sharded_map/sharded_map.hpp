@@ -0,0 +1,268 @@
+#ifndef SHARDED_MAP_HPP
+#define SHARDED_MAP_HPP
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+#include "../iterator/iterator_traits.hpp"
+#include "../map/map.hpp"
+#include "../utility/parallel.hpp"
+#include "../vector/vector.hpp"
+
+namespace ft {
+	// Spreads keys over the shards by hash; the multiply keeps sequential
+	// keys from piling into a few shards under an identity hash.
+	template <class Key, class Hash = std::hash<Key> >
+	struct hash_shard {
+		std::size_t operator()(const Key& k, std::size_t shards) const {
+			std::uint64_t h = static_cast<std::uint64_t>(Hash()(k)) * 0x9E3779B97F4A7C15ull;
+			return static_cast<std::size_t>(h >> 32) % shards;
+		}
+	};
+
+	// Gives each shard a key range: shard i holds the keys from bound i - 1
+	// up to, not including, bound i, and keys past the last bound go to the
+	// last shard. Each shard is then ordered, but for_each still runs the
+	// shards in parallel, so only a single-threaded for_each sees every key
+	// in order.
+	template <class Key, class Compare = std::less<Key> >
+	class range_shard {
+	public:
+		range_shard() {}
+		template<class InputIterator>
+		range_shard(InputIterator first, InputIterator last, const Compare& comp = Compare()) : _comp(comp) {
+			for (; first != last; ++first)
+				_bounds.push_back(*first);
+		}
+
+		std::size_t operator()(const Key& k, std::size_t shards) const {
+			std::size_t lo = 0;
+			std::size_t hi = _bounds.size();
+			while (lo < hi) {
+				std::size_t mid = (lo + hi) / 2;
+				if (_comp(k, _bounds[mid]))
+					hi = mid;
+				else
+					lo = mid + 1;
+			}
+			return lo < shards ? lo : shards - 1;
+		}
+	private:
+		ft::vector<Key>	_bounds;
+		Compare			_comp;
+	};
+
+	// N ft::maps behind a lock each, for writers that mostly hit different
+	// keys. A key always lives in the shard Partition picks for it, so point
+	// operations lock that shard alone; for_each, clear and bulk insert work
+	// on the shards in parallel. Elements are reached through calls that
+	// hold the lock (at, visit, for_each) rather than iterators, which
+	// could not outlive it.
+	template <class Key, class T, std::size_t N = 16, class Partition = ft::hash_shard<Key>,
+		class Compare = std::less<Key>, class Allocator = std::allocator<ft::pair<const Key, T> > >
+	class sharded_map {
+	public:
+
+		// DEF
+
+		typedef Key									key_type;
+		typedef T									mapped_type;
+		typedef ft::pair<const Key, T>				value_type;
+		typedef std::size_t							size_type;
+		typedef Compare								key_compare;
+		typedef Allocator							allocator_type;
+		typedef Partition							partition_type;
+		typedef ft::map<Key, T, Compare, Allocator>	shard_type;
+
+		static const size_type shard_count = N;
+
+		// below this many elements per thread, bulk work stays on the caller
+		static const size_type parallel_grain = 4096;
+
+		// CONSTRUCTORS + DESTRUCTOR
+
+		explicit sharded_map(const partition_type& part = partition_type(), const key_compare& comp = key_compare(),
+			const allocator_type& alloc = allocator_type()) : _part(part) {
+			for (size_type i = 0; i < N; ++i)
+				shard_type(comp, alloc).swap(_shards[i].map);
+		}
+
+		template<class InputIterator>
+		sharded_map(InputIterator first, InputIterator last, const partition_type& part = partition_type(),
+			const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : _part(part) {
+			for (size_type i = 0; i < N; ++i)
+				shard_type(comp, alloc).swap(_shards[i].map);
+			insert(first, last);
+		}
+
+		// MEMBER FUNCTIONS
+
+		// by value: the element may change once the shard is unlocked
+		mapped_type at(const key_type& k) const {
+			const shard& s = _shard(k);
+			std::lock_guard<std::mutex> lock(s.lock);
+			typename shard_type::const_iterator it = s.map.find(k);
+			if (it == s.map.end())
+				throw std::out_of_range("sharded_map::at");
+			return it->second;
+		}
+		// empties the shards in parallel
+		void clear() {
+			_fan_out(size(), [](shard& s) {
+				std::lock_guard<std::mutex> lock(s.lock);
+				s.map.clear();
+			});
+		}
+		size_type count(const key_type& k) const {
+			const shard& s = _shard(k);
+			std::lock_guard<std::mutex> lock(s.lock);
+			return s.map.count(k);
+		}
+		bool empty() const {
+			return size() == 0;
+		}
+		size_type erase(const key_type& k) {
+			shard& s = _shard(k);
+			std::lock_guard<std::mutex> lock(s.lock);
+			return s.map.erase(k);
+		}
+		// calls f(value_type&) on every element, the shards in parallel and
+		// each under its lock, so f must be safe to run on several threads;
+		// elements of one shard come in key order
+		template<class F>
+		void for_each(F f) {
+			_fan_out(size(), [&f](shard& s) {
+				std::lock_guard<std::mutex> lock(s.lock);
+				for (typename shard_type::iterator it = s.map.begin(); it != s.map.end(); ++it)
+					f(*it);
+			});
+		}
+		template<class F>
+		void for_each(F f) const {
+			const_cast<sharded_map*>(this)->_fan_out(size(), [&f](shard& s) {
+				std::lock_guard<std::mutex> lock(s.lock);
+				const shard_type& m = s.map;
+				for (typename shard_type::const_iterator it = m.begin(); it != m.end(); ++it)
+					f(*it);
+			});
+		}
+		bool insert(const value_type& val) {
+			shard& s = _shard(val.first);
+			std::lock_guard<std::mutex> lock(s.lock);
+			return s.map.insert(val).second;
+		}
+		// sorts the values into their shards, then inserts into the shards
+		// in parallel
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last) {
+			_insert(first, last, typename ft::iterator_traits<InputIterator>::iterator_category());
+		}
+		template<class M>
+		bool insert_or_assign(const key_type& k, M&& obj) {
+			shard& s = _shard(k);
+			std::lock_guard<std::mutex> lock(s.lock);
+			return s.map.insert_or_assign(k, std::forward<M>(obj)).second;
+		}
+		key_compare key_comp() const {
+			return _shards[0].map.key_comp();
+		}
+		partition_type partition() const {
+			return _part;
+		}
+		// the total over the shards, each read under its lock: exact when no
+		// write is under way
+		size_type size() const {
+			size_type n = 0;
+			for (size_type i = 0; i < N; ++i) {
+				std::lock_guard<std::mutex> lock(_shards[i].lock);
+				n += _shards[i].map.size();
+			}
+			return n;
+		}
+		// calls f(value_type&) on k's element under its shard's lock, for
+		// a read-modify-write no other thread can come between; false when
+		// k is not there
+		template<class F>
+		bool visit(const key_type& k, F f) {
+			shard& s = _shard(k);
+			std::lock_guard<std::mutex> lock(s.lock);
+			typename shard_type::iterator it = s.map.find(k);
+			if (it == s.map.end())
+				return false;
+			f(*it);
+			return true;
+		}
+		template<class F>
+		bool visit(const key_type& k, F f) const {
+			const shard& s = _shard(k);
+			std::lock_guard<std::mutex> lock(s.lock);
+			typename shard_type::const_iterator it = s.map.find(k);
+			if (it == s.map.end())
+				return false;
+			f(*it);
+			return true;
+		}
+	private:
+		// a cache line each, so threads on neighbouring shards do not share one
+		struct alignas(64) shard {
+			mutable std::mutex	lock;
+			shard_type			map;
+		};
+
+		shard			_shards[N];
+		partition_type	_part;
+
+		sharded_map(const sharded_map&);
+		sharded_map& operator=(const sharded_map&);
+
+		shard& _shard(const key_type& k) {
+			return _shards[_part(k, N)];
+		}
+		const shard& _shard(const key_type& k) const {
+			return _shards[_part(k, N)];
+		}
+		// a forward range is sorted by iterator, so each value is copied
+		// once, straight into its node
+		template<class It>
+		void _insert(It first, It last, std::forward_iterator_tag) {
+			std::vector<It> parts[N];
+			size_type n = 0;
+			for (; first != last; ++first, ++n)
+				parts[_part(first->first, N)].push_back(first);
+			_fan_out(n, [this, &parts](shard& s) {
+				std::vector<It>& part = parts[&s - _shards];
+				std::lock_guard<std::mutex> lock(s.lock);
+				for (size_type i = 0; i < part.size(); ++i)
+					s.map.try_emplace(part[i]->first, part[i]->second);
+			});
+		}
+		// a single pass range has to be copied out first; the copies are
+		// then moved into the nodes
+		template<class It>
+		void _insert(It first, It last, std::input_iterator_tag) {
+			std::vector<value_type> parts[N];
+			size_type n = 0;
+			for (; first != last; ++first, ++n)
+				parts[_part(first->first, N)].push_back(value_type(first->first, first->second));
+			_fan_out(n, [this, &parts](shard& s) {
+				std::vector<value_type>& part = parts[&s - _shards];
+				std::lock_guard<std::mutex> lock(s.lock);
+				for (size_type i = 0; i < part.size(); ++i)
+					s.map.try_emplace(part[i].first, std::move(part[i].second));
+			});
+		}
+		// runs work on every shard, on up to one thread per parallel_grain
+		// elements
+		template<class W>
+		void _fan_out(size_type elements, W work) {
+			size_type threads = ft::parallel_threads(elements, parallel_grain);
+			ft::parallel_for(N, threads, [this, &work](size_type i) {
+				work(_shards[i]);
+			});
+		}
+	};
+}
+
+#endif
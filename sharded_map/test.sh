@@ -0,0 +1,25 @@
+#!/bin/zsh
+if [ 'clear' = "$1" ]
+then
+	rm -rf ft_output
+	rm -rf a.out
+	rm -rf ft_sharded_map
+	rm -rf a.out.dSYM
+	rm -rf sharded_map.dSYM
+	echo "\033[38;5;412mDelete output files\033[0m"
+	return
+fi
+
+# no std counterpart: the bulk test inserts 200000 keys across the shards
+# and for_each must see every one of them
+clear
+clang++ -Wall -Wextra -Werror -pthread main.cpp -o ft_sharded_map -Ofast
+time ./ft_sharded_map > ft_output
+
+if [ $? -eq 0 ] && grep "^200000 19999900000 1$" ft_output > /dev/null
+then
+	echo "\033[32mShards OK!\033[0m"
+else
+	echo "\033[31mShards ERROR\033[0m"
+fi
+rm -rf ft_sharded_map
@@ -0,0 +1,782 @@
+#ifndef ARENA_TREE_HPP
+#define ARENA_TREE_HPP
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include "../utility/algorithm.hpp"
+#include "../utility/sorted_unique.hpp"
+#include "../iterator/reverse_iterator.hpp"
+#include "pair.hpp"
+
+namespace ft {
+	// Red-black node living in a slot of arenaTree's buffer. Links are slot
+	// indices and bit 31 of the parent word is the colour (set = black), so
+	// the links take 12 bytes instead of 32.
+	template <typename Val>
+	struct arenaNode {
+		std::uint32_t	parent_clr;
+		std::uint32_t	left;
+		std::uint32_t	right;
+		Val				val;
+	};
+
+	// The part of the tree the iterators walk: the slot buffer and the ends.
+	template <typename Val>
+	struct arenaBase {
+		static const std::uint32_t nil = 0x7fffffff;
+		static const std::uint32_t black_bit = 0x80000000;
+
+		arenaNode<Val>*	nodes;
+		std::uint32_t	root;
+		std::uint32_t	leftmost;
+		std::uint32_t	rightmost;
+
+		std::uint32_t parent(std::uint32_t x) const {
+			return nodes[x].parent_clr & ~black_bit;
+		}
+		// in-order neighbours, nil past either end
+		std::uint32_t next(std::uint32_t x) const {
+			if (nodes[x].right != nil) {
+				x = nodes[x].right;
+				while (nodes[x].left != nil)
+					x = nodes[x].left;
+				return x;
+			}
+			std::uint32_t p = parent(x);
+			while (p != nil && x == nodes[p].right) {
+				x = p;
+				p = parent(p);
+			}
+			return p;
+		}
+		std::uint32_t prev(std::uint32_t x) const {
+			if (x == nil)
+				return rightmost;
+			if (nodes[x].left != nil) {
+				x = nodes[x].left;
+				while (nodes[x].right != nil)
+					x = nodes[x].right;
+				return x;
+			}
+			std::uint32_t p = parent(x);
+			while (p != nil && x == nodes[p].left) {
+				x = p;
+				p = parent(p);
+			}
+			return p;
+		}
+	};
+
+	// Iterators hold the tree and a slot index, so they survive the buffer
+	// being reallocated by an insert; end() is the nil index.
+	template <typename T>
+	class arena_iterator {
+	public:
+		typedef T								value_type;
+		typedef T&								reference;
+		typedef T*								pointer;
+		typedef std::bidirectional_iterator_tag	iterator_category;
+		typedef std::ptrdiff_t					difference_type;
+		typedef arena_iterator<T>				iterator;
+
+		arena_iterator() : arena(), index() {}
+		arena_iterator(arenaBase<T>* a, std::uint32_t i) : arena(a), index(i) {}
+
+		reference operator*() const {
+			return arena->nodes[index].val;
+		}
+		pointer operator->() const {
+			return &arena->nodes[index].val;
+		}
+		iterator& operator++() {
+			index = arena->next(index);
+			return *this;
+		}
+		iterator operator++(int) {
+			iterator tmp = *this;
+			index = arena->next(index);
+			return tmp;
+		}
+		iterator& operator--() {
+			index = arena->prev(index);
+			return *this;
+		}
+		iterator operator--(int) {
+			iterator tmp = *this;
+			index = arena->prev(index);
+			return tmp;
+		}
+		bool operator==(const iterator& x) const {
+			return index == x.index;
+		}
+		bool operator!=(const iterator& x) const {
+			return index != x.index;
+		}
+
+		arenaBase<T>*	arena;
+		std::uint32_t	index;
+	};
+	template <typename T>
+	class arena_const_iterator {
+	public:
+		typedef T								value_type;
+		typedef const T&						reference;
+		typedef const T*						pointer;
+		typedef std::bidirectional_iterator_tag	iterator_category;
+		typedef std::ptrdiff_t					difference_type;
+		typedef arena_const_iterator<T>			iterator;
+
+		arena_const_iterator() : arena(), index() {}
+		arena_const_iterator(const arenaBase<T>* a, std::uint32_t i) : arena(a), index(i) {}
+		arena_const_iterator(const arena_iterator<T>& it) : arena(it.arena), index(it.index) {}
+
+		reference operator*() const {
+			return arena->nodes[index].val;
+		}
+		pointer operator->() const {
+			return &arena->nodes[index].val;
+		}
+		iterator& operator++() {
+			index = arena->next(index);
+			return *this;
+		}
+		iterator operator++(int) {
+			iterator tmp = *this;
+			index = arena->next(index);
+			return tmp;
+		}
+		iterator& operator--() {
+			index = arena->prev(index);
+			return *this;
+		}
+		iterator operator--(int) {
+			iterator tmp = *this;
+			index = arena->prev(index);
+			return tmp;
+		}
+		bool operator==(const iterator& x) const {
+			return index == x.index;
+		}
+		bool operator!=(const iterator& x) const {
+			return index != x.index;
+		}
+
+		const arenaBase<T>*	arena;
+		std::uint32_t		index;
+	};
+
+	template <typename Val>
+	inline bool operator==(const arena_iterator<Val>& x, const arena_const_iterator<Val>& y) {
+		return x.index == y.index;
+	}
+	template <typename Val>
+	inline bool operator!=(const arena_iterator<Val>& x, const arena_const_iterator<Val>& y) {
+		return x.index != y.index;
+	}
+
+	// nodes cannot leave an arena, so there are no node handles
+	struct arena_no_node_handle;
+
+	// Red-black tree whose nodes sit in one growable buffer and link to each
+	// other by 32-bit slot index. Erased slots are chained into a free list
+	// and reused. Copying duplicates the buffer slot by slot with no
+	// rebalancing. swap() exchanges buffers, so unlike rbTree it leaves
+	// iterators pointing into the tree they came from.
+	template<typename Key, typename Val, typename KeyOfValue, typename Compare = std::less<Key>, typename Alloc = std::allocator<Val> >
+	class arenaTree {
+		typedef arenaNode<Val> node_type;
+		typedef typename Alloc::template rebind<node_type>::other node_allocator;
+		typedef std::uint32_t slot;
+		static const slot nil = arenaBase<Val>::nil;
+		static const slot black_bit = arenaBase<Val>::black_bit;
+		// parent word of a slot on the free list; no live node has it
+		static const slot free_mark = nil - 1;
+	public:
+
+		typedef Val										value_type;
+		typedef Compare									value_compare;
+		typedef Alloc									allocator_type;
+		typedef Key										key_type;
+		typedef value_type*								pointer;
+		typedef const value_type*						const_pointer;
+		typedef value_type&								reference;
+		typedef const value_type&						const_reference;
+		typedef std::size_t								size_type;
+		typedef std::ptrdiff_t							difference_type;
+		typedef arena_iterator<value_type>				iterator;
+		typedef arena_const_iterator<value_type>		const_iterator;
+		typedef ft::reverse_iterator<iterator>			reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>	const_reverse_iterator;
+		typedef arena_no_node_handle					node_handle;
+		typedef arena_no_node_handle					insert_return_type;
+
+		arenaTree() : _arena(), _cap(0), _used(0), _free(nil), _size(0), _allocator(), _nodeAlloc(), _comp() {
+			_reset();
+		}
+		arenaTree(const Compare& comp, const allocator_type& a = allocator_type()) :
+				_arena(), _cap(0), _used(0), _free(nil), _size(0), _allocator(a), _nodeAlloc(a), _comp(comp) {
+			_reset();
+		}
+		arenaTree(const arenaTree& other) : _arena(), _cap(0), _used(0), _free(nil), _size(0),
+				_allocator(other._allocator), _nodeAlloc(other._nodeAlloc), _comp(other._comp) {
+			_reset();
+			_copy_slots(other);
+		}
+		arenaTree& operator=(const arenaTree& other) {
+			if (this != &other) {
+				clear();
+				_comp = other._comp;
+				_copy_slots(other);
+			}
+			return *this;
+		}
+		~arenaTree() {
+			clear();
+			if (_arena.nodes)
+				_nodeAlloc.deallocate(_arena.nodes, _cap);
+		}
+		iterator begin() {
+			return iterator(&_arena, _arena.leftmost);
+		}
+		const_iterator begin() const {
+			return const_iterator(&_arena, _arena.leftmost);
+		}
+		// slots allocated, live or free
+		size_type capacity() const {
+			return _cap;
+		}
+		void clear() {
+			for (slot i = 0; i < _used; ++i) {
+				if (_n(i).parent_clr != free_mark)
+					_allocator.destroy(&_n(i).val);
+			}
+			_used = 0;
+			_free = nil;
+			_size = 0;
+			_reset();
+		}
+		template<class K>
+		size_type count(const K& k) const {
+			return find(k) == end() ? 0 : 1;
+		}
+		bool empty() const {
+			return _size == 0;
+		}
+		iterator end() {
+			return iterator(&_arena, nil);
+		}
+		const_iterator end() const {
+			return const_iterator(&_arena, nil);
+		}
+		template<class K>
+		ft::pair<iterator, iterator> equal_range(const K& k) {
+			return ft::pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+		}
+		template<class K>
+		ft::pair<const_iterator, const_iterator> equal_range(const K& k) const {
+			return ft::pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+		}
+		iterator erase(iterator position) {
+			iterator next = position;
+			++next;
+			_erase_slot(position.index);
+			return next;
+		}
+		void erase(iterator first, iterator last) {
+			if (first == begin() && last == end()) {
+				clear();
+				return;
+			}
+			while (first != last)
+				erase(first++);
+		}
+		size_type erase(const key_type& k) {
+			iterator it = find(k);
+			if (it == end())
+				return 0;
+			erase(it);
+			return 1;
+		}
+		template<class K>
+		iterator find(const K& k) {
+			iterator j = lower_bound(k);
+			return (j == end() || _comp(k, KeyOfValue()(*j))) ? end() : j;
+		}
+		template<class K>
+		const_iterator find(const K& k) const {
+			const_iterator j = lower_bound(k);
+			return (j == end() || _comp(k, KeyOfValue()(*j))) ? end() : j;
+		}
+		allocator_type get_allocator() const {
+			return _allocator;
+		}
+		ft::pair<iterator, bool> insert(const value_type& val) {
+			slot parent;
+			bool insert_left;
+			slot x = _locate_unique(KeyOfValue()(val), parent, insert_left);
+			if (x != nil)
+				return ft::pair<iterator, bool>(iterator(&_arena, x), false);
+			return ft::pair<iterator, bool>(_attach(_create_node(val), parent, insert_left), true);
+		}
+		// only the append-at-the-end hint is used, which makes sorted input O(1) per element
+		iterator insert(const_iterator position, const value_type& val) {
+			if (position == end() && _size > 0 && _comp(KeyOfValue()(_n(_arena.rightmost).val), KeyOfValue()(val)))
+				return _attach(_create_node(val), _arena.rightmost, false);
+			return insert(val).first;
+		}
+		template<class It>
+		void insert(It first, It last) {
+			for (; first != last; ++first)
+				insert(end(), *first);
+		}
+		template<class It>
+		void insert(ft::sorted_unique_t, It first, It last) {
+			for (; first != last; ++first)
+				insert(end(), *first);
+		}
+		// map only: assigns to the mapped value when k is present
+		template<class M>
+		ft::pair<iterator, bool> insert_or_assign(const key_type& k, M&& obj) {
+			slot parent;
+			bool insert_left;
+			slot x = _locate_unique(k, parent, insert_left);
+			if (x != nil) {
+				_n(x).val.second = std::forward<M>(obj);
+				return ft::pair<iterator, bool>(iterator(&_arena, x), false);
+			}
+			return ft::pair<iterator, bool>(_attach(_create_node(k, std::forward<M>(obj)), parent, insert_left), true);
+		}
+		Compare key_comp() const {
+			return _comp;
+		}
+		template<class K>
+		iterator lower_bound(const K& k) {
+			return iterator(&_arena, _lower_bound(k));
+		}
+		template<class K>
+		const_iterator lower_bound(const K& k) const {
+			return const_iterator(&_arena, _lower_bound(k));
+		}
+		size_type max_size() const {
+			size_type limit = free_mark;
+			return std::min<size_type>(_nodeAlloc.max_size(), limit);
+		}
+		reverse_iterator rbegin() {
+			return reverse_iterator(end());
+		}
+		const_reverse_iterator rbegin() const {
+			return const_reverse_iterator(end());
+		}
+		reverse_iterator rend() {
+			return reverse_iterator(begin());
+		}
+		const_reverse_iterator rend() const {
+			return const_reverse_iterator(begin());
+		}
+		void reserve(size_type n) {
+			if (n > _cap)
+				_grow(n);
+		}
+		size_type size() const {
+			return _size;
+		}
+		void swap(arenaTree& other) {
+			std::swap(_arena, other._arena);
+			std::swap(_cap, other._cap);
+			std::swap(_used, other._used);
+			std::swap(_free, other._free);
+			std::swap(_size, other._size);
+			std::swap(_nodeAlloc, other._nodeAlloc);
+			std::swap(_comp, other._comp);
+		}
+		// map only: the mapped value is built from args only when k is absent
+		template<class... Args>
+		ft::pair<iterator, bool> try_emplace(const key_type& k, Args&&... args) {
+			slot parent;
+			bool insert_left;
+			slot x = _locate_unique(k, parent, insert_left);
+			if (x != nil)
+				return ft::pair<iterator, bool>(iterator(&_arena, x), false);
+			return ft::pair<iterator, bool>(_attach(_create_node(ft::emplace_second, k, std::forward<Args>(args)...), parent, insert_left), true);
+		}
+		template<class K>
+		iterator upper_bound(const K& k) {
+			return iterator(&_arena, _upper_bound(k));
+		}
+		template<class K>
+		const_iterator upper_bound(const K& k) const {
+			return const_iterator(&_arena, _upper_bound(k));
+		}
+	private:
+		arenaBase<Val>	_arena;
+		slot			_cap;
+		slot			_used;
+		slot			_free;
+		size_type		_size;
+		allocator_type	_allocator;
+		node_allocator	_nodeAlloc;
+		Compare			_comp;
+
+		node_type& _n(slot x) const {
+			return _arena.nodes[x];
+		}
+		slot _parent(slot x) const {
+			return _n(x).parent_clr & ~black_bit;
+		}
+		void _set_parent(slot x, slot p) {
+			_n(x).parent_clr = p | (_n(x).parent_clr & black_bit);
+		}
+		// nil counts as black
+		bool _is_red(slot x) const {
+			return x != nil && !(_n(x).parent_clr & black_bit);
+		}
+		void _set_red(slot x) {
+			_n(x).parent_clr &= ~black_bit;
+		}
+		void _set_black(slot x) {
+			_n(x).parent_clr |= black_bit;
+		}
+		void _copy_colour(slot to, slot from) {
+			_n(to).parent_clr = (_n(to).parent_clr & ~black_bit) | (_n(from).parent_clr & black_bit);
+		}
+		void _reset() {
+			_arena.root = nil;
+			_arena.leftmost = nil;
+			_arena.rightmost = nil;
+		}
+		// moves the live values into a buffer of n slots; links are indices,
+		// so they are copied as they are
+		void _grow(size_type n) {
+			if (n > max_size())
+				throw std::length_error("arenaTree");
+			node_type* nodes = _nodeAlloc.allocate(n);
+			for (slot i = 0; i < _used; ++i) {
+				nodes[i].parent_clr = _n(i).parent_clr;
+				nodes[i].left = _n(i).left;
+				nodes[i].right = _n(i).right;
+				if (_n(i).parent_clr != free_mark) {
+					_allocator.construct(&nodes[i].val, std::move(_n(i).val));
+					_allocator.destroy(&_n(i).val);
+				}
+			}
+			if (_arena.nodes)
+				_nodeAlloc.deallocate(_arena.nodes, _cap);
+			_arena.nodes = nodes;
+			_cap = static_cast<slot>(n);
+		}
+		void _copy_slots(const arenaTree& other) {
+			if (other._used > _cap)
+				_grow(other._used);
+			for (; _used < other._used; ++_used) {
+				node_type& from = other._n(_used);
+				node_type& to = _n(_used);
+				if (from.parent_clr != free_mark)
+					_allocator.construct(&to.val, from.val);
+				to.parent_clr = from.parent_clr;
+				to.left = from.left;
+				to.right = from.right;
+			}
+			_free = other._free;
+			_size = other._size;
+			_arena.root = other._arena.root;
+			_arena.leftmost = other._arena.leftmost;
+			_arena.rightmost = other._arena.rightmost;
+		}
+		slot _allocate() {
+			if (_free != nil) {
+				slot x = _free;
+				_free = _n(x).left;
+				return x;
+			}
+			if (_used == _cap)
+				_grow(_cap ? size_type(_cap) * 2 : 16);
+			return _used++;
+		}
+		template<class... Args>
+		slot _create_node(Args&&... args) {
+			slot z = _allocate();
+			try {
+				_allocator.construct(&_n(z).val, std::forward<Args>(args)...);
+			}
+			catch (...) {
+				_n(z).parent_clr = free_mark;
+				_n(z).left = _free;
+				_free = z;
+				throw;
+			}
+			return z;
+		}
+		template<class K>
+		slot _lower_bound(const K& k) const {
+			slot x = _arena.root;
+			slot y = nil;
+			while (x != nil) {
+				if (!_comp(KeyOfValue()(_n(x).val), k))
+					y = x, x = _n(x).left;
+				else
+					x = _n(x).right;
+			}
+			return y;
+		}
+		template<class K>
+		slot _upper_bound(const K& k) const {
+			slot x = _arena.root;
+			slot y = nil;
+			while (x != nil) {
+				if (_comp(k, KeyOfValue()(_n(x).val)))
+					y = x, x = _n(x).left;
+				else
+					x = _n(x).right;
+			}
+			return y;
+		}
+		// one descent: returns the slot holding k, or nil with the attach
+		// point left in parent / insert_left
+		slot _locate_unique(const key_type& k, slot& parent, bool& insert_left) const {
+			slot x = _arena.root;
+			slot y = nil;
+			slot candidate = nil;
+			insert_left = true;
+			while (x != nil) {
+				y = x;
+				insert_left = !_comp(KeyOfValue()(_n(x).val), k);
+				if (insert_left)
+					candidate = x, x = _n(x).left;
+				else
+					x = _n(x).right;
+			}
+			if (candidate != nil && !_comp(k, KeyOfValue()(_n(candidate).val)))
+				return candidate;
+			parent = y;
+			return nil;
+		}
+		iterator _attach(slot z, slot parent, bool insert_left) {
+			_n(z).parent_clr = parent;
+			_n(z).left = nil;
+			_n(z).right = nil;
+			if (parent == nil) {
+				_arena.root = z;
+				_arena.leftmost = z;
+				_arena.rightmost = z;
+			}
+			else if (insert_left) {
+				_n(parent).left = z;
+				if (parent == _arena.leftmost)
+					_arena.leftmost = z;
+			}
+			else {
+				_n(parent).right = z;
+				if (parent == _arena.rightmost)
+					_arena.rightmost = z;
+			}
+			_insert_fixup(z);
+			++_size;
+			return iterator(&_arena, z);
+		}
+		void _rotate_left(slot x) {
+			slot y = _n(x).right;
+			_n(x).right = _n(y).left;
+			if (_n(y).left != nil)
+				_set_parent(_n(y).left, x);
+			_set_parent(y, _parent(x));
+			_replace_child(x, y);
+			_n(y).left = x;
+			_set_parent(x, y);
+		}
+		void _rotate_right(slot x) {
+			slot y = _n(x).left;
+			_n(x).left = _n(y).right;
+			if (_n(y).right != nil)
+				_set_parent(_n(y).right, x);
+			_set_parent(y, _parent(x));
+			_replace_child(x, y);
+			_n(y).right = x;
+			_set_parent(x, y);
+		}
+		// points whatever linked to x (its parent or the root) at y
+		void _replace_child(slot x, slot y) {
+			slot p = _parent(x);
+			if (x == _arena.root)
+				_arena.root = y;
+			else if (x == _n(p).left)
+				_n(p).left = y;
+			else
+				_n(p).right = y;
+		}
+		void _insert_fixup(slot x) {
+			while (x != _arena.root && _is_red(_parent(x))) {
+				slot xp = _parent(x);
+				slot xpp = _parent(xp);
+				if (xp == _n(xpp).left) {
+					slot y = _n(xpp).right;
+					if (_is_red(y)) {
+						_set_black(xp);
+						_set_black(y);
+						_set_red(xpp);
+						x = xpp;
+					}
+					else {
+						if (x == _n(xp).right) {
+							x = xp;
+							_rotate_left(x);
+							xp = _parent(x);
+						}
+						_set_black(xp);
+						_set_red(xpp);
+						_rotate_right(xpp);
+					}
+				}
+				else {
+					slot y = _n(xpp).left;
+					if (_is_red(y)) {
+						_set_black(xp);
+						_set_black(y);
+						_set_red(xpp);
+						x = xpp;
+					}
+					else {
+						if (x == _n(xp).left) {
+							x = xp;
+							_rotate_right(x);
+							xp = _parent(x);
+						}
+						_set_black(xp);
+						_set_red(xpp);
+						_rotate_left(xpp);
+					}
+				}
+			}
+			_set_black(_arena.root);
+		}
+		void _erase_slot(slot z) {
+			if (z == _arena.leftmost)
+				_arena.leftmost = _arena.next(z);
+			if (z == _arena.rightmost)
+				_arena.rightmost = _arena.prev(z);
+			slot y = z;
+			slot x;
+			slot xp;
+			if (_n(y).left == nil)
+				x = _n(y).right;
+			else if (_n(y).right == nil)
+				x = _n(y).left;
+			else {
+				y = _n(y).right;
+				while (_n(y).left != nil)
+					y = _n(y).left;
+				x = _n(y).right;
+			}
+			if (y == z) {
+				xp = _parent(z);
+				if (x != nil)
+					_set_parent(x, xp);
+				_replace_child(z, x);
+			}
+			else {
+				_set_parent(_n(z).left, y);
+				_n(y).left = _n(z).left;
+				if (y != _n(z).right) {
+					xp = _parent(y);
+					if (x != nil)
+						_set_parent(x, xp);
+					_n(xp).left = x;
+					_n(y).right = _n(z).right;
+					_set_parent(_n(z).right, y);
+				}
+				else
+					xp = y;
+				_replace_child(z, y);
+				_set_parent(y, _parent(z));
+				slot y_black = _n(y).parent_clr & black_bit;
+				_copy_colour(y, z);
+				_n(z).parent_clr = (_n(z).parent_clr & ~black_bit) | y_black;
+			}
+			if (!_is_red(z))
+				_erase_fixup(x, xp);
+			_allocator.destroy(&_n(z).val);
+			_n(z).parent_clr = free_mark;
+			_n(z).left = _free;
+			_free = z;
+			--_size;
+		}
+		void _erase_fixup(slot x, slot xp) {
+			while (x != _arena.root && !_is_red(x)) {
+				if (x == _n(xp).left) {
+					slot w = _n(xp).right;
+					if (_is_red(w)) {
+						_set_black(w);
+						_set_red(xp);
+						_rotate_left(xp);
+						w = _n(xp).right;
+					}
+					if (!_is_red(_n(w).left) && !_is_red(_n(w).right)) {
+						_set_red(w);
+						x = xp;
+						xp = _parent(xp);
+					}
+					else {
+						if (!_is_red(_n(w).right)) {
+							_set_black(_n(w).left);
+							_set_red(w);
+							_rotate_right(w);
+							w = _n(xp).right;
+						}
+						_copy_colour(w, xp);
+						_set_black(xp);
+						if (_n(w).right != nil)
+							_set_black(_n(w).right);
+						_rotate_left(xp);
+						break;
+					}
+				}
+				else {
+					slot w = _n(xp).left;
+					if (_is_red(w)) {
+						_set_black(w);
+						_set_red(xp);
+						_rotate_right(xp);
+						w = _n(xp).left;
+					}
+					if (!_is_red(_n(w).right) && !_is_red(_n(w).left)) {
+						_set_red(w);
+						x = xp;
+						xp = _parent(xp);
+					}
+					else {
+						if (!_is_red(_n(w).left)) {
+							_set_black(_n(w).right);
+							_set_red(w);
+							_rotate_left(w);
+							w = _n(xp).left;
+						}
+						_copy_colour(w, xp);
+						_set_black(xp);
+						if (_n(w).left != nil)
+							_set_black(_n(w).left);
+						_rotate_right(xp);
+						break;
+					}
+				}
+			}
+			if (x != nil)
+				_set_black(x);
+		}
+	};
+	template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+	inline bool operator==(const arenaTree<Key, Val, KeyOfValue, Compare, Alloc>& x, const arenaTree<Key, Val, KeyOfValue, Compare, Alloc>& y) {
+		return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
+	}
+	template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+	inline bool operator<(const arenaTree<Key, Val, KeyOfValue, Compare, Alloc>& x, const arenaTree<Key, Val, KeyOfValue, Compare, Alloc>& y) {
+		return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+	}
+	template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+	inline void swap(arenaTree<Key, Val, KeyOfValue, Compare, Alloc>& x, arenaTree<Key, Val, KeyOfValue, Compare, Alloc>& y) {
+		x.swap(y);
+	}
+}
+
+#endif
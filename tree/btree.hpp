@@ -0,0 +1,942 @@
+#ifndef BTREE_HPP
+#define BTREE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "../utility/algorithm.hpp"
+#include "../utility/sorted_unique.hpp"
+#include "../iterator/reverse_iterator.hpp"
+#include "pair.hpp"
+
+namespace ft {
+	struct btreeNodeBase {
+		unsigned short	count;
+		bool			leaf;
+	};
+
+	// Values live only in the leaves, which are chained in key order.
+	template <typename Val, std::size_t N>
+	struct btreeLeaf : btreeNodeBase {
+		btreeLeaf*	prev;
+		btreeLeaf*	next;
+		typename std::aligned_storage<sizeof(Val), alignof(Val)>::type	slots[N];
+
+		Val* value(std::size_t i) {
+			return reinterpret_cast<Val*>(&slots[i]);
+		}
+	};
+
+	// child[i] holds the keys in [key(i - 1), key(i)). Separators are copies
+	// and may outlive the element they were taken from.
+	template <typename Key, std::size_t N>
+	struct btreeInner : btreeNodeBase {
+		typename std::aligned_storage<sizeof(Key), alignof(Key)>::type	keys[N];
+		btreeNodeBase*	child[N + 1];
+
+		Key* key(std::size_t i) {
+			return reinterpret_cast<Key*>(&keys[i]);
+		}
+	};
+
+	template <typename Leaf>
+	struct btreeBase {
+		btreeNodeBase*	root;
+		Leaf*			leftmost;
+		Leaf*			rightmost;
+	};
+
+	// An iterator is a leaf and a slot in it; end() has no leaf and keeps
+	// the tree so that it can step back to the last element.
+	template <typename T, typename Leaf>
+	class btree_iterator {
+	public:
+		typedef T								value_type;
+		typedef T&								reference;
+		typedef T*								pointer;
+		typedef std::bidirectional_iterator_tag	iterator_category;
+		typedef std::ptrdiff_t					difference_type;
+		typedef btree_iterator<T, Leaf>			iterator;
+
+		btree_iterator() : tree(), leaf(), pos() {}
+		btree_iterator(const btreeBase<Leaf>* t, Leaf* l, unsigned p) : tree(t), leaf(l), pos(p) {}
+
+		reference operator*() const {
+			return *leaf->value(pos);
+		}
+		pointer operator->() const {
+			return leaf->value(pos);
+		}
+		iterator& operator++() {
+			if (++pos == leaf->count) {
+				leaf = leaf->next;
+				pos = 0;
+			}
+			return *this;
+		}
+		iterator operator++(int) {
+			iterator tmp = *this;
+			++*this;
+			return tmp;
+		}
+		iterator& operator--() {
+			if (leaf == 0) {
+				leaf = tree->rightmost;
+				pos = leaf->count;
+			}
+			else if (pos == 0) {
+				leaf = leaf->prev;
+				pos = leaf->count;
+			}
+			--pos;
+			return *this;
+		}
+		iterator operator--(int) {
+			iterator tmp = *this;
+			--*this;
+			return tmp;
+		}
+		bool operator==(const iterator& x) const {
+			return leaf == x.leaf && pos == x.pos;
+		}
+		bool operator!=(const iterator& x) const {
+			return !(*this == x);
+		}
+
+		const btreeBase<Leaf>*	tree;
+		Leaf*					leaf;
+		unsigned				pos;
+	};
+	template <typename T, typename Leaf>
+	class btree_const_iterator {
+	public:
+		typedef T								value_type;
+		typedef const T&						reference;
+		typedef const T*						pointer;
+		typedef std::bidirectional_iterator_tag	iterator_category;
+		typedef std::ptrdiff_t					difference_type;
+		typedef btree_const_iterator<T, Leaf>	iterator;
+
+		btree_const_iterator() : tree(), leaf(), pos() {}
+		btree_const_iterator(const btreeBase<Leaf>* t, Leaf* l, unsigned p) : tree(t), leaf(l), pos(p) {}
+		btree_const_iterator(const btree_iterator<T, Leaf>& it) : tree(it.tree), leaf(it.leaf), pos(it.pos) {}
+
+		reference operator*() const {
+			return *leaf->value(pos);
+		}
+		pointer operator->() const {
+			return leaf->value(pos);
+		}
+		iterator& operator++() {
+			if (++pos == leaf->count) {
+				leaf = leaf->next;
+				pos = 0;
+			}
+			return *this;
+		}
+		iterator operator++(int) {
+			iterator tmp = *this;
+			++*this;
+			return tmp;
+		}
+		iterator& operator--() {
+			if (leaf == 0) {
+				leaf = tree->rightmost;
+				pos = leaf->count;
+			}
+			else if (pos == 0) {
+				leaf = leaf->prev;
+				pos = leaf->count;
+			}
+			--pos;
+			return *this;
+		}
+		iterator operator--(int) {
+			iterator tmp = *this;
+			--*this;
+			return tmp;
+		}
+		bool operator==(const iterator& x) const {
+			return leaf == x.leaf && pos == x.pos;
+		}
+		bool operator!=(const iterator& x) const {
+			return !(*this == x);
+		}
+
+		const btreeBase<Leaf>*	tree;
+		Leaf*					leaf;
+		unsigned				pos;
+	};
+
+	template <typename T, typename Leaf>
+	inline bool operator==(const btree_iterator<T, Leaf>& x, const btree_const_iterator<T, Leaf>& y) {
+		return x.leaf == y.leaf && x.pos == y.pos;
+	}
+	template <typename T, typename Leaf>
+	inline bool operator!=(const btree_iterator<T, Leaf>& x, const btree_const_iterator<T, Leaf>& y) {
+		return !(x == y);
+	}
+
+	// elements move between nodes, so there are no node handles
+	struct btree_no_node_handle;
+
+	// B+-tree with nodes of about NodeBytes bytes: a lookup touches one
+	// node per level instead of one per red-black level. Inserting and
+	// erasing shift elements inside nodes, so unlike rbTree they invalidate
+	// iterators to other elements; erase(first, last) accounts for that.
+	// Appending at the end splits so that the left node stays full, which
+	// packs sorted input densely.
+	template<typename Key, typename Val, typename KeyOfValue, typename Compare = std::less<Key>,
+		typename Alloc = std::allocator<Val>, std::size_t NodeBytes = 256>
+	class bTree {
+		static const std::size_t leaf_header = sizeof(btreeLeaf<Val, 1>) - sizeof(Val);
+		static const std::size_t inner_header = sizeof(btreeInner<Key, 1>) - sizeof(Key) - 2 * sizeof(void*);
+		static const std::size_t leaf_slots = NodeBytes >= leaf_header + 4 * sizeof(Val)
+			? (NodeBytes - leaf_header) / sizeof(Val) : 4;
+		static const std::size_t inner_slots = NodeBytes >= inner_header + 4 * (sizeof(Key) + sizeof(void*))
+			? (NodeBytes - inner_header) / (sizeof(Key) + sizeof(void*)) : 4;
+		// non-root nodes below these are rebalanced on erase
+		static const std::size_t min_leaf = leaf_slots / 2;
+		static const std::size_t min_inner = (inner_slots - 1) / 2;
+		static const std::size_t max_depth = 64;
+
+		typedef btreeLeaf<Val, leaf_slots>								leaf_type;
+		typedef btreeInner<Key, inner_slots>							inner_type;
+		typedef typename Alloc::template rebind<leaf_type>::other		leaf_allocator;
+		typedef typename Alloc::template rebind<inner_type>::other		inner_allocator;
+		typedef typename Alloc::template rebind<Key>::other				key_allocator;
+
+		// inner nodes from the root down to a leaf and the child taken in each
+		struct path {
+			inner_type*		node[max_depth];
+			unsigned short	idx[max_depth];
+			unsigned		depth;
+		};
+	public:
+
+		typedef Val										value_type;
+		typedef Compare									value_compare;
+		typedef Alloc									allocator_type;
+		typedef Key										key_type;
+		typedef value_type*								pointer;
+		typedef const value_type*						const_pointer;
+		typedef value_type&								reference;
+		typedef const value_type&						const_reference;
+		typedef std::size_t								size_type;
+		typedef std::ptrdiff_t							difference_type;
+		typedef btree_iterator<value_type, leaf_type>			iterator;
+		typedef btree_const_iterator<value_type, leaf_type>		const_iterator;
+		typedef ft::reverse_iterator<iterator>			reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>	const_reverse_iterator;
+		typedef btree_no_node_handle					node_handle;
+		typedef btree_no_node_handle					insert_return_type;
+
+		bTree() : _base(), _size(0), _allocator(), _leafAlloc(), _innerAlloc(), _keyAlloc(), _comp() {}
+		bTree(const Compare& comp, const allocator_type& a = allocator_type()) : _base(), _size(0),
+				_allocator(a), _leafAlloc(a), _innerAlloc(a), _keyAlloc(a), _comp(comp) {}
+		bTree(const bTree& other) : _base(), _size(0), _allocator(other._allocator), _leafAlloc(other._leafAlloc),
+				_innerAlloc(other._innerAlloc), _keyAlloc(other._keyAlloc), _comp(other._comp) {
+			_copy(other);
+		}
+		bTree& operator=(const bTree& other) {
+			if (this != &other) {
+				clear();
+				_comp = other._comp;
+				_copy(other);
+			}
+			return *this;
+		}
+		~bTree() {
+			clear();
+		}
+		iterator begin() {
+			return iterator(&_base, _base.leftmost, 0);
+		}
+		const_iterator begin() const {
+			return const_iterator(&_base, _base.leftmost, 0);
+		}
+		void clear() {
+			if (_base.root)
+				_destroy(_base.root);
+			_base.root = 0;
+			_base.leftmost = 0;
+			_base.rightmost = 0;
+			_size = 0;
+		}
+		template<class K>
+		size_type count(const K& k) const {
+			return find(k) == end() ? 0 : 1;
+		}
+		bool empty() const {
+			return _size == 0;
+		}
+		iterator end() {
+			return iterator(&_base, 0, 0);
+		}
+		const_iterator end() const {
+			return const_iterator(&_base, 0, 0);
+		}
+		template<class K>
+		ft::pair<iterator, iterator> equal_range(const K& k) {
+			return ft::pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+		}
+		template<class K>
+		ft::pair<const_iterator, const_iterator> equal_range(const K& k) const {
+			return ft::pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+		}
+		// erasing moves the values after it in the leaf, so the successor
+		// comes back from the erase rather than from the old iterator
+		iterator erase(iterator position) {
+			return _erase(position);
+		}
+		// each erase may move the rest of the range, so follow the successor
+		void erase(iterator first, iterator last) {
+			if (first == begin() && last == end()) {
+				clear();
+				return;
+			}
+			size_type n = 0;
+			for (iterator it = first; it != last; ++it)
+				++n;
+			while (n--)
+				first = _erase(first);
+		}
+		size_type erase(const key_type& k) {
+			iterator it = find(k);
+			if (it == end())
+				return 0;
+			_erase(it);
+			return 1;
+		}
+		template<class K>
+		iterator find(const K& k) {
+			iterator j = lower_bound(k);
+			return (j == end() || _comp(k, KeyOfValue()(*j))) ? end() : j;
+		}
+		template<class K>
+		const_iterator find(const K& k) const {
+			const_iterator j = lower_bound(k);
+			return (j == end() || _comp(k, KeyOfValue()(*j))) ? end() : j;
+		}
+		allocator_type get_allocator() const {
+			return _allocator;
+		}
+		ft::pair<iterator, bool> insert(const value_type& val) {
+			return _insert_unique(KeyOfValue()(val), val);
+		}
+		// only the append-at-the-end hint is used, which makes sorted input cheap
+		iterator insert(const_iterator position, const value_type& val) {
+			if (position == end() && _size > 0
+					&& _comp(KeyOfValue()(*_base.rightmost->value(_base.rightmost->count - 1)), KeyOfValue()(val))) {
+				path p;
+				_descend_last(p);
+				return _insert_at(p, _base.rightmost, _base.rightmost->count, val);
+			}
+			return insert(val).first;
+		}
+		template<class It>
+		void insert(It first, It last) {
+			for (; first != last; ++first)
+				insert(end(), *first);
+		}
+		template<class It>
+		void insert(ft::sorted_unique_t, It first, It last) {
+			for (; first != last; ++first)
+				insert(end(), *first);
+		}
+		// map only: assigns to the mapped value when k is present
+		template<class M>
+		ft::pair<iterator, bool> insert_or_assign(const key_type& k, M&& obj) {
+			if (_base.root) {
+				path p;
+				leaf_type* leaf = _descend(k, &p);
+				unsigned pos = _leaf_lower(leaf, k);
+				if (pos < leaf->count && !_comp(k, _key(leaf, pos))) {
+					leaf->value(pos)->second = std::forward<M>(obj);
+					return ft::pair<iterator, bool>(iterator(&_base, leaf, pos), false);
+				}
+				return ft::pair<iterator, bool>(_insert_at(p, leaf, pos, k, std::forward<M>(obj)), true);
+			}
+			path p;
+			p.depth = 0;
+			return ft::pair<iterator, bool>(_insert_at(p, 0, 0, k, std::forward<M>(obj)), true);
+		}
+		Compare key_comp() const {
+			return _comp;
+		}
+		template<class K>
+		iterator lower_bound(const K& k) {
+			if (!_base.root)
+				return end();
+			leaf_type* leaf = _descend(k, 0);
+			return _normalize(leaf, _leaf_lower(leaf, k));
+		}
+		template<class K>
+		const_iterator lower_bound(const K& k) const {
+			return const_cast<bTree*>(this)->lower_bound(k);
+		}
+		size_type max_size() const {
+			return _allocator.max_size();
+		}
+		reverse_iterator rbegin() {
+			return reverse_iterator(end());
+		}
+		const_reverse_iterator rbegin() const {
+			return const_reverse_iterator(end());
+		}
+		reverse_iterator rend() {
+			return reverse_iterator(begin());
+		}
+		const_reverse_iterator rend() const {
+			return const_reverse_iterator(begin());
+		}
+		size_type size() const {
+			return _size;
+		}
+		void swap(bTree& other) {
+			std::swap(_base, other._base);
+			std::swap(_size, other._size);
+			std::swap(_leafAlloc, other._leafAlloc);
+			std::swap(_innerAlloc, other._innerAlloc);
+			std::swap(_keyAlloc, other._keyAlloc);
+			std::swap(_comp, other._comp);
+		}
+		// map only: the mapped value is built from args only when k is absent
+		template<class... Args>
+		ft::pair<iterator, bool> try_emplace(const key_type& k, Args&&... args) {
+			path p;
+			p.depth = 0;
+			leaf_type* leaf = 0;
+			unsigned pos = 0;
+			if (_base.root) {
+				leaf = _descend(k, &p);
+				pos = _leaf_lower(leaf, k);
+				if (pos < leaf->count && !_comp(k, _key(leaf, pos)))
+					return ft::pair<iterator, bool>(iterator(&_base, leaf, pos), false);
+			}
+			return ft::pair<iterator, bool>(_insert_at(p, leaf, pos, ft::emplace_second, k, std::forward<Args>(args)...), true);
+		}
+		template<class K>
+		iterator upper_bound(const K& k) {
+			if (!_base.root)
+				return end();
+			leaf_type* leaf = _descend(k, 0);
+			return _normalize(leaf, _leaf_upper(leaf, k));
+		}
+		template<class K>
+		const_iterator upper_bound(const K& k) const {
+			return const_cast<bTree*>(this)->upper_bound(k);
+		}
+	private:
+		btreeBase<leaf_type>	_base;
+		size_type				_size;
+		allocator_type			_allocator;
+		leaf_allocator			_leafAlloc;
+		inner_allocator			_innerAlloc;
+		key_allocator			_keyAlloc;
+		Compare					_comp;
+
+		static const key_type& _key(leaf_type* leaf, std::size_t i) {
+			return KeyOfValue()(*leaf->value(i));
+		}
+		iterator _normalize(leaf_type* leaf, unsigned pos) {
+			if (pos == leaf->count)
+				return iterator(&_base, leaf->next, 0);
+			return iterator(&_base, leaf, pos);
+		}
+		template<class K>
+		unsigned _leaf_lower(leaf_type* leaf, const K& k) const {
+			unsigned lo = 0;
+			unsigned hi = leaf->count;
+			while (lo < hi) {
+				unsigned mid = (lo + hi) / 2;
+				if (_comp(_key(leaf, mid), k))
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+			return lo;
+		}
+		template<class K>
+		unsigned _leaf_upper(leaf_type* leaf, const K& k) const {
+			unsigned lo = 0;
+			unsigned hi = leaf->count;
+			while (lo < hi) {
+				unsigned mid = (lo + hi) / 2;
+				if (_comp(k, _key(leaf, mid)))
+					hi = mid;
+				else
+					lo = mid + 1;
+			}
+			return lo;
+		}
+		template<class K>
+		unsigned _inner_upper(inner_type* n, const K& k) const {
+			unsigned lo = 0;
+			unsigned hi = n->count;
+			while (lo < hi) {
+				unsigned mid = (lo + hi) / 2;
+				if (_comp(k, *n->key(mid)))
+					hi = mid;
+				else
+					lo = mid + 1;
+			}
+			return lo;
+		}
+		// the leaf that holds k if it is present; records the way down in p
+		template<class K>
+		leaf_type* _descend(const K& k, path* p) const {
+			btreeNodeBase* x = _base.root;
+			unsigned d = 0;
+			while (!x->leaf) {
+				inner_type* n = static_cast<inner_type*>(x);
+				unsigned i = _inner_upper(n, k);
+				if (p) {
+					p->node[d] = n;
+					p->idx[d] = i;
+				}
+				++d;
+				x = n->child[i];
+			}
+			if (p)
+				p->depth = d;
+			return static_cast<leaf_type*>(x);
+		}
+		void _descend_last(path& p) const {
+			btreeNodeBase* x = _base.root;
+			p.depth = 0;
+			while (!x->leaf) {
+				inner_type* n = static_cast<inner_type*>(x);
+				p.node[p.depth] = n;
+				p.idx[p.depth++] = n->count;
+				x = n->child[n->count];
+			}
+		}
+
+		leaf_type* _new_leaf() {
+			leaf_type* leaf = _leafAlloc.allocate(1);
+			leaf->count = 0;
+			leaf->leaf = true;
+			leaf->prev = 0;
+			leaf->next = 0;
+			return leaf;
+		}
+		inner_type* _new_inner() {
+			inner_type* n = _innerAlloc.allocate(1);
+			n->count = 0;
+			n->leaf = false;
+			return n;
+		}
+		void _destroy(btreeNodeBase* x) {
+			if (x->leaf) {
+				leaf_type* leaf = static_cast<leaf_type*>(x);
+				for (unsigned i = 0; i < leaf->count; ++i)
+					_allocator.destroy(leaf->value(i));
+				_leafAlloc.deallocate(leaf, 1);
+				return;
+			}
+			inner_type* n = static_cast<inner_type*>(x);
+			for (unsigned i = 0; i <= n->count; ++i)
+				_destroy(n->child[i]);
+			for (unsigned i = 0; i < n->count; ++i)
+				_keyAlloc.destroy(n->key(i));
+			_innerAlloc.deallocate(n, 1);
+		}
+		void _copy(const bTree& other) {
+			if (!other._base.root)
+				return;
+			leaf_type* last = 0;
+			_base.root = _clone(other._base.root, last);
+			_base.rightmost = last;
+			_size = other._size;
+		}
+		// copies the subtree and threads its leaves after last
+		btreeNodeBase* _clone(btreeNodeBase* x, leaf_type*& last) {
+			if (x->leaf) {
+				leaf_type* from = static_cast<leaf_type*>(x);
+				leaf_type* leaf = _new_leaf();
+				for (; leaf->count < from->count; ++leaf->count)
+					_allocator.construct(leaf->value(leaf->count), *from->value(leaf->count));
+				leaf->prev = last;
+				if (last)
+					last->next = leaf;
+				else
+					_base.leftmost = leaf;
+				last = leaf;
+				return leaf;
+			}
+			inner_type* from = static_cast<inner_type*>(x);
+			inner_type* n = _new_inner();
+			n->child[0] = _clone(from->child[0], last);
+			for (; n->count < from->count; ++n->count) {
+				_keyAlloc.construct(n->key(n->count), *from->key(n->count));
+				n->child[n->count + 1] = _clone(from->child[n->count + 1], last);
+			}
+			return n;
+		}
+
+		// moves n values between slots, which may overlap within one leaf
+		void _move_values(leaf_type* to, unsigned to_pos, leaf_type* from, unsigned from_pos, unsigned n) {
+			if (to == from && to_pos > from_pos) {
+				while (n--) {
+					_allocator.construct(to->value(to_pos + n), std::move(*from->value(from_pos + n)));
+					_allocator.destroy(from->value(from_pos + n));
+				}
+				return;
+			}
+			for (unsigned i = 0; i < n; ++i) {
+				_allocator.construct(to->value(to_pos + i), std::move(*from->value(from_pos + i)));
+				_allocator.destroy(from->value(from_pos + i));
+			}
+		}
+		void _move_keys(inner_type* to, unsigned to_pos, inner_type* from, unsigned from_pos, unsigned n) {
+			if (to == from && to_pos > from_pos) {
+				while (n--) {
+					_keyAlloc.construct(to->key(to_pos + n), std::move(*from->key(from_pos + n)));
+					_keyAlloc.destroy(from->key(from_pos + n));
+				}
+				return;
+			}
+			for (unsigned i = 0; i < n; ++i) {
+				_keyAlloc.construct(to->key(to_pos + i), std::move(*from->key(from_pos + i)));
+				_keyAlloc.destroy(from->key(from_pos + i));
+			}
+		}
+		void _set_key(inner_type* n, unsigned i, const key_type& k) {
+			_keyAlloc.destroy(n->key(i));
+			_keyAlloc.construct(n->key(i), k);
+		}
+		// adds separator k at i with child on its right
+		void _inner_insert(inner_type* n, unsigned i, const key_type& k, btreeNodeBase* child) {
+			_move_keys(n, i + 1, n, i, n->count - i);
+			std::copy_backward(n->child + i + 1, n->child + n->count + 1, n->child + n->count + 2);
+			_keyAlloc.construct(n->key(i), k);
+			n->child[i + 1] = child;
+			++n->count;
+		}
+		// drops the already destroyed separator i and the child on its right
+		void _inner_close(inner_type* n, unsigned i) {
+			_move_keys(n, i, n, i + 1, n->count - i - 1);
+			std::copy(n->child + i + 2, n->child + n->count + 1, n->child + i + 1);
+			--n->count;
+		}
+		void _unlink_leaf(leaf_type* leaf) {
+			if (leaf->prev)
+				leaf->prev->next = leaf->next;
+			else
+				_base.leftmost = leaf->next;
+			if (leaf->next)
+				leaf->next->prev = leaf->prev;
+			else
+				_base.rightmost = leaf->prev;
+		}
+
+		template<class... Args>
+		ft::pair<iterator, bool> _insert_unique(const key_type& k, Args&&... args) {
+			path p;
+			p.depth = 0;
+			leaf_type* leaf = 0;
+			unsigned pos = 0;
+			if (_base.root) {
+				leaf = _descend(k, &p);
+				pos = _leaf_lower(leaf, k);
+				if (pos < leaf->count && !_comp(k, _key(leaf, pos)))
+					return ft::pair<iterator, bool>(iterator(&_base, leaf, pos), false);
+			}
+			return ft::pair<iterator, bool>(_insert_at(p, leaf, pos, std::forward<Args>(args)...), true);
+		}
+		// Builds the value at pos in leaf, splitting full nodes on the way up.
+		// Every allocation happens before the tree is touched.
+		template<class... Args>
+		iterator _insert_at(path& p, leaf_type* leaf, unsigned pos, Args&&... args) {
+			if (!leaf) {
+				leaf = _new_leaf();
+				try {
+					_allocator.construct(leaf->value(0), std::forward<Args>(args)...);
+				}
+				catch (...) {
+					_leafAlloc.deallocate(leaf, 1);
+					throw;
+				}
+				leaf->count = 1;
+				_base.root = leaf;
+				_base.leftmost = leaf;
+				_base.rightmost = leaf;
+				_size = 1;
+				return iterator(&_base, leaf, 0);
+			}
+			if (leaf->count < leaf_slots) {
+				_move_values(leaf, pos + 1, leaf, pos, leaf->count - pos);
+				try {
+					_allocator.construct(leaf->value(pos), std::forward<Args>(args)...);
+				}
+				catch (...) {
+					_move_values(leaf, pos, leaf, pos + 1, leaf->count - pos);
+					throw;
+				}
+				++leaf->count;
+				++_size;
+				return iterator(&_base, leaf, pos);
+			}
+			typename std::aligned_storage<sizeof(Val), alignof(Val)>::type buf;
+			value_type* v = reinterpret_cast<value_type*>(&buf);
+			_allocator.construct(v, std::forward<Args>(args)...);
+			unsigned l = p.depth;
+			while (l > 0 && p.node[l - 1]->count == inner_slots)
+				--l;
+			inner_type* spare[max_depth + 1];
+			unsigned spares = 0;
+			unsigned needed = p.depth - l + (l == 0);
+			leaf_type* fresh = 0;
+			try {
+				fresh = _new_leaf();
+				for (; spares < needed; ++spares)
+					spare[spares] = _new_inner();
+			}
+			catch (...) {
+				_allocator.destroy(v);
+				if (fresh)
+					_leafAlloc.deallocate(fresh, 1);
+				while (spares)
+					_innerAlloc.deallocate(spare[--spares], 1);
+				throw;
+			}
+			bool append = leaf == _base.rightmost && pos == leaf->count;
+			if (!append) {
+				unsigned s = (leaf_slots + 1) / 2;
+				_move_values(fresh, 0, leaf, s, leaf_slots - s);
+				fresh->count = leaf_slots - s;
+				leaf->count = s;
+			}
+			fresh->prev = leaf;
+			fresh->next = leaf->next;
+			if (leaf->next)
+				leaf->next->prev = fresh;
+			else
+				_base.rightmost = fresh;
+			leaf->next = fresh;
+			if (pos >= leaf->count) {
+				pos -= leaf->count;
+				leaf = fresh;
+			}
+			_move_values(leaf, pos + 1, leaf, pos, leaf->count - pos);
+			_allocator.construct(leaf->value(pos), std::move(*v));
+			_allocator.destroy(v);
+			++leaf->count;
+			++_size;
+			_insert_split(p, fresh, spare, spares, append);
+			return iterator(&_base, leaf, pos);
+		}
+		// hands the new right sibling up the path; spare holds one node for
+		// every level that splits
+		void _insert_split(path& p, leaf_type* fresh, inner_type** spare, unsigned spares, bool append) {
+			typename std::aligned_storage<sizeof(Key), alignof(Key)>::type buf[2];
+			key_type* held = 0;
+			const key_type* sep = &_key(fresh, 0);
+			btreeNodeBase* right = fresh;
+			for (unsigned l = p.depth; l-- > 0; ) {
+				inner_type* n = p.node[l];
+				unsigned i = p.idx[l];
+				if (n->count < inner_slots) {
+					_inner_insert(n, i, *sep, right);
+					if (held)
+						_keyAlloc.destroy(held);
+					return;
+				}
+				inner_type* sibling = spare[--spares];
+				key_type* up = reinterpret_cast<key_type*>(&buf[held == reinterpret_cast<key_type*>(&buf[0])]);
+				if (append) {
+					// the left node stays full; the new one starts with its last child
+					_keyAlloc.construct(up, std::move(*n->key(inner_slots - 1)));
+					_keyAlloc.destroy(n->key(inner_slots - 1));
+					n->count = inner_slots - 1;
+					sibling->child[0] = n->child[inner_slots];
+					_keyAlloc.construct(sibling->key(0), *sep);
+					sibling->child[1] = right;
+					sibling->count = 1;
+				}
+				else {
+					unsigned mid = inner_slots / 2;
+					_keyAlloc.construct(up, std::move(*n->key(mid)));
+					_keyAlloc.destroy(n->key(mid));
+					_move_keys(sibling, 0, n, mid + 1, inner_slots - mid - 1);
+					std::copy(n->child + mid + 1, n->child + inner_slots + 1, sibling->child);
+					sibling->count = inner_slots - mid - 1;
+					n->count = mid;
+					if (i <= mid)
+						_inner_insert(n, i, *sep, right);
+					else
+						_inner_insert(sibling, i - mid - 1, *sep, right);
+				}
+				if (held)
+					_keyAlloc.destroy(held);
+				held = up;
+				sep = up;
+				right = sibling;
+			}
+			inner_type* root = spare[--spares];
+			_keyAlloc.construct(root->key(0), *sep);
+			root->child[0] = _base.root;
+			root->child[1] = right;
+			root->count = 1;
+			_base.root = root;
+			if (held)
+				_keyAlloc.destroy(held);
+		}
+
+		iterator _erase(iterator position) {
+			path p;
+			_descend(KeyOfValue()(*position), &p);
+			return _erase_at(p, position.leaf, position.pos);
+		}
+		// removes one value and returns where its successor ended up
+		iterator _erase_at(path& p, leaf_type* leaf, unsigned pos) {
+			_allocator.destroy(leaf->value(pos));
+			_move_values(leaf, pos, leaf, pos + 1, leaf->count - pos - 1);
+			--leaf->count;
+			--_size;
+			leaf_type* next = leaf;
+			unsigned next_pos = pos;
+			if (next_pos == leaf->count) {
+				next = leaf->next;
+				next_pos = 0;
+			}
+			if (p.depth == 0) {
+				if (leaf->count == 0) {
+					_leafAlloc.deallocate(leaf, 1);
+					_base.root = 0;
+					_base.leftmost = 0;
+					_base.rightmost = 0;
+				}
+			}
+			else if (leaf->count < min_leaf)
+				_rebalance_leaf(p, leaf, next, next_pos);
+			return iterator(&_base, next, next_pos);
+		}
+		// borrows from or merges with a sibling, keeping next/next_pos on the same value
+		void _rebalance_leaf(path& p, leaf_type* leaf, leaf_type*& next, unsigned& next_pos) {
+			inner_type* parent = p.node[p.depth - 1];
+			unsigned i = p.idx[p.depth - 1];
+			leaf_type* left = i > 0 ? static_cast<leaf_type*>(parent->child[i - 1]) : 0;
+			leaf_type* right = i < parent->count ? static_cast<leaf_type*>(parent->child[i + 1]) : 0;
+			if (left && left->count > min_leaf) {
+				_move_values(leaf, 1, leaf, 0, leaf->count);
+				_move_values(leaf, 0, left, left->count - 1, 1);
+				--left->count;
+				++leaf->count;
+				_set_key(parent, i - 1, _key(leaf, 0));
+				if (next == leaf)
+					++next_pos;
+				return;
+			}
+			if (right && right->count > min_leaf) {
+				_move_values(leaf, leaf->count, right, 0, 1);
+				++leaf->count;
+				_move_values(right, 0, right, 1, right->count - 1);
+				--right->count;
+				_set_key(parent, i, _key(right, 0));
+				if (next == right) {
+					next = leaf;
+					next_pos = leaf->count - 1;
+				}
+				return;
+			}
+			if (left) {
+				if (next == leaf) {
+					next = left;
+					next_pos += left->count;
+				}
+				_move_values(left, left->count, leaf, 0, leaf->count);
+				left->count += leaf->count;
+				_unlink_leaf(leaf);
+				_leafAlloc.deallocate(leaf, 1);
+				_keyAlloc.destroy(parent->key(i - 1));
+				_inner_close(parent, i - 1);
+			}
+			else {
+				if (next == right) {
+					next = leaf;
+					next_pos += leaf->count;
+				}
+				_move_values(leaf, leaf->count, right, 0, right->count);
+				leaf->count += right->count;
+				_unlink_leaf(right);
+				_leafAlloc.deallocate(right, 1);
+				_keyAlloc.destroy(parent->key(i));
+				_inner_close(parent, i);
+			}
+			_rebalance_inner(p, p.depth - 1);
+		}
+		void _rebalance_inner(path& p, unsigned l) {
+			for (;; --l) {
+				inner_type* n = p.node[l];
+				if (l == 0) {
+					if (n->count == 0) {
+						_base.root = n->child[0];
+						_innerAlloc.deallocate(n, 1);
+					}
+					return;
+				}
+				if (n->count >= min_inner)
+					return;
+				inner_type* parent = p.node[l - 1];
+				unsigned i = p.idx[l - 1];
+				inner_type* left = i > 0 ? static_cast<inner_type*>(parent->child[i - 1]) : 0;
+				inner_type* right = i < parent->count ? static_cast<inner_type*>(parent->child[i + 1]) : 0;
+				if (left && left->count > min_inner) {
+					_move_keys(n, 1, n, 0, n->count);
+					std::copy_backward(n->child, n->child + n->count + 1, n->child + n->count + 2);
+					_move_keys(n, 0, parent, i - 1, 1);
+					n->child[0] = left->child[left->count];
+					_move_keys(parent, i - 1, left, left->count - 1, 1);
+					--left->count;
+					++n->count;
+					return;
+				}
+				if (right && right->count > min_inner) {
+					_move_keys(n, n->count, parent, i, 1);
+					n->child[n->count + 1] = right->child[0];
+					++n->count;
+					_move_keys(parent, i, right, 0, 1);
+					_move_keys(right, 0, right, 1, right->count - 1);
+					std::copy(right->child + 1, right->child + right->count + 1, right->child);
+					--right->count;
+					return;
+				}
+				if (left)
+					_merge_inner(left, n, parent, i - 1);
+				else
+					_merge_inner(n, right, parent, i);
+			}
+		}
+		// appends separator k of parent and all of right to left, then frees right
+		void _merge_inner(inner_type* left, inner_type* right, inner_type* parent, unsigned k) {
+			_move_keys(left, left->count, parent, k, 1);
+			_move_keys(left, left->count + 1, right, 0, right->count);
+			std::copy(right->child, right->child + right->count + 1, left->child + left->count + 1);
+			left->count += right->count + 1;
+			_innerAlloc.deallocate(right, 1);
+			_inner_close(parent, k);
+		}
+	};
+	template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, std::size_t NodeBytes>
+	inline bool operator==(const bTree<Key, Val, KeyOfValue, Compare, Alloc, NodeBytes>& x,
+						   const bTree<Key, Val, KeyOfValue, Compare, Alloc, NodeBytes>& y) {
+		return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
+	}
+	template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, std::size_t NodeBytes>
+	inline bool operator<(const bTree<Key, Val, KeyOfValue, Compare, Alloc, NodeBytes>& x,
+						  const bTree<Key, Val, KeyOfValue, Compare, Alloc, NodeBytes>& y) {
+		return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+	}
+	template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, std::size_t NodeBytes>
+	inline void swap(bTree<Key, Val, KeyOfValue, Compare, Alloc, NodeBytes>& x,
+					 bTree<Key, Val, KeyOfValue, Compare, Alloc, NodeBytes>& y) {
+		x.swap(y);
+	}
+}
+
+#endif
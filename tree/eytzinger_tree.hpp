@@ -0,0 +1,278 @@
+#ifndef EYTZINGER_TREE_HPP
+#define EYTZINGER_TREE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include "../utility/algorithm.hpp"
+#include "../vector/vector.hpp"
+#include "../iterator/reverse_iterator.hpp"
+#include "frozen_staging.hpp"
+#include "pair.hpp"
+
+namespace ft {
+	// Positions in an implicit binary tree in BFS (Eytzinger) order: slot i
+	// has children 2i and 2i + 1, the root is 1 and 0 stands for "none".
+	struct eytzinger {
+		// leftmost slot of a tree of n slots, 0 when empty
+		static std::size_t first(std::size_t n) {
+			std::size_t i = n ? 1 : 0;
+			while (2 * i <= n && i)
+				i *= 2;
+			return i;
+		}
+		static std::size_t last(std::size_t n) {
+			std::size_t i = n ? 1 : 0;
+			while (2 * i + 1 <= n && i)
+				i = 2 * i + 1;
+			return i;
+		}
+		// in-order neighbours: down one side and then all the way down the
+		// other, or up past every ancestor reached from the same side
+		static std::size_t next(std::size_t i, std::size_t n) {
+			if (2 * i + 1 <= n) {
+				i = 2 * i + 1;
+				while (2 * i <= n)
+					i *= 2;
+				return i;
+			}
+			return i >> __builtin_ffsll(~static_cast<long long>(i));
+		}
+		static std::size_t prev(std::size_t i, std::size_t n) {
+			if (i == 0)
+				return last(n);
+			if (2 * i <= n) {
+				i *= 2;
+				while (2 * i + 1 <= n)
+					i = 2 * i + 1;
+				return i;
+			}
+			return i >> __builtin_ffsll(static_cast<long long>(i));
+		}
+	};
+
+	// Walks the slots in key order; end() is slot 0.
+	template <typename T>
+	class eytzinger_iterator {
+	public:
+		typedef T								value_type;
+		typedef const T&						reference;
+		typedef const T*						pointer;
+		typedef std::bidirectional_iterator_tag	iterator_category;
+		typedef std::ptrdiff_t					difference_type;
+		typedef eytzinger_iterator<T>			iterator;
+
+		eytzinger_iterator() : slots(), n(), i() {}
+		eytzinger_iterator(const T* s, std::size_t size, std::size_t idx) : slots(s), n(size), i(idx) {}
+
+		reference operator*() const {
+			return slots[i - 1];
+		}
+		pointer operator->() const {
+			return &slots[i - 1];
+		}
+		iterator& operator++() {
+			i = eytzinger::next(i, n);
+			return *this;
+		}
+		iterator operator++(int) {
+			iterator tmp = *this;
+			i = eytzinger::next(i, n);
+			return tmp;
+		}
+		iterator& operator--() {
+			i = eytzinger::prev(i, n);
+			return *this;
+		}
+		iterator operator--(int) {
+			iterator tmp = *this;
+			i = eytzinger::prev(i, n);
+			return tmp;
+		}
+		bool operator==(const iterator& x) const {
+			return i == x.i;
+		}
+		bool operator!=(const iterator& x) const {
+			return i != x.i;
+		}
+
+		const T*	slots;
+		std::size_t	n;
+		std::size_t	i;
+	};
+
+	// Immutable sorted array laid out in Eytzinger order. A search reads
+	// one slot per level, and the levels near the root share cache lines,
+	// so lower_bound is a fixed-length loop with no unpredictable branch
+	// that prefetches the line holding the node's descendants a few levels
+	// down.
+	template<typename Key, typename Val, typename KeyOfValue, typename Compare = std::less<Key>, typename Alloc = std::allocator<Val> >
+	class eytzingerTree {
+	public:
+
+		typedef Val										value_type;
+		typedef Alloc									allocator_type;
+		typedef Key										key_type;
+		typedef std::size_t								size_type;
+		typedef eytzinger_iterator<value_type>			iterator;
+		typedef eytzinger_iterator<value_type>			const_iterator;
+		typedef ft::reverse_iterator<iterator>			reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>	const_reverse_iterator;
+
+		eytzingerTree(const Compare& comp = Compare(), const allocator_type& a = allocator_type()) :
+			_slots(0), _size(0), _allocator(a), _comp(comp) {}
+		eytzingerTree(const eytzingerTree& other) : _slots(0), _size(0), _allocator(other._allocator), _comp(other._comp) {
+			_copy(other);
+		}
+		eytzingerTree& operator=(const eytzingerTree& other) {
+			if (this != &other) {
+				clear();
+				_comp = other._comp;
+				_copy(other);
+			}
+			return *this;
+		}
+		~eytzingerTree() {
+			clear();
+		}
+		// the range is sorted and holds no equal keys
+		template<class It>
+		void assign_sorted(It first, It last) {
+			ft::frozen_sorted<Val, It> staged(first, last);
+			_build(staged.begin(), staged.size());
+		}
+		// any order; of equal keys the first one is kept
+		template<class It>
+		void assign(It first, It last) {
+			ft::frozen_unique<Val, KeyOfValue, Compare> staged(first, last, _comp);
+			_build(staged.begin(), staged.size());
+		}
+		iterator begin() const {
+			return iterator(_slots, _size, eytzinger::first(_size));
+		}
+		void clear() {
+			_destroy(_size, _size);
+			_size = 0;
+		}
+		iterator end() const {
+			return iterator(_slots, _size, 0);
+		}
+		iterator find(const key_type& k) const {
+			size_type i = _lower_bound(k);
+			return (i == 0 || _comp(k, KeyOfValue()(_slots[i - 1]))) ? end() : iterator(_slots, _size, i);
+		}
+		allocator_type get_allocator() const {
+			return _allocator;
+		}
+		Compare key_comp() const {
+			return _comp;
+		}
+		iterator lower_bound(const key_type& k) const {
+			return iterator(_slots, _size, _lower_bound(k));
+		}
+		size_type max_size() const {
+			return _allocator.max_size();
+		}
+		size_type size() const {
+			return _size;
+		}
+		void swap(eytzingerTree& other) {
+			std::swap(_slots, other._slots);
+			std::swap(_size, other._size);
+			std::swap(_allocator, other._allocator);
+			std::swap(_comp, other._comp);
+		}
+		iterator upper_bound(const key_type& k) const {
+			return iterator(_slots, _size, _upper_bound(k));
+		}
+	private:
+		Val*			_slots;
+		size_type		_size;
+		allocator_type	_allocator;
+		Compare			_comp;
+
+		// replaces the contents with n sorted, distinct values from first
+		template<class It>
+		void _build(It first, size_type n) {
+			clear();
+			if (n == 0)
+				return;
+			_slots = _allocator.allocate(n);
+			size_type i = eytzinger::first(n);
+			size_type built = 0;
+			try {
+				for (; built < n; ++built, ++first) {
+					_allocator.construct(&_slots[i - 1], *first);
+					i = eytzinger::next(i, n);
+				}
+			}
+			catch (...) {
+				_destroy(built, n);
+				throw;
+			}
+			_size = n;
+		}
+		// descendants of slot i a few levels down, as many as share a cache line
+		static size_type _prefetch_stride() {
+			size_type stride = 1;
+			while (stride * 2 * sizeof(Val) <= 64)
+				stride *= 2;
+			return stride;
+		}
+		// the search runs off the bottom of the tree; the ones in the low
+		// bits are the right turns taken below the answer
+		size_type _lower_bound(const key_type& k) const {
+			const size_type stride = _prefetch_stride();
+			size_type i = 1;
+			while (i <= _size) {
+				if (stride * i <= _size)
+					__builtin_prefetch(_slots + stride * i - 1);
+				i = 2 * i + _comp(KeyOfValue()(_slots[i - 1]), k);
+			}
+			return i >> __builtin_ffsll(~static_cast<long long>(i));
+		}
+		size_type _upper_bound(const key_type& k) const {
+			const size_type stride = _prefetch_stride();
+			size_type i = 1;
+			while (i <= _size) {
+				if (stride * i <= _size)
+					__builtin_prefetch(_slots + stride * i - 1);
+				i = 2 * i + !_comp(k, KeyOfValue()(_slots[i - 1]));
+			}
+			return i >> __builtin_ffsll(~static_cast<long long>(i));
+		}
+		void _copy(const eytzingerTree& other) {
+			if (other._size == 0)
+				return;
+			_slots = _allocator.allocate(other._size);
+			size_type built = 0;
+			try {
+				for (; built < other._size; ++built)
+					_allocator.construct(&_slots[built], other._slots[built]);
+			}
+			catch (...) {
+				for (size_type k = 0; k < built; ++k)
+					_allocator.destroy(&_slots[k]);
+				_allocator.deallocate(_slots, other._size);
+				_slots = 0;
+				throw;
+			}
+			_size = other._size;
+		}
+		// destroys the first built slots in key order and frees the n slot array
+		void _destroy(size_type built, size_type n) {
+			if (!_slots)
+				return;
+			size_type i = eytzinger::first(n);
+			for (size_type k = 0; k < built; ++k) {
+				_allocator.destroy(&_slots[i - 1]);
+				i = eytzinger::next(i, n);
+			}
+			_allocator.deallocate(_slots, n);
+			_slots = 0;
+		}
+	};
+}
+
+#endif
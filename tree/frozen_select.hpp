@@ -0,0 +1,21 @@
+#ifndef FROZEN_SELECT_HPP
+#define FROZEN_SELECT_HPP
+
+#include "eytzinger_tree.hpp"
+#include "simd_tree.hpp"
+
+namespace ft {
+	// the array behind frozen_map and frozen_set: a SIMD-searched index for
+	// 32 and 64-bit integer keys under std::less, Eytzinger order otherwise
+	template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc,
+		bool = simd_key<Key, Compare>::value>
+	struct frozen_select {
+		typedef eytzingerTree<Key, Val, KeyOfValue, Compare, Alloc> type;
+	};
+	template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+	struct frozen_select<Key, Val, KeyOfValue, Compare, Alloc, true> {
+		typedef simdTree<Key, Val, KeyOfValue, Compare, Alloc> type;
+	};
+}
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef FROZEN_STAGING_HPP
+#define FROZEN_STAGING_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include "../vector/vector.hpp"
+
+namespace ft {
+	// Input for the trees that are built once from a range (eytzingerTree,
+	// simdTree): begin() and size() hand them n sorted values with distinct
+	// keys, read once in order.
+
+	// a range that is already sorted and distinct; only single-pass
+	// iterators are copied, since their size is not known up front
+	template <typename Val, typename It, bool = std::is_base_of<std::forward_iterator_tag,
+		typename std::iterator_traits<It>::iterator_category>::value>
+	class frozen_sorted {
+	public:
+		frozen_sorted(It first, It last) : _first(first), _n(static_cast<std::size_t>(std::distance(first, last))) {}
+		It begin() const {
+			return _first;
+		}
+		std::size_t size() const {
+			return _n;
+		}
+	private:
+		It			_first;
+		std::size_t	_n;
+	};
+	template <typename Val, typename It>
+	class frozen_sorted<Val, It, false> {
+	public:
+		frozen_sorted(It first, It last) {
+			for (; first != last; ++first)
+				_values.push_back(*first);
+		}
+		typename ft::vector<Val>::const_iterator begin() const {
+			return _values.begin();
+		}
+		std::size_t size() const {
+			return _values.size();
+		}
+	private:
+		ft::vector<Val>	_values;
+	};
+
+	// a range in any order: the values are copied once and a stable sort of
+	// pointers to them puts them in order, so of equal keys the first is kept
+	template <typename Val, typename KeyOfValue, typename Compare>
+	class frozen_unique {
+	public:
+		struct iterator {
+			typename ft::vector<const Val*>::const_iterator it;
+			explicit iterator(typename ft::vector<const Val*>::const_iterator i) : it(i) {}
+			const Val& operator*() {
+				return **it;
+			}
+			iterator& operator++() {
+				++it;
+				return *this;
+			}
+		};
+
+		template <class It>
+		frozen_unique(It first, It last, Compare comp) : _n(0) {
+			for (; first != last; ++first)
+				_values.push_back(*first);
+			for (std::size_t k = 0; k < _values.size(); ++k)
+				_order.push_back(&_values[k]);
+			if (_order.empty())
+				return;
+			std::stable_sort(&_order[0], &_order[0] + _order.size(), _less(comp));
+			_n = 1;
+			for (std::size_t k = 1; k < _order.size(); ++k) {
+				if (comp(KeyOfValue()(*_order[_n - 1]), KeyOfValue()(*_order[k])))
+					_order[_n++] = _order[k];
+			}
+		}
+		iterator begin() const {
+			return iterator(_order.begin());
+		}
+		std::size_t size() const {
+			return _n;
+		}
+	private:
+		ft::vector<Val>			_values;
+		ft::vector<const Val*>	_order;
+		std::size_t				_n;
+
+		frozen_unique(const frozen_unique&);
+		frozen_unique& operator=(const frozen_unique&);
+
+		struct _less {
+			Compare comp;
+			explicit _less(const Compare& c) : comp(c) {}
+			bool operator()(const Val* a, const Val* b) const {
+				return comp(KeyOfValue()(*a), KeyOfValue()(*b));
+			}
+		};
+	};
+}
+
+#endif
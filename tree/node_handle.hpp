@@ -0,0 +1,114 @@
+#ifndef NODE_HANDLE_HPP
+#define NODE_HANDLE_HPP
+
+#include <utility>
+#include "../utility/type_traits.hpp"
+
+namespace ft {
+	template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename NodePolicy>
+	class rbTree;
+
+	// Owns one tree node taken out with extract(); insert() links it into
+	// another tree of the same type without allocating or copying. A handle
+	// that is never inserted frees its node.
+	template <class Val, class NodeType, class Alloc>
+	class rb_node_handle {
+		typedef typename Alloc::template rebind<NodeType>::other node_allocator;
+	public:
+
+		// DEF
+
+		typedef Val		value_type;
+		typedef Alloc	allocator_type;
+
+		// CONSTRUCTORS + DESTRUCTOR
+
+		rb_node_handle() : _node(0), _alloc() {}
+		rb_node_handle(rb_node_handle&& other) : _node(other._node), _alloc(other._alloc) {
+			other._node = 0;
+		}
+		~rb_node_handle() {
+			_reset();
+		}
+
+		// OPERATORS
+
+		rb_node_handle& operator=(rb_node_handle&& other) {
+			if (this != &other) {
+				_reset();
+				_node = other._node;
+				_alloc = other._alloc;
+				other._node = 0;
+			}
+			return *this;
+		}
+		explicit operator bool() const {
+			return _node != 0;
+		}
+
+		// MEMBER FUNCTIONS
+
+		bool empty() const {
+			return _node == 0;
+		}
+		allocator_type get_allocator() const {
+			return _alloc;
+		}
+		// map handles only: the key may be changed before re-inserting
+		template <class V = Val>
+		typename ft::remove_const<typename V::first_type>::type& key() const {
+			return const_cast<typename ft::remove_const<typename V::first_type>::type&>(_node->val.first);
+		}
+		template <class V = Val>
+		typename V::second_type& mapped() const {
+			return _node->val.second;
+		}
+		void swap(rb_node_handle& other) {
+			std::swap(_node, other._node);
+			std::swap(_alloc, other._alloc);
+		}
+		// set handles
+		value_type& value() const {
+			return _node->val;
+		}
+	private:
+		template <typename K, typename V, typename KoV, typename C, typename A, typename NP>
+		friend class rbTree;
+
+		NodeType*		_node;
+		allocator_type	_alloc;
+
+		rb_node_handle(NodeType* node, const allocator_type& alloc) : _node(node), _alloc(alloc) {}
+		rb_node_handle(const rb_node_handle&);
+		rb_node_handle& operator=(const rb_node_handle&);
+
+		NodeType* _release() {
+			NodeType* node = _node;
+			_node = 0;
+			return node;
+		}
+		void _reset() {
+			if (_node == 0)
+				return;
+			_alloc.destroy(&_node->val);
+			node_allocator(_alloc).deallocate(_node, 1);
+			_node = 0;
+		}
+	};
+
+	template <class Val, class NodeType, class Alloc>
+	inline void swap(rb_node_handle<Val, NodeType, Alloc>& x, rb_node_handle<Val, NodeType, Alloc>& y) {
+		x.swap(y);
+	}
+
+	// result of inserting a node handle; node holds it back when the key
+	// was already present
+	template <class Iterator, class NodeHandle>
+	struct rb_insert_return {
+		Iterator	position;
+		bool		inserted;
+		NodeHandle	node;
+	};
+}
+
+#endif
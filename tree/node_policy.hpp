@@ -0,0 +1,23 @@
+#ifndef NODE_POLICY_HPP
+#define NODE_POLICY_HPP
+
+#include <cstddef>
+
+namespace ft {
+	// Node layouts for the tree behind map and set.
+	// plain_nodes: colour and three links only.
+	// counted_nodes: adds the subtree size, enabling rank/select queries.
+	// compact_nodes: colour packed into the parent pointer, one word less.
+	// compact_counted_nodes: both.
+	// arena_nodes: nodes in one buffer linked by 32-bit index (arenaTree).
+	// btree_nodes<Bytes>: a B+-tree with nodes of about Bytes bytes (bTree).
+	struct plain_nodes {};
+	struct counted_nodes {};
+	struct compact_nodes {};
+	struct compact_counted_nodes {};
+	struct arena_nodes {};
+	template <std::size_t Bytes = 256>
+	struct btree_nodes {};
+}
+
+#endif
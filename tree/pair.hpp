@@ -1,7 +1,16 @@
 #ifndef PAIR_HPP
 #define PAIR_HPP
 
+#include <utility>
+
 namespace ft {
+	// Tag for the pair constructor that takes first from one argument and
+	// builds second in place from the rest.
+	struct emplace_second_t {
+		emplace_second_t() {}
+	};
+	static const emplace_second_t emplace_second = emplace_second_t();
+
 	template<class T1, class T2>
 	struct pair {
 
@@ -18,6 +27,11 @@ namespace ft {
 		pair() : first(), second() {}
 		pair(const T1& x, const T2& y) : first(x), second(y) {}
 		template<class U1, class U2>
+		pair(U1&& x, U2&& y) : first(std::forward<U1>(x)), second(std::forward<U2>(y)) {}
+		template<class U1, class... Args>
+		pair(emplace_second_t, U1&& x, Args&&... args) : first(std::forward<U1>(x)), second(std::forward<Args>(args)...) {}
+		pair(const pair& p) : first(p.first), second(p.second) {}
+		template<class U1, class U2>
 		pair(const pair<U1, U2>& p) : first(p.first), second(p.second) {}
 
 		// OPERATOR
@@ -44,7 +58,7 @@ namespace ft {
 	}
 	template<class T1, class T2>
 	bool operator<(const ft::pair<T1, T2>& lhs, const ft::pair<T1, T2>& rhs) {
-		return (lhs.first < rhs.first) || (!(rhs.first < lhs.first) && lhs.first < rhs.first);
+		return (lhs.first < rhs.first) || (!(rhs.first < lhs.first) && lhs.second < rhs.second);
 	}
 	template<class T1, class T2>
 	bool operator<=(const ft::pair<T1, T2>& lhs, const ft::pair<T1, T2>& rhs) {
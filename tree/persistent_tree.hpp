@@ -0,0 +1,476 @@
+#ifndef PERSISTENT_TREE_HPP
+#define PERSISTENT_TREE_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include "../iterator/reverse_iterator.hpp"
+#include "pair.hpp"
+
+namespace ft {
+	// Node shared between the trees of a map and its snapshots. refs counts
+	// the links to it, parents and tree roots alike, and is changed
+	// atomically so snapshots can be dropped on other threads.
+	template <typename Val>
+	struct persistentNode {
+		persistentNode*	left;
+		persistentNode*	right;
+		std::size_t		refs;
+		bool			red;
+		Val				val;
+	};
+
+	// Nodes have no parent link, so the iterator keeps the path from the
+	// root; end() is the empty path. 96 levels cover any left-leaning tree
+	// of fewer than 2^48 nodes.
+	template <typename Val>
+	class persistent_iterator {
+	public:
+		typedef Val								value_type;
+		typedef const Val&						reference;
+		typedef const Val*						pointer;
+		typedef std::bidirectional_iterator_tag	iterator_category;
+		typedef std::ptrdiff_t					difference_type;
+		typedef persistent_iterator<Val>		iterator;
+		typedef const persistentNode<Val>*		node_pointer;
+
+		static const std::size_t max_depth = 96;
+
+		persistent_iterator() : root(0), depth(0), path() {}
+		explicit persistent_iterator(node_pointer r) : root(r), depth(0), path() {}
+		persistent_iterator(const persistent_iterator& other) : root(other.root), depth(other.depth), path() {
+			for (std::size_t i = 0; i < depth; ++i)
+				path[i] = other.path[i];
+		}
+		persistent_iterator& operator=(const persistent_iterator& other) {
+			root = other.root;
+			depth = other.depth;
+			for (std::size_t i = 0; i < depth; ++i)
+				path[i] = other.path[i];
+			return *this;
+		}
+
+		// end() has no element
+		reference operator*() const {
+			assert(depth > 0);
+			return path[depth - 1]->val;
+		}
+		pointer operator->() const {
+			assert(depth > 0);
+			return &path[depth - 1]->val;
+		}
+		iterator& operator++() {
+			node_pointer x = path[depth - 1];
+			if (x->right) {
+				path[depth++] = x->right;
+				_leftmost();
+				return *this;
+			}
+			while (--depth > 0 && path[depth - 1]->right == path[depth])
+				;
+			return *this;
+		}
+		iterator operator++(int) {
+			iterator tmp = *this;
+			++*this;
+			return tmp;
+		}
+		iterator& operator--() {
+			if (depth == 0) {
+				if (root) {
+					path[depth++] = root;
+					_rightmost();
+				}
+				return *this;
+			}
+			node_pointer x = path[depth - 1];
+			if (x->left) {
+				path[depth++] = x->left;
+				_rightmost();
+				return *this;
+			}
+			while (--depth > 0 && path[depth - 1]->left == path[depth])
+				;
+			return *this;
+		}
+		iterator operator--(int) {
+			iterator tmp = *this;
+			--*this;
+			return tmp;
+		}
+		bool operator==(const iterator& x) const {
+			return node() == x.node();
+		}
+		bool operator!=(const iterator& x) const {
+			return node() != x.node();
+		}
+		node_pointer node() const {
+			return depth ? path[depth - 1] : 0;
+		}
+		void _leftmost() {
+			while (path[depth - 1]->left) {
+				path[depth] = path[depth - 1]->left;
+				++depth;
+			}
+		}
+		void _rightmost() {
+			while (path[depth - 1]->right) {
+				path[depth] = path[depth - 1]->right;
+				++depth;
+			}
+		}
+
+		node_pointer	root;
+		std::size_t		depth;
+		node_pointer	path[max_depth];
+	};
+
+	// Persistent left-leaning red-black tree. Copies share the whole tree
+	// in O(1); a write first takes ownership of every node it is about to
+	// change, top down, cloning those still linked from another tree, so
+	// it copies O(log n) nodes and never alters what a copy can see.
+	// Readers of a copy need no locking against writers of the original.
+	template<typename Key, typename Val, typename KeyOfValue, typename Compare = std::less<Key>, typename Alloc = std::allocator<Val> >
+	class persistentTree {
+	public:
+
+		typedef Val										value_type;
+		typedef Alloc									allocator_type;
+		typedef Key										key_type;
+		typedef std::size_t								size_type;
+		typedef persistentNode<Val>						node_type;
+		typedef persistent_iterator<Val>				iterator;
+		typedef persistent_iterator<Val>				const_iterator;
+		typedef ft::reverse_iterator<iterator>			reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>	const_reverse_iterator;
+		typedef typename Alloc::template rebind<node_type>::other node_allocator;
+
+		persistentTree(const Compare& comp = Compare(), const allocator_type& a = allocator_type()) :
+			_root(0), _size(0), _allocator(a), _nodeAlloc(a), _comp(comp) {}
+		persistentTree(const persistentTree& other) :
+			_root(other._root), _size(other._size), _allocator(other._allocator), _nodeAlloc(other._nodeAlloc),
+			_comp(other._comp) {
+			_retain(_root);
+		}
+		persistentTree& operator=(const persistentTree& other) {
+			node_type* old = _root;
+			_root = other._root;
+			_retain(_root);
+			_release(old);
+			_size = other._size;
+			_comp = other._comp;
+			return *this;
+		}
+		~persistentTree() {
+			_release(_root);
+		}
+		iterator begin() const {
+			iterator it(_root);
+			if (_root) {
+				it.path[it.depth++] = _root;
+				it._leftmost();
+			}
+			return it;
+		}
+		void clear() {
+			_release(_root);
+			_root = 0;
+			_size = 0;
+		}
+		template<class K>
+		size_type count(const K& k) const {
+			return find(k) == end() ? 0 : 1;
+		}
+		bool empty() const {
+			return _size == 0;
+		}
+		iterator end() const {
+			return iterator(_root);
+		}
+		template<class K>
+		ft::pair<iterator, iterator> equal_range(const K& k) const {
+			return ft::pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+		}
+		size_type erase(const key_type& k) {
+			if (find(k) == end())
+				return 0;
+			_root = _own(_root);
+			if (!_red(_root->left) && !_red(_root->right))
+				_root->red = true;
+			_root = _erase(_root, k);
+			if (_root)
+				_root->red = false;
+			--_size;
+			return 1;
+		}
+		template<class K>
+		iterator find(const K& k) const {
+			iterator j = lower_bound(k);
+			return (j == end() || _comp(k, KeyOfValue()(*j))) ? end() : j;
+		}
+		allocator_type get_allocator() const {
+			return _allocator;
+		}
+		ft::pair<iterator, bool> insert(const value_type& val) {
+			iterator it = find(KeyOfValue()(val));
+			if (it != end())
+				return ft::pair<iterator, bool>(it, false);
+			_insert_node(_create_node(val));
+			return ft::pair<iterator, bool>(find(KeyOfValue()(val)), true);
+		}
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last) {
+			for (; first != last; ++first)
+				insert(*first);
+		}
+		// map only
+		template<class M>
+		ft::pair<iterator, bool> insert_or_assign(const key_type& k, M&& obj) {
+			if (find(k) == end()) {
+				_insert_node(_create_node(k, std::forward<M>(obj)));
+				return ft::pair<iterator, bool>(find(k), true);
+			}
+			node_type** link = &_root;
+			for (;;) {
+				*link = _own(*link);
+				if (_comp(k, KeyOfValue()((*link)->val)))
+					link = &(*link)->left;
+				else if (_comp(KeyOfValue()((*link)->val), k))
+					link = &(*link)->right;
+				else
+					break;
+			}
+			(*link)->val.second = std::forward<M>(obj);
+			return ft::pair<iterator, bool>(find(k), false);
+		}
+		Compare key_comp() const {
+			return _comp;
+		}
+		template<class K>
+		iterator lower_bound(const K& k) const {
+			iterator it(_root);
+			size_type found = 0;
+			for (const node_type* x = _root; x;) {
+				it.path[it.depth++] = x;
+				if (!_comp(KeyOfValue()(x->val), k))
+					found = it.depth, x = x->left;
+				else
+					x = x->right;
+			}
+			it.depth = found;
+			return it;
+		}
+		size_type max_size() const {
+			return _nodeAlloc.max_size();
+		}
+		reverse_iterator rbegin() const {
+			return reverse_iterator(end());
+		}
+		reverse_iterator rend() const {
+			return reverse_iterator(begin());
+		}
+		// true when both trees still have the same root, i.e. neither has
+		// been written since one was copied from the other
+		bool shares(const persistentTree& other) const {
+			return _root == other._root;
+		}
+		size_type size() const {
+			return _size;
+		}
+		void swap(persistentTree& other) {
+			std::swap(_root, other._root);
+			std::swap(_size, other._size);
+			std::swap(_allocator, other._allocator);
+			std::swap(_nodeAlloc, other._nodeAlloc);
+			std::swap(_comp, other._comp);
+		}
+		template<class K>
+		iterator upper_bound(const K& k) const {
+			iterator it(_root);
+			size_type found = 0;
+			for (const node_type* x = _root; x;) {
+				it.path[it.depth++] = x;
+				if (_comp(k, KeyOfValue()(x->val)))
+					found = it.depth, x = x->left;
+				else
+					x = x->right;
+			}
+			it.depth = found;
+			return it;
+		}
+	private:
+		node_type*			_root;
+		size_type			_size;
+		allocator_type		_allocator;
+		node_allocator		_nodeAlloc;
+		Compare				_comp;
+
+		static bool _red(const node_type* x) {
+			return x && x->red;
+		}
+		static void _retain(node_type* x) {
+			if (x)
+				__atomic_add_fetch(&x->refs, 1, __ATOMIC_RELAXED);
+		}
+		void _release(node_type* x) {
+			while (x && __atomic_sub_fetch(&x->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+				node_type* right = x->right;
+				_release(x->left);
+				_allocator.destroy(&x->val);
+				_nodeAlloc.deallocate(x, 1);
+				x = right;
+			}
+		}
+		template<class... Args>
+		node_type* _create_node(Args&&... args) {
+			node_type* z = _nodeAlloc.allocate(1);
+			try {
+				_allocator.construct(&z->val, std::forward<Args>(args)...);
+			}
+			catch (...) {
+				_nodeAlloc.deallocate(z, 1);
+				throw;
+			}
+			z->left = 0;
+			z->right = 0;
+			z->refs = 1;
+			z->red = true;
+			return z;
+		}
+		// x itself when this tree holds the only link to it, else a clone
+		// sharing x's children; the caller stores the result where x was
+		node_type* _own(node_type* x) {
+			if (__atomic_load_n(&x->refs, __ATOMIC_ACQUIRE) == 1)
+				return x;
+			node_type* c = _create_node(x->val);
+			c->left = x->left;
+			c->right = x->right;
+			c->red = x->red;
+			_retain(c->left);
+			_retain(c->right);
+			_release(x);
+			return c;
+		}
+		void _insert_node(node_type* z) {
+			try {
+				_root = _insert(_root, z);
+			}
+			catch (...) {
+				_release(z);
+				throw;
+			}
+			_root->red = false;
+			++_size;
+		}
+		// the rest follows Sedgewick's left-leaning red-black tree, with
+		// every node it writes to owned first
+		node_type* _insert(node_type* h, node_type* z) {
+			if (!h)
+				return z;
+			h = _own(h);
+			if (_comp(KeyOfValue()(z->val), KeyOfValue()(h->val)))
+				h->left = _insert(h->left, z);
+			else
+				h->right = _insert(h->right, z);
+			return _balance(h);
+		}
+		// k is in the subtree under h
+		node_type* _erase(node_type* h, const key_type& k) {
+			h = _own(h);
+			if (_comp(k, KeyOfValue()(h->val))) {
+				if (!_red(h->left) && !_red(h->left->left))
+					h = _move_red_left(h);
+				h->left = _erase(h->left, k);
+				return _balance(h);
+			}
+			if (_red(h->left))
+				h = _rotate_right(h);
+			if (!_comp(KeyOfValue()(h->val), k) && !h->right) {
+				_release(h);
+				return 0;
+			}
+			if (!_red(h->right) && !_red(h->right->left))
+				h = _move_red_right(h);
+			if (!_comp(KeyOfValue()(h->val), k)) {
+				// the successor node takes h's place
+				node_type* m = 0;
+				h->right = _erase_min(h->right, m);
+				m->left = h->left;
+				m->right = h->right;
+				m->red = h->red;
+				h->left = 0;
+				h->right = 0;
+				_release(h);
+				h = m;
+			}
+			else
+				h->right = _erase(h->right, k);
+			return _balance(h);
+		}
+		// unlinks the leftmost node under h into m
+		node_type* _erase_min(node_type* h, node_type*& m) {
+			h = _own(h);
+			if (!h->left) {
+				m = h;
+				return 0;
+			}
+			if (!_red(h->left) && !_red(h->left->left))
+				h = _move_red_left(h);
+			h->left = _erase_min(h->left, m);
+			return _balance(h);
+		}
+		node_type* _rotate_left(node_type* h) {
+			node_type* x = _own(h->right);
+			h->right = x->left;
+			x->left = h;
+			x->red = h->red;
+			h->red = true;
+			return x;
+		}
+		node_type* _rotate_right(node_type* h) {
+			node_type* x = _own(h->left);
+			h->left = x->right;
+			x->right = h;
+			x->red = h->red;
+			h->red = true;
+			return x;
+		}
+		void _flip(node_type* h) {
+			h->left = _own(h->left);
+			h->right = _own(h->right);
+			h->red = !h->red;
+			h->left->red = !h->left->red;
+			h->right->red = !h->right->red;
+		}
+		node_type* _move_red_left(node_type* h) {
+			_flip(h);
+			if (_red(h->right->left)) {
+				h->right = _rotate_right(h->right);
+				h = _rotate_left(h);
+				_flip(h);
+			}
+			return h;
+		}
+		node_type* _move_red_right(node_type* h) {
+			_flip(h);
+			if (_red(h->left->left)) {
+				h = _rotate_right(h);
+				_flip(h);
+			}
+			return h;
+		}
+		node_type* _balance(node_type* h) {
+			if (_red(h->right) && !_red(h->left))
+				h = _rotate_left(h);
+			if (_red(h->left) && _red(h->left->left))
+				h = _rotate_right(h);
+			if (_red(h->left) && _red(h->right))
+				_flip(h);
+			return h;
+		}
+	};
+}
+
+#endif
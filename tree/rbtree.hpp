@@ -4,9 +4,19 @@
 #include <iostream>
 #include <iomanip>
 #include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
 #include "../utility/algorithm.hpp"
+#include "../utility/parallel.hpp"
+#include "../utility/pool_allocator.hpp"
+#include "../utility/sorted_unique.hpp"
+#include "../utility/type_traits.hpp"
+#include "node_handle.hpp"
+#include "node_policy.hpp"
 #include "pair.hpp"
 #include "../iterator/reverse_iterator.hpp"
+#include "../vector/vector.hpp"
 
 namespace ft {
 	enum rbColor {red = false, black = true};
@@ -21,6 +31,18 @@ namespace ft {
 		rbNode*		right;
 		Val			val;
 
+		rbColor color() const {
+			return clr;
+		}
+		void set_color(rbColor c) {
+			clr = c;
+		}
+		pointer get_parent() const {
+			return parent;
+		}
+		void set_parent(pointer p) {
+			parent = p;
+		}
 		static pointer minimum(pointer x) {
 			while (x->left != NULL)
 				x = x->left;
@@ -43,61 +65,160 @@ namespace ft {
 		}
 	};
 
-	template <class T>
-	rbNode<T>* rb_tree_increment_local(rbNode<T>* node) {
+	// Same links as rbNode, but the colour lives in bit 0 of the parent
+	// pointer (nodes are at least pointer aligned), saving a padded word.
+	template <typename Val>
+	struct rbCompactNode {
+		typedef rbCompactNode<Val>* pointer;
+		typedef const rbCompactNode<Val>* const_pointer;
+		std::uintptr_t	parent_clr;
+		rbCompactNode*	left;
+		rbCompactNode*	right;
+		Val				val;
+
+		rbColor color() const {
+			return rbColor(parent_clr & 1);
+		}
+		void set_color(rbColor c) {
+			parent_clr = (parent_clr & ~std::uintptr_t(1)) | std::uintptr_t(c);
+		}
+		pointer get_parent() const {
+			return reinterpret_cast<pointer>(parent_clr & ~std::uintptr_t(1));
+		}
+		void set_parent(pointer p) {
+			parent_clr = reinterpret_cast<std::uintptr_t>(p) | (parent_clr & 1);
+		}
+		static pointer minimum(pointer x) {
+			while (x->left != NULL)
+				x = x->left;
+			return x;
+		}
+		static const_pointer minimum(const_pointer x) {
+			while (x->left != NULL)
+				x = x->left;
+			return x;
+		}
+		static pointer maximum(pointer x) {
+			while (x->right != NULL)
+				x = x->right;
+			return x;
+		}
+		static const_pointer maximum(const_pointer x) {
+			while (x->right != NULL)
+				x = x->right;
+			return x;
+		}
+	};
+
+	template <typename Base>
+	struct rbCountedNode : Base {
+		std::size_t	count;
+	};
+
+	// Per-policy link layout and node type plus the hooks that keep an
+	// augmentation in sync with the links; the plain hooks compile away.
+	template <typename Base>
+	struct rb_plain_hooks {
+		typedef Base	base_type;
+		typedef Base	node_type;
+		static const bool counted = false;
+
+		static void copy(Base*, const Base*) {}
+		static void init(Base*, std::size_t) {}
+		static void update(Base*) {}
+	};
+
+	template <typename Base>
+	struct rb_counted_hooks {
+		typedef Base					base_type;
+		typedef rbCountedNode<Base>		node_type;
+		static const bool counted = true;
+
+		static void copy(Base* to, const Base* from) {
+			static_cast<node_type*>(to)->count = count(from);
+		}
+		static std::size_t count(const Base* x) {
+			return x ? static_cast<const node_type*>(x)->count : 0;
+		}
+		static void init(Base* x, std::size_t n) {
+			static_cast<node_type*>(x)->count = n;
+		}
+		static void update(Base* x) {
+			static_cast<node_type*>(x)->count = 1 + count(x->left) + count(x->right);
+		}
+	};
+
+	template <typename Val, typename NodePolicy>
+	struct rb_node_traits;
+
+	template <typename Val>
+	struct rb_node_traits<Val, plain_nodes> : rb_plain_hooks<rbNode<Val> > {
+	};
+	template <typename Val>
+	struct rb_node_traits<Val, counted_nodes> : rb_counted_hooks<rbNode<Val> > {
+	};
+	template <typename Val>
+	struct rb_node_traits<Val, compact_nodes> : rb_plain_hooks<rbCompactNode<Val> > {
+	};
+	template <typename Val>
+	struct rb_node_traits<Val, compact_counted_nodes> : rb_counted_hooks<rbCompactNode<Val> > {
+	};
+
+	template <class Node>
+	Node* rb_tree_increment_local(Node* node) {
 		if (node->right != NULL) {
 			node = node->right;
 			while (node->left != NULL)
 				node = node->left;
 		}
 		else {
-			rbNode<T>* other = node->parent;
+			Node* other = node->get_parent();
 			while (node == other->right) {
 				node = other;
-				other = other->parent;
+				other = other->get_parent();
 			}
 			if (node->right != other)
 				node = other;
 		}
 		return node;
 	}
-	template <class T>
-	rbNode<T>* rb_tree_increment(rbNode<T>* node) {
+	template <class Node>
+	Node* rb_tree_increment(Node* node) {
 		return rb_tree_increment_local(node);
 	}
-	template <class T>
-	const rbNode<T>* rb_tree_increment(const rbNode<T>* node) {
-		return rb_tree_increment_local(const_cast<rbNode<T>*>(node));
+	template <class Node>
+	const Node* rb_tree_increment(const Node* node) {
+		return rb_tree_increment_local(const_cast<Node*>(node));
 	}
-	template <class T>
-	rbNode<T>* rb_tree_decrement_local(rbNode<T>* node) {
-		if (node->clr == red && node->parent->parent == node)
+	template <class Node>
+	Node* rb_tree_decrement_local(Node* node) {
+		if (node->color() == red && node->get_parent()->get_parent() == node)
 			node = node->right;
 		else if (node->left != NULL) {
-			rbNode<T>* other = node->left;
+			Node* other = node->left;
 			while (other->right != NULL)
 				other = other->right;
 			node = other;
 		}
 		else {
-			rbNode<T>* other = node->parent;
+			Node* other = node->get_parent();
 			while (node == other->left) {
 				node = other;
-				other = other->parent;
+				other = other->get_parent();
 			}
 			node = other;
 		}
 		return node;
 	}
-	template <class T>
-	rbNode<T>* rb_tree_decrement(rbNode<T>* node) {
+	template <class Node>
+	Node* rb_tree_decrement(Node* node) {
 		return rb_tree_decrement_local(node);
 	}
-	template <class T>
-	const rbNode<T>* rb_tree_decrement(const rbNode<T>* node) {
-		return rb_tree_decrement_local(const_cast<rbNode<T>*>(node));
+	template <class Node>
+	const Node* rb_tree_decrement(const Node* node) {
+		return rb_tree_decrement_local(const_cast<Node*>(node));
 	}
-	template <typename T>
+	template <typename T, typename Node = rbNode<T> >
 	class rb_iterator {
 	public:
 			typedef T								value_type;
@@ -105,10 +226,10 @@ namespace ft {
 			typedef T*								pointer;
 			typedef std::bidirectional_iterator_tag	iterator_category;
 			typedef std::ptrdiff_t					difference_type;
-			typedef rb_iterator<T>					iterator;
+			typedef rb_iterator<T, Node>				iterator;
 
 			rb_iterator() : node() {}
-			explicit rb_iterator(rbNode<T>* x) : node(x) {}
+			explicit rb_iterator(Node* x) : node(x) {}
 
 			reference operator*() const {
 				return node->val;
@@ -140,9 +261,9 @@ namespace ft {
 			bool operator!=(const iterator& x) const {
 				return node != x.node;
 			}
-			rbNode<T>*	 node;
+			Node*	 node;
 		};
-	template <typename T>
+	template <typename T, typename Node = rbNode<T> >
 	class rb_const_iterator {
 	public:
 		typedef T										value_type;
@@ -150,11 +271,11 @@ namespace ft {
 		typedef const T*								pointer;
 		typedef std::bidirectional_iterator_tag			iterator_category;
 		typedef std::ptrdiff_t							difference_type;
-		typedef rb_const_iterator<T>					iterator;
-		typedef rb_iterator<T>							iterr;
+		typedef rb_const_iterator<T, Node>				iterator;
+		typedef rb_iterator<T, Node>						iterr;
 
 		rb_const_iterator() : node() {}
-		explicit rb_const_iterator(const rbNode<T>* x) : node(x) {}
+		explicit rb_const_iterator(const Node* x) : node(x) {}
 		rb_const_iterator(const iterr& iter) : node(iter.node) {}
 		reference operator*() const {
 			return node->val;
@@ -187,21 +308,23 @@ namespace ft {
 			return node != x.node;
 		}
 
-		const rbNode<T>*	 node;
+		const Node*	 node;
 	};
 
-	template <typename Val>
-	inline bool operator==(const rb_iterator<Val>& x, const rb_const_iterator<Val>& y) {
+	template <typename Val, typename Node>
+	inline bool operator==(const rb_iterator<Val, Node>& x, const rb_const_iterator<Val, Node>& y) {
 		return x.node == y.node;
 	}
-	template <typename Val>
-	inline bool operator!=(const rb_iterator<Val>& x, const rb_const_iterator<Val>& y) {
+	template <typename Val, typename Node>
+	inline bool operator!=(const rb_iterator<Val, Node>& x, const rb_const_iterator<Val, Node>& y) {
 		return x.node != y.node;
 	}
-	template<typename Key, typename Val, typename KeyOfValue, typename Compare = std::less<Key>, typename Alloc = std::allocator<Val> >
+	template<typename Key, typename Val, typename KeyOfValue, typename Compare = std::less<Key>, typename Alloc = std::allocator<Val>,
+		typename NodePolicy = plain_nodes>
 	class rbTree {
-		typedef typename Alloc::template rebind<rbNode<Val> >::other node_allocator;
-//		typedef std::allocator<rbNode<Val> > node_allocator;
+		typedef rb_node_traits<Val, NodePolicy> node_traits;
+		typedef typename node_traits::node_type node_type;
+		typedef typename Alloc::template rebind<node_type>::other node_allocator;
 	public:
 
 		typedef Val										value_type;
@@ -212,41 +335,48 @@ namespace ft {
 		typedef const value_type*						const_pointer;
 		typedef value_type&								reference;
 		typedef const value_type&						const_reference;
-		typedef rbNode<Val>*							rb_node;
-		typedef const rbNode<Val>*						const_rb_node;
+		typedef typename node_traits::base_type			base_node;
+		typedef base_node*								rb_node;
+		typedef const base_node*						const_rb_node;
 		typedef std::size_t								size_type;
 		typedef std::ptrdiff_t							difference_type;
-		typedef rb_iterator<value_type>					iterator;
-		typedef rb_const_iterator<value_type>			const_iterator;
+		typedef rb_iterator<value_type, base_node>		iterator;
+		typedef rb_const_iterator<value_type, base_node>	const_iterator;
 		typedef ft::reverse_iterator<iterator>			reverse_iterator;
 		typedef ft::reverse_iterator<const_iterator>	const_reverse_iterator;
+		typedef rb_node_handle<Val, node_type, Alloc>	node_handle;
+		typedef rb_insert_return<iterator, node_handle>	insert_return_type;
+
+		// copies of at least this many nodes clone subtrees on several threads
+		static const size_type parallel_copy_threshold = size_type(1) << 16;
 
 		rbTree() : _root(), _size(0), _allocator(), _nodeAlloc(), _comp() {
-			_root.clr = red;
-			_root.parent = 0;
+			_root.set_color(red);
+			_root.set_parent(0);
 			_root.right = &_root;
 			_root.left = &_root;
 			_size = 0;
 		}
 		rbTree(const Compare& comp, const allocator_type& a = allocator_type()) :
 				_root(), _size(), _allocator(), _nodeAlloc(a), _comp(comp) {
-			_root.clr = red;
-			_root.parent = 0;
+			_root.set_color(red);
+			_root.set_parent(0);
 			_root.right = &_root;
 			_root.left = &_root;
 			_size = 0;
 		}
-		rbTree(const rbTree& other) {
-			if (other._root.parent) {
-				_root.parent = _copy(other._root.parent, &_root);
-				_root.left = rbNode<Val>::minimum(_root.parent);
-				_root.right = rbNode<Val>::maximum(_root.parent);
+		rbTree(const rbTree& other) : _root(), _size(0), _allocator(), _nodeAlloc(), _comp(other._comp) {
+			_root.set_color(red);
+			if (other._root.get_parent()) {
+				_root.set_parent(_copy_tree(other._root.get_parent(), &_root, other._size));
+				_root.left = base_node::minimum(_root.get_parent());
+				_root.right = base_node::maximum(_root.get_parent());
 				_size = other._size;
 			}
 			else {
-				_root.clr = red;
+				_root.set_color(red);
 				_size = other._size;
-				_root.parent = 0;
+				_root.set_parent(0);
 				_root.left = &_root;
 				_root.right = &_root;
 			}
@@ -255,23 +385,46 @@ namespace ft {
 			if (this != &other) {
 				clear();
 				_comp = other._comp;
-				if (other._root.parent != NULL) {
-					_root.parent = _copy(_root.parent, &_root);
-					_root.left = rbNode<Val>::minimum(_root.parent);
-					_root.right = rbNode<Val>::maximum(_root.parent);
+				if (other._root.get_parent() != NULL) {
+					_root.set_parent(_copy_tree(other._root.get_parent(), &_root, other._size));
+					_root.left = base_node::minimum(_root.get_parent());
+					_root.right = base_node::maximum(_root.get_parent());
 					_size = other._size;
 				}
 				else {
-					_root.clr = red;
+					_root.set_color(red);
 					_size = other._size;
-					_root.parent = 0;
+					_root.set_parent(0);
 					_root.left = &_root;
 					_root.right = &_root;
 				}
 			}
+			return *this;
 		}
 		~rbTree() {
-			_erase(_root.parent);
+			_erase_all();
+		}
+		// Set algebra on two sorted trees: one merge pass into a chain that is
+		// linked into a balanced tree, O(n + m). Equal keys keep a's value.
+		void assign_difference(const rbTree& a, const rbTree& b) {
+			if (_probe_cheaper(a._size, b._size))
+				_assign_probed(a, b, false);
+			else
+				_assign_merged(a, b, true, false, false);
+		}
+		void assign_intersection(const rbTree& a, const rbTree& b) {
+			if (_probe_cheaper(a._size, b._size))
+				_assign_probed(a, b, true);
+			else if (_probe_cheaper(b._size, a._size))
+				_assign_probed_reverse(a, b);
+			else
+				_assign_merged(a, b, false, false, true);
+		}
+		void assign_symmetric_difference(const rbTree& a, const rbTree& b) {
+			_assign_merged(a, b, true, true, false);
+		}
+		void assign_union(const rbTree& a, const rbTree& b) {
+			_assign_merged(a, b, true, true, true);
 		}
 		iterator begin() {
 			return iterator(_root.left);
@@ -280,13 +433,14 @@ namespace ft {
 			return const_iterator(_root.left);
 		}
 		void clear() {
-			_erase(_root.parent);
+			_erase_all();
 			_root.left = &_root;
-			_root.parent = NULL;
+			_root.set_parent(NULL);
 			_root.right = &_root;
 			_size = 0;
 		}
-		size_type count(const key_type& k) const {
+		template<class K>
+		size_type count(const K& k) const {
 			if (find(k) == end())
 				return 0;
 			return 1;
@@ -300,166 +454,94 @@ namespace ft {
 		bool empty() const {
 			return _size == 0;
 		}
-		void erase(iterator position) {
-			rb_node z = position.node;
-			rb_node y = z;
-			rb_node x = 0;
-			rb_node xp = 0;
-			if (y->left == NULL)
-				x = y->right;
-			else {
-				if (y->right == NULL)
-					x = y->left;
-				else {
-					y = y->right;
-					while (y->left)
-						y = y->left;
-					x = y->right;
-				}
-			}
-			if (y == z) {
-				xp = y->parent;
-				if (x)
-					x->parent = y->parent;
-				if (_root.parent == z)
-					_root.parent = x;
-				else if (z->parent->left == z)
-					z->parent->left = x;
-				else
-					z->parent->right = x;
-				if (_root.left == z) {
-					if (z->right == NULL)
-						_root.left = z->parent;
-					else
-						_root.left = rbNode<value_type>::minimum(x);
-				}
-				if (_root.right == z) {
-					if (z->left == NULL)
-						_root.right = z->parent;
-					else
-						_root.right = rbNode<value_type>::maximum(x);
-				}
-			}
-			else {
-				z->left->parent = y;
-				y->left = z->left;
-				if (y != z->right) {
-					xp = y->parent;
-					if (x)
-						x->parent = y->parent;
-					y->parent->left = x;
-					y->right = z->right;
-					z->right->parent = y;
-				}
-				else
-					xp = y;
-				if (_root.parent == z)
-					_root.parent = y;
-				else if (z->parent->left == z)
-					z->parent->left = y;
-				else
-					z->parent->right = y;
-				y->parent = z->parent;
-				std::swap(y->clr, z->clr);
-				y = z;
-			}
-			if (y->clr != red) {
-				while (x != _root.parent && (x == NULL || x->clr == black)) {
-					if (x == xp->left) {
-						rb_node w = xp->right;
-						if (w->clr == red) {
-							w->clr = black;
-							xp->clr = red;
-							_leftRotation(xp);
-							w = xp->right;
-						}
-						if ((w->left == NULL || w->left->clr == black) && (w->right == NULL || w->right->clr == black)) {
-							w->clr = red;
-							x = xp;
-							xp = xp->parent;
-						}
-						else {
-							if (w->right == NULL || w->right->clr == black) {
-								w->left->clr = black;
-								w->clr = red;
-								_rightRotation(w);
-								w = xp->right;
-							}
-							w->clr = xp->clr;
-							xp->clr = black;
-							if (w->right)
-								w->right->clr = black;
-							_leftRotation(xp);
-							break;
-						}
-					}
-					else {
-						rb_node w = xp->left;
-						if (w->clr == red) {
-							w->clr = black;
-							xp->clr = red;
-							_rightRotation(xp);
-							w = xp->left;
-						}
-						if ((w->right == NULL || w->right->clr == black) && (w->left == NULL || w->left->clr == black)) {
-							w->clr = red;
-							x = xp;
-							xp = xp->parent;
-						}
-						else {
-							if (w->left == NULL || w->left->clr == black) {
-								w->right->clr = black;
-								w->clr = red;
-								_leftRotation(w);
-								w = xp->left;
-							}
-							w->clr = xp->clr;
-							xp->clr = black;
-							if (w->left)
-								w->left->clr = black;
-							_rightRotation(xp);
-							break;
-						}
-					}
-				}
-				if (x)
-					x->clr = black;
-			}
+		iterator erase(iterator position) {
+			iterator next = position;
+			++next;
+			rb_node y = _unlink(position.node);
 			_allocator.destroy(&y->val);
-			_nodeAlloc.deallocate(y, 1);
+			_nodeAlloc.deallocate(static_cast<node_type*>(y), 1);
 			_size--;
+			return next;
         }
+		// Short ranges go node by node. Longer ones are cut out with two
+		// splits, freed without any rebalancing and the remaining halves
+		// joined once: O(log n + k) instead of O(k log n).
 		void erase(iterator first, iterator last) {
-			if (first == begin() && last == end())
+			if (first == begin() && last == end()) {
 				clear();
-            while (first != last) {
-				erase(first++);
+				return;
 			}
-        }
+			iterator probe = first;
+			for (int i = 0; i < 16 && probe != last; ++i)
+				++probe;
+			if (probe == last) {
+				while (first != last)
+					erase(first++);
+				return;
+			}
+			size_type n = _size;
+			rb_node l, mid, r;
+			size_type hl, hm, hr;
+			_split(_root.get_parent(), _black_height(_root.get_parent()), KeyOfValue()(*first), l, hl, mid, hm);
+			if (last != end())
+				_split(mid, hm, KeyOfValue()(*last), mid, hm, r, hr);
+			else
+				r = 0;
+			n -= _erase(mid);
+			if (l == NULL || r == NULL) {
+				_adopt(l ? l : r, n);
+				return;
+			}
+			_adopt(r, 0);
+			rb_node pivot = _unlink(_root.left);
+			rb_node rest = _root.get_parent();
+			size_type h;
+			_adopt(_join(l, hl, pivot, rest, _black_height(rest), h), n);
+		}
 		size_type erase(const key_type & key) {
             iterator del = find(key);
+            if (del == end())
+                return 0;
             erase(del);
-            return _size;
+            return 1;
         }
-		ft::pair<iterator, iterator> equal_range(const key_type& k) {
+		template<class K>
+		ft::pair<iterator, iterator> equal_range(const K& k) {
 			return ft::pair<iterator, iterator>(lower_bound(k), upper_bound(k));
 		}
-		ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
-			return ft::pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+		template<class K>
+		ft::pair<const_iterator, const_iterator> equal_range(const K& k) const {
+			return ft::pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+		}
+		// Node handles relink nodes between trees, so a node must be freeable
+		// through any equal allocator; pooled ones only free their own slots.
+		node_handle extract(const_iterator position) {
+			static_assert(!ft::has_bulk_release<node_allocator>::value, "node handles need an allocator without per-tree pools");
+			rb_node y = _unlink(const_cast<rb_node>(position.node));
+			--_size;
+			return node_handle(static_cast<node_type*>(y), _allocator);
 		}
-		iterator find(const key_type& key) {
+		node_handle extract(const key_type& k) {
+			iterator it = find(k);
+			if (it == end())
+				return node_handle();
+			return extract(it);
+		}
+		template<class K>
+		iterator find(const K& key) {
 			iterator j = lower_bound(key);
 			return (j == end() || _comp(key, KeyOfValue()(j.node->val))) ? end() : j;
 		}
-		const_iterator find(const key_type& key) const {
+		template<class K>
+		const_iterator find(const K& key) const {
 			const_iterator j = lower_bound(key);
 			return (j == end() || _comp(key, KeyOfValue()(j.node->val))) ? end() : j;
 		}
-		allocator_type get_allocator() {
+		allocator_type get_allocator() const {
 			return _allocator;
 		}
 		ft::pair<iterator, bool> insert(const value_type& val) {
-			rb_node x = _root.parent;
+			rb_node x = _root.get_parent();
 			rb_node y = &_root;
 			bool addLeft = true;
 			while (x != 0) {
@@ -517,14 +599,76 @@ namespace ft {
 		}
 		template<class It>
 		void insert(It first, It last) {
+			if (_size == 0 && first != last)
+				first = _build_sorted_prefix(first, last);
 			for (; first != last; ++first)
 				insert(*first);
 		}
+		template<class It>
+		void insert(ft::sorted_unique_t, It first, It last) {
+			if (_size == 0 && first != last) {
+				rb_node head = _create_node(*first);
+				rb_node tail = head;
+				size_type n = 1;
+				for (++first; first != last; ++first, ++n) {
+					tail->right = _create_node(*first);
+					tail = tail->right;
+				}
+				tail->right = 0;
+				_build_from_list(head, n);
+			}
+			for (; first != last; ++first)
+				insert(end(), *first);
+		}
+		insert_return_type insert(node_handle&& nh) {
+			insert_return_type res;
+			res.position = _insert_node(nh, res.inserted);
+			res.node = std::move(nh);
+			return res;
+		}
+		iterator insert(const_iterator, node_handle&& nh) {
+			bool inserted;
+			return _insert_node(nh, inserted);
+		}
+		// map only: assigns to the mapped value when k is present
+		template<class M>
+		ft::pair<iterator, bool> insert_or_assign(const key_type& k, M&& obj) {
+			rb_node parent;
+			bool insert_left;
+			rb_node x = _locate_unique(k, parent, insert_left);
+			if (x != NULL) {
+				x->val.second = std::forward<M>(obj);
+				return ft::pair<iterator, bool>(iterator(x), false);
+			}
+			return ft::pair<iterator, bool>(_attach(_create_node(k, std::forward<M>(obj)), parent, insert_left), true);
+		}
+		// Moves every element of right, all of which must order after this
+		// tree's elements, to the end of this tree in O(log n). Like merge,
+		// it copies instead when the nodes could not be freed from here.
+		void join(rbTree& right) {
+			if (right._root.get_parent() == NULL)
+				return;
+			if (_root.get_parent() == NULL) {
+				swap(right);
+				return;
+			}
+			if (!_comp(KeyOfValue()(_root.right->val), KeyOfValue()(right._root.left->val)))
+				throw std::invalid_argument("rbTree::join: key ranges overlap");
+			_join_from(right, ft::integral_constant<bool, !ft::has_bulk_release<node_allocator>::value>());
+		}
+		// Moves the elements whose keys are not yet here out of source. With
+		// equal allocators the nodes are relinked, otherwise copied.
+		void merge(rbTree& source) {
+			if (this == &source)
+				return;
+			_merge(source, ft::integral_constant<bool, !ft::has_bulk_release<node_allocator>::value>());
+		}
         Compare key_comp() const {
             return _comp;
         }
-		iterator lower_bound(const key_type& key) {
-			rb_node x = _root.parent;
+		template<class K>
+		iterator lower_bound(const K& key) {
+			rb_node x = _root.get_parent();
 			rb_node y = &_root;
 			while (x != NULL) {
 				if (!_comp(KeyOfValue()(x->val), key))
@@ -534,8 +678,9 @@ namespace ft {
 			}
 			return iterator(y);
 		}
-		const_iterator lower_bound(const key_type& key) const {
-			const_rb_node x = _root.parent;
+		template<class K>
+		const_iterator lower_bound(const K& key) const {
+			const_rb_node x = _root.get_parent();
 			const_rb_node y = &_root;
 			while (x != NULL) {
 				if (!_comp(KeyOfValue()(x->val), key))
@@ -563,40 +708,66 @@ namespace ft {
 		size_type size() const {
 			return _size;
 		}
+		// Keeps the elements less than k and moves the rest into right. The
+		// relinking is O(log n), and so is the whole split on counted nodes;
+		// plain nodes have no subtree sizes, so the two sizes are recounted
+		// by walking both halves until the shorter one ends, which makes it
+		// O(log n + min(k, n - k)). The moved elements are copied, O(n - k)
+		// more, when right could not free their nodes.
+		void split(const key_type& k, rbTree& right) {
+			right.clear();
+			if (_root.get_parent() == NULL)
+				return;
+			_split_into(k, right, ft::integral_constant<bool, !ft::has_bulk_release<node_allocator>::value>());
+		}
         void swap(rbTree& sw) {
-            if (_root.parent == 0)
+            if (_root.get_parent() == 0)
 			{
-				if (sw._root.parent != 0)
+				if (sw._root.get_parent() != 0)
 				{
-					_root.parent = sw._root.parent;
+					_root.set_parent(sw._root.get_parent());
 					_root.left = sw._root.left;
 					_root.right = sw._root.right;
-					_root.parent->parent = &_root;
-					sw._root.parent = 0;
+					_root.get_parent()->set_parent(&_root);
+					sw._root.set_parent(0);
 					sw._root.left = &sw._root;
 					sw._root.right = &sw._root;
 				}
-			} else if (_root.parent == 0) {
-				sw._root.parent = _root.parent;
+			} else if (sw._root.get_parent() == 0) {
+				sw._root.set_parent(_root.get_parent());
 				sw._root.right = _root.right;
 				sw._root.left = _root.left;
-				sw._root.parent->parent = &sw._root;
+				sw._root.get_parent()->set_parent(&sw._root);
 
-				_root.parent = 0;
+				_root.set_parent(0);
 				_root.left = &_root;
 				_root.right = &_root;
 			} else {
-				std::swap(_root.parent, sw._root.parent);
+				rb_node top = _root.get_parent();
+				_root.set_parent(sw._root.get_parent());
+				sw._root.set_parent(top);
 				std::swap(_root.left, sw._root.left);
 				std::swap(_root.right, sw._root.right);
-				_root.parent->parent = &_root;
-				sw._root.parent->parent = &sw._root;
+				_root.get_parent()->set_parent(&_root);
+				sw._root.get_parent()->set_parent(&sw._root);
 			}
                 std::swap(_size, sw._size);
                 std::swap(_comp, sw._comp);
+                std::swap(_nodeAlloc, sw._nodeAlloc);
         }
-		iterator upper_bound(const key_type& k) {
-			rb_node x = _root.parent;
+		// map only: the mapped value is built from args only when k is absent
+		template<class... Args>
+		ft::pair<iterator, bool> try_emplace(const key_type& k, Args&&... args) {
+			rb_node parent;
+			bool insert_left;
+			rb_node x = _locate_unique(k, parent, insert_left);
+			if (x != NULL)
+				return ft::pair<iterator, bool>(iterator(x), false);
+			return ft::pair<iterator, bool>(_attach(_create_node(ft::emplace_second, k, std::forward<Args>(args)...), parent, insert_left), true);
+		}
+		template<class K>
+		iterator upper_bound(const K& k) {
+			rb_node x = _root.get_parent();
 			rb_node y = &_root;
 			while (x != 0) {
 				if (_comp(k, KeyOfValue()(x->val))) {
@@ -608,8 +779,9 @@ namespace ft {
 			}
 			return iterator(y);
 		}
-		const_iterator upper_bound(const key_type& k) const {
-			const_rb_node x = _root.parent;
+		template<class K>
+		const_iterator upper_bound(const K& k) const {
+			const_rb_node x = _root.get_parent();
 			const_rb_node y = &_root;
 			while (x != 0) {
 				if (_comp(k, KeyOfValue()(x->val))) {
@@ -621,21 +793,66 @@ namespace ft {
 			}
 			return const_iterator(y);
 		}
+		// number of elements strictly less than k
+		size_type rank(const key_type& k) const {
+			_require_counts();
+			size_type r = 0;
+			const_rb_node x = _root.get_parent();
+			while (x != NULL) {
+				if (_comp(KeyOfValue()(x->val), k)) {
+					r += node_traits::count(x->left) + 1;
+					x = x->right;
+				}
+				else
+					x = x->left;
+			}
+			return r;
+		}
+		// number of elements in [lo, hi)
+		size_type count_range(const key_type& lo, const key_type& hi) const {
+			if (!_comp(lo, hi))
+				return 0;
+			return rank(hi) - rank(lo);
+		}
+		// the i-th element in order, end() when i >= size()
+		iterator select(size_type i) {
+			_require_counts();
+			if (i >= _size)
+				return end();
+			rb_node x = _root.get_parent();
+			for (;;) {
+				size_type left = node_traits::count(x->left);
+				if (i < left)
+					x = x->left;
+				else if (i == left)
+					return iterator(x);
+				else {
+					i -= left + 1;
+					x = x->right;
+				}
+			}
+		}
+		const_iterator select(size_type i) const {
+			return const_cast<rbTree*>(this)->select(i);
+		}
 		void balance() {
-			bool is = is_balanced(_root.parent);
+			bool is = is_balanced(_root.get_parent());
 			std::cout << "RB Tree is " << (!is ? "not " : "") << "balanced" << std::endl;
 		}
 		void printRBT()
 		{
-			_printRBT(_root.parent, 10);
+			_printRBT(_root.get_parent(), 10);
 		}
 	private:
-		rbNode<value_type>	_root;
+		base_node			_root;
 		size_type			_size;
 		allocator_type 		_allocator;
 		node_allocator		_nodeAlloc;
 		Compare				_comp;
 
+		static void _require_counts() {
+			static_assert(node_traits::counted, "rank/select need a tree built with ft::counted_nodes");
+		}
 		void _printRBT(rb_node p, int indent)
 		{
 			if (p != NULL)
@@ -646,7 +863,7 @@ namespace ft {
 					std::cout << std::setw(indent) << ' ';
 				if (p->right)
 					std::cout<<" /\n" << std::setw(indent) << ' ';
-				std::cout << (p->clr == red ? "\033[1;38;5;9m" : "\033[1;38;5;247m") <<  p->val.first << "\033[0m" << std::endl;
+				std::cout << (p->color() == red ? "\033[1;38;5;9m" : "\033[1;38;5;247m") <<  p->val.first << "\033[0m" << std::endl;
 				if(p->left)
 				{
 					std::cout << std::setw(indent) << ' ' <<" \\\n";
@@ -658,43 +875,48 @@ namespace ft {
 			rb_node y = x->right;
 			x->right = y->left;
 			if (y->left != NULL)
-				y->left->parent = x;
-			y->parent = x->parent;
-			if (x == _root.parent)
-				_root.parent = y;
-			else if (x == x->parent->left)
-				x->parent->left = y;
+				y->left->set_parent(x);
+			y->set_parent(x->get_parent());
+			if (x == _root.get_parent())
+				_root.set_parent(y);
+			else if (x == x->get_parent()->left)
+				x->get_parent()->left = y;
 			else
-				x->parent->right = y;
+				x->get_parent()->right = y;
 			y->left = x;
-			x->parent = y;
+			x->set_parent(y);
+			node_traits::update(x);
+			node_traits::update(y);
 		}
 		void _rightRotation(rb_node x) {
 			rb_node y = x->left;
 			x->left = y->right;
 			if (y->right != NULL)
-				y->right->parent = x;
-			y->parent = x->parent;
-			if (x == _root.parent)
-				_root.parent = y;
-			else if (x == x->parent->right)
-				x->parent->right = y;
+				y->right->set_parent(x);
+			y->set_parent(x->get_parent());
+			if (x == _root.get_parent())
+				_root.set_parent(y);
+			else if (x == x->get_parent()->right)
+				x->get_parent()->right = y;
 			else
-				x->parent->left = y;
+				x->get_parent()->left = y;
 			y->right = x;
-			x->parent = y;
+			x->set_parent(y);
+			node_traits::update(x);
+			node_traits::update(y);
 		}
 		rb_node _clone_node(const_rb_node x) {
 			rb_node tmp = _nodeAlloc.allocate(1);
 			_allocator.construct(&tmp->val, x->val);
-			tmp->clr = x->clr;
+			tmp->set_color(x->color());
+			node_traits::copy(tmp, x);
 			tmp->right = NULL;
 			tmp->left = NULL;
 			return tmp;
 		}
 		rb_node _copy(rb_node x, rb_node y) {
 			rb_node top = _clone_node(x);
-			top->parent = y;
+			top->set_parent(y);
 			if (x->right)
 				top->right = _copy(x->right, top);
 			y = top;
@@ -702,7 +924,7 @@ namespace ft {
 			while (x != NULL) {
 				rb_node clone = _clone_node(x);
 				y->left = clone;
-				clone->parent = y;
+				clone->set_parent(y);
 				if (x->right)
 					clone->right = _copy(x->right, clone);
 				y = clone;
@@ -710,29 +932,601 @@ namespace ft {
 			}
 			return top;
 		}
-		void _erase(rb_node x) {
+		// Copies of at least parallel_copy_threshold nodes are split at the
+		// top levels and the subtrees below are cloned on several threads,
+		// each taking nodes from the allocator itself; so only stateless
+		// allocators without per-tree pools qualify.
+		rb_node _copy_tree(rb_node x, rb_node y, size_type n) {
+			if (n < parallel_copy_threshold || !std::is_empty<node_allocator>::value
+				|| ft::has_bulk_release<node_allocator>::value)
+				return _copy(x, y);
+			// asking for the thread count is a system call, so only big copies do
+			size_type threads = ft::parallel_threads(n, parallel_copy_threshold / 4);
+			if (threads <= 1)
+				return _copy(x, y);
+			return _copy_parallel(x, y, threads);
+		}
+		// a subtree left for a worker: source is cloned under parent and the
+		// clone stored in link once every worker is done
+		struct copy_task {
+			rb_node		source;
+			rb_node		parent;
+			rb_node*	link;
+			rb_node		clone;
+		};
+		rb_node _copy_parallel(rb_node x, rb_node y, size_type threads) {
+			// about four subtrees a thread, as red-black subtrees of one
+			// depth differ in size
+			unsigned depth = 1;
+			while ((size_type(1) << depth) < threads * 4)
+				++depth;
+			ft::vector<copy_task> tasks;
+			rb_node top = _copy_top(x, y, depth, tasks);
+			try {
+				ft::parallel_for(tasks.size(), threads, [this, &tasks](size_type i) {
+					tasks[i].clone = _copy(tasks[i].source, tasks[i].parent);
+				});
+			}
+			catch (...) {
+				for (size_type i = 0; i < tasks.size(); ++i)
+					*tasks[i].link = tasks[i].clone;
+				_erase(top);
+				throw;
+			}
+			for (size_type i = 0; i < tasks.size(); ++i)
+				*tasks[i].link = tasks[i].clone;
+			return top;
+		}
+		// clones the top depth levels of x and leaves the subtrees below
+		// them in tasks
+		rb_node _copy_top(rb_node x, rb_node y, unsigned depth, ft::vector<copy_task>& tasks) {
+			rb_node top = _clone_node(x);
+			top->set_parent(y);
+			rb_node* links[2] = {&top->left, &top->right};
+			rb_node children[2] = {x->left, x->right};
+			for (int i = 0; i < 2; ++i) {
+				if (!children[i])
+					continue;
+				if (depth > 1)
+					*links[i] = _copy_top(children[i], top, depth - 1, tasks);
+				else {
+					copy_task t = {children[i], top, links[i], 0};
+					tasks.push_back(t);
+				}
+			}
+			return top;
+		}
+		// frees the subtree x and returns how many nodes it held
+		size_type _erase(rb_node x) {
+			size_type n = 0;
 			while (x != NULL) {
-				_erase(x->right);
+				n += _erase(x->right) + 1;
 				rb_node y = x->left;
 				_allocator.destroy(&x->val);
-				_nodeAlloc.deallocate(x, 1);
+				_nodeAlloc.deallocate(static_cast<node_type*>(x), 1);
 				x = y;
 			}
+			return n;
 		}
-		rb_node _create_node(const value_type& x) {
+		void _destroy(rb_node x) {
+			while (x != NULL) {
+				_destroy(x->right);
+				_allocator.destroy(&x->val);
+				x = x->left;
+			}
+		}
+		// pooled node allocators hand back all nodes at once, so only the
+		// values need a walk, and not even that when they are trivial
+		void _erase_all() {
+			_erase_all(ft::has_bulk_release<node_allocator>());
+		}
+		void _erase_all(ft::false_type) {
+			_erase(_root.get_parent());
+		}
+		void _erase_all(ft::true_type) {
+			if (!ft::is_trivially_destructible<value_type>::value)
+				_destroy(_root.get_parent());
+			_nodeAlloc.release();
+		}
+		// Builds the tree from n nodes chained in order through ->right.
+		// Subtree sizes differ by at most one, so only the last level can be
+		// incomplete; colouring it red and everything above black is valid.
+		void _build_from_list(rb_node list, size_type n) {
+			size_type levels = 0;
+			while ((size_type(1) << levels) - 1 < n)
+				++levels;
+			size_type red_depth = ((size_type(1) << levels) - 1 == n) ? levels : levels - 1;
+			rb_node top = _build(list, n, 0, red_depth);
+			top->set_parent(&_root);
+			_root.set_parent(top);
+			_root.left = base_node::minimum(top);
+			_root.right = base_node::maximum(top);
+			_size = n;
+		}
+		rb_node _build(rb_node& list, size_type n, size_type depth, size_type red_depth) {
+			if (n == 0)
+				return 0;
+			rb_node left = _build(list, (n - 1) / 2, depth + 1, red_depth);
+			rb_node x = list;
+			list = list->right;
+			x->left = left;
+			if (left)
+				left->set_parent(x);
+			x->right = _build(list, n - 1 - (n - 1) / 2, depth + 1, red_depth);
+			if (x->right)
+				x->right->set_parent(x);
+			x->set_color((depth == red_depth) ? red : black);
+			node_traits::init(x, n);
+			return x;
+		}
+		// links the strictly increasing run at the front of [first, last)
+		// into a balanced tree and returns where the run stopped
+		template<class It>
+		It _build_sorted_prefix(It first, It last) {
+			rb_node head = _create_node(*first);
+			rb_node tail = head;
+			size_type n = 1;
+			for (++first; first != last; ++first, ++n) {
+				rb_node z = _create_node(*first);
+				if (!_comp(KeyOfValue()(tail->val), KeyOfValue()(z->val))) {
+					_allocator.destroy(&z->val);
+					_nodeAlloc.deallocate(static_cast<node_type*>(z), 1);
+					break;
+				}
+				tail->right = z;
+				tail = z;
+			}
+			tail->right = 0;
+			_build_from_list(head, n);
+			return first;
+		}
+		// with m much smaller than n, m lookups of O(log n) beat walking both
+		static bool _probe_cheaper(size_type m, size_type n) {
+			size_type log_n = 1;
+			while (log_n < 64 && (size_type(1) << log_n) < n)
+				++log_n;
+			return m * log_n < n;
+		}
+		// elements of a that are (keep_found) or are not (!keep_found) in b
+		void _assign_probed(const rbTree& a, const rbTree& b, bool keep_found) {
+			rb_node head = 0;
+			rb_node tail = 0;
+			size_type n = 0;
+			for (const_iterator it = a.begin(); it != a.end(); ++it) {
+				if ((b.find(KeyOfValue()(*it)) != b.end()) == keep_found)
+					_chain(head, tail, n, *it);
+			}
+			_assign_chain(head, tail, n);
+		}
+		// intersection when a is the large side: values still come from a
+		void _assign_probed_reverse(const rbTree& a, const rbTree& b) {
+			rb_node head = 0;
+			rb_node tail = 0;
+			size_type n = 0;
+			for (const_iterator it = b.begin(); it != b.end(); ++it) {
+				const_iterator found = a.find(KeyOfValue()(*it));
+				if (found != a.end())
+					_chain(head, tail, n, *found);
+			}
+			_assign_chain(head, tail, n);
+		}
+		void _assign_merged(const rbTree& a, const rbTree& b, bool only_a, bool only_b, bool both) {
+			rb_node head = 0;
+			rb_node tail = 0;
+			size_type n = 0;
+			const_iterator i = a.begin();
+			const_iterator j = b.begin();
+			while (i != a.end() && j != b.end()) {
+				if (_comp(KeyOfValue()(*i), KeyOfValue()(*j))) {
+					if (only_a)
+						_chain(head, tail, n, *i);
+					++i;
+				}
+				else if (_comp(KeyOfValue()(*j), KeyOfValue()(*i))) {
+					if (only_b)
+						_chain(head, tail, n, *j);
+					++j;
+				}
+				else {
+					if (both)
+						_chain(head, tail, n, *i);
+					++i;
+					++j;
+				}
+			}
+			for (; only_a && i != a.end(); ++i)
+				_chain(head, tail, n, *i);
+			for (; only_b && j != b.end(); ++j)
+				_chain(head, tail, n, *j);
+			_assign_chain(head, tail, n);
+		}
+		void _chain(rb_node& head, rb_node& tail, size_type& n, const value_type& val) {
+			rb_node z = _create_node(val);
+			if (tail)
+				tail->right = z;
+			else
+				head = z;
+			tail = z;
+			++n;
+		}
+		// replaces the contents with an ordered chain built by _chain; the
+		// old nodes go only now, so a or b may be *this
+		void _assign_chain(rb_node head, rb_node tail, size_type n) {
+			clear();
+			if (n == 0)
+				return;
+			tail->right = 0;
+			_build_from_list(head, n);
+		}
+		// links the handle's node in unless its key is taken; the handle is
+		// emptied only on success
+		iterator _insert_node(node_handle& nh, bool& inserted) {
+			inserted = false;
+			if (nh.empty())
+				return end();
+			rb_node parent;
+			bool insert_left;
+			rb_node x = _locate_unique(KeyOfValue()(nh._node->val), parent, insert_left);
+			if (x != NULL)
+				return iterator(x);
+			inserted = true;
+			return _attach(nh._release(), parent, insert_left);
+		}
+		void _merge(rbTree& source, ft::true_type) {
+			if (!(_nodeAlloc == source._nodeAlloc)) {
+				_merge(source, ft::false_type());
+				return;
+			}
+			iterator it = source.begin();
+			while (it != source.end()) {
+				rb_node z = it.node;
+				++it;
+				rb_node parent;
+				bool insert_left;
+				if (_locate_unique(KeyOfValue()(z->val), parent, insert_left) == NULL) {
+					source._unlink(z);
+					--source._size;
+					_attach(z, parent, insert_left);
+				}
+			}
+		}
+		void _merge(rbTree& source, ft::false_type) {
+			iterator it = source.begin();
+			while (it != source.end()) {
+				if (insert(*it).second)
+					source.erase(it++);
+				else
+					++it;
+			}
+		}
+		void _join_from(rbTree& right, ft::true_type) {
+			if (!(_nodeAlloc == right._nodeAlloc)) {
+				_join_from(right, ft::false_type());
+				return;
+			}
+			size_type n = _size + right._size;
+			rb_node pivot = right._unlink(right._root.left);
+			rb_node other = right._root.get_parent();
+			right._adopt(0, 0);
+			size_type h;
+			rb_node top = _join(_root.get_parent(), _black_height(_root.get_parent()), pivot, other, _black_height(other), h);
+			_adopt(top, n);
+		}
+		// each copy goes in at the end, so the hint makes it O(1) amortised
+		void _join_from(rbTree& right, ft::false_type) {
+			for (const_iterator it = right.begin(); it != right.end(); ++it)
+				insert(end(), *it);
+			right.clear();
+		}
+		void _split_into(const key_type& k, rbTree& right, ft::true_type) {
+			if (!(_nodeAlloc == right._nodeAlloc)) {
+				_split_into(k, right, ft::false_type());
+				return;
+			}
+			size_type n = _size;
+			rb_node l, r;
+			size_type hl, hr;
+			_split(_root.get_parent(), _black_height(_root.get_parent()), k, l, hl, r, hr);
+			_adopt_split(l, r, n, right, ft::integral_constant<bool, node_traits::counted>());
+		}
+		void _split_into(const key_type& k, rbTree& right, ft::false_type) {
+			iterator first = lower_bound(k);
+			for (const_iterator it = first; it != end(); ++it)
+				right.insert(right.end(), *it);
+			erase(first, end());
+		}
+		// makes the detached subtree top the whole tree
+		void _adopt(rb_node top, size_type n) {
+			_size = n;
+			if (top == NULL) {
+				_root.set_parent(0);
+				_root.left = &_root;
+				_root.right = &_root;
+				return;
+			}
+			top->set_color(black);
+			top->set_parent(&_root);
+			_root.set_parent(top);
+			_root.left = base_node::minimum(top);
+			_root.right = base_node::maximum(top);
+		}
+		void _adopt_split(rb_node l, rb_node r, size_type, rbTree& right, ft::true_type) {
+			_adopt(l, node_traits::count(l));
+			right._adopt(r, node_traits::count(r));
+		}
+		void _adopt_split(rb_node l, rb_node r, size_type n, rbTree& right, ft::false_type) {
+			_adopt(l, 0);
+			right._adopt(r, 0);
+			size_type shorter = 0;
+			const_iterator i = begin();
+			const_iterator j = right.begin();
+			for (; i != end() && j != right.end(); ++i, ++j)
+				++shorter;
+			_size = (i == end()) ? shorter : n - shorter;
+			right._size = n - _size;
+		}
+		// black nodes on any path from x down to a leaf, x included
+		static size_type _black_height(const_rb_node x) {
+			size_type h = 0;
+			for (; x != NULL; x = x->left)
+				h += x->color() == black;
+			return h;
+		}
+		// Links l < k < r into one tree and returns its root, with its black
+		// height in h. The taller side is hung off the header while k is
+		// placed on its spine, so the usual insert fix-up can run; the cost
+		// is O(|hl - hr| + 1).
+		rb_node _join(rb_node l, size_type hl, rb_node k, rb_node r, size_type hr, size_type& h) {
+			if (l && l->color() == red)
+				l->set_color(black), ++hl;
+			if (r && r->color() == red)
+				r->set_color(black), ++hr;
+			k->set_color(red);
+			if (hl == hr) {
+				k->left = l;
+				k->right = r;
+				if (l)
+					l->set_parent(k);
+				if (r)
+					r->set_parent(k);
+				k->set_color(black);
+				node_traits::update(k);
+				h = hl + 1;
+				return k;
+			}
+			rb_node tall = hl > hr ? l : r;
+			size_type hc = hl > hr ? hl : hr;
+			size_type target = hl > hr ? hr : hl;
+			_root.set_parent(tall);
+			tall->set_parent(&_root);
+			rb_node p = 0;
+			rb_node c = tall;
+			while (c != NULL && (c->color() == red || hc != target)) {
+				hc -= c->color() == black;
+				p = c;
+				c = hl > hr ? c->right : c->left;
+			}
+			if (hl > hr) {
+				k->left = c;
+				k->right = r;
+				p->right = k;
+				if (r)
+					r->set_parent(k);
+			}
+			else {
+				k->left = l;
+				k->right = c;
+				p->left = k;
+				if (l)
+					l->set_parent(k);
+			}
+			if (c)
+				c->set_parent(k);
+			k->set_parent(p);
+			node_traits::update(k);
+			_fix_counts(p);
+			h = (hl > hr ? hl : hr) + _insert_fixup(k);
+			return _root.get_parent();
+		}
+		// splits the subtree x of black height h into keys < k and the rest
+		void _split(rb_node x, size_type h, const key_type& k, rb_node& l, size_type& hl, rb_node& r, size_type& hr) {
+			if (x == NULL) {
+				l = r = 0;
+				hl = hr = 0;
+				return;
+			}
+			size_type hc = h - (x->color() == black);
+			rb_node left = x->left;
+			rb_node right = x->right;
+			rb_node part;
+			size_type hpart;
+			if (_comp(KeyOfValue()(x->val), k)) {
+				_split(right, hc, k, part, hpart, r, hr);
+				l = _join(left, hc, x, part, hpart, hl);
+			}
+			else {
+				_split(left, hc, k, l, hl, part, hpart);
+				r = _join(part, hpart, x, right, hc, hr);
+			}
+		}
+		// takes z out of the tree and rebalances; the node is not freed
+		rb_node _unlink(rb_node z) {
+			rb_node y = z;
+			rb_node x = 0;
+			rb_node xp = 0;
+			if (y->left == NULL)
+				x = y->right;
+			else {
+				if (y->right == NULL)
+					x = y->left;
+				else {
+					y = y->right;
+					while (y->left)
+						y = y->left;
+					x = y->right;
+				}
+			}
+			if (y == z) {
+				xp = y->get_parent();
+				if (x)
+					x->set_parent(y->get_parent());
+				if (_root.get_parent() == z)
+					_root.set_parent(x);
+				else if (z->get_parent()->left == z)
+					z->get_parent()->left = x;
+				else
+					z->get_parent()->right = x;
+				if (_root.left == z) {
+					if (z->right == NULL)
+						_root.left = z->get_parent();
+					else
+						_root.left = base_node::minimum(x);
+				}
+				if (_root.right == z) {
+					if (z->left == NULL)
+						_root.right = z->get_parent();
+					else
+						_root.right = base_node::maximum(x);
+				}
+			}
+			else {
+				z->left->set_parent(y);
+				y->left = z->left;
+				if (y != z->right) {
+					xp = y->get_parent();
+					if (x)
+						x->set_parent(y->get_parent());
+					y->get_parent()->left = x;
+					y->right = z->right;
+					z->right->set_parent(y);
+				}
+				else
+					xp = y;
+				if (_root.get_parent() == z)
+					_root.set_parent(y);
+				else if (z->get_parent()->left == z)
+					z->get_parent()->left = y;
+				else
+					z->get_parent()->right = y;
+				y->set_parent(z->get_parent());
+				rbColor c = y->color();
+				y->set_color(z->color());
+				z->set_color(c);
+				y = z;
+			}
+			_fix_counts(xp);
+			if (y->color() != red) {
+				while (x != _root.get_parent() && (x == NULL || x->color() == black)) {
+					if (x == xp->left) {
+						rb_node w = xp->right;
+						if (w->color() == red) {
+							w->set_color(black);
+							xp->set_color(red);
+							_leftRotation(xp);
+							w = xp->right;
+						}
+						if ((w->left == NULL || w->left->color() == black) && (w->right == NULL || w->right->color() == black)) {
+							w->set_color(red);
+							x = xp;
+							xp = xp->get_parent();
+						}
+						else {
+							if (w->right == NULL || w->right->color() == black) {
+								w->left->set_color(black);
+								w->set_color(red);
+								_rightRotation(w);
+								w = xp->right;
+							}
+							w->set_color(xp->color());
+							xp->set_color(black);
+							if (w->right)
+								w->right->set_color(black);
+							_leftRotation(xp);
+							break;
+						}
+					}
+					else {
+						rb_node w = xp->left;
+						if (w->color() == red) {
+							w->set_color(black);
+							xp->set_color(red);
+							_rightRotation(xp);
+							w = xp->left;
+						}
+						if ((w->right == NULL || w->right->color() == black) && (w->left == NULL || w->left->color() == black)) {
+							w->set_color(red);
+							x = xp;
+							xp = xp->get_parent();
+						}
+						else {
+							if (w->left == NULL || w->left->color() == black) {
+								w->right->set_color(black);
+								w->set_color(red);
+								_leftRotation(w);
+								w = xp->left;
+							}
+							w->set_color(xp->color());
+							xp->set_color(black);
+							if (w->left)
+								w->left->set_color(black);
+							_rightRotation(xp);
+							break;
+						}
+					}
+				}
+				if (x)
+					x->set_color(black);
+			}
+			return y;
+		}
+		// recomputes subtree sizes from x up to the root after a link change
+		void _fix_counts(rb_node x) {
+			if (node_traits::counted) {
+				for (; x != &_root; x = x->get_parent())
+					node_traits::update(x);
+			}
+		}
+		template<class... Args>
+		rb_node _create_node(Args&&... args) {
 			rb_node tmp = _nodeAlloc.allocate(1);
-			_allocator.construct(&tmp->val, x);
+			_allocator.construct(&tmp->val, std::forward<Args>(args)...);
 			return tmp;
 		}
+		// one descent: returns the node holding k, or null with the attach
+		// point left in parent / insert_left
+		rb_node _locate_unique(const key_type& k, rb_node& parent, bool& insert_left) {
+			rb_node x = _root.get_parent();
+			rb_node y = &_root;
+			rb_node candidate = 0;
+			insert_left = true;
+			while (x != NULL) {
+				y = x;
+				insert_left = !_comp(KeyOfValue()(x->val), k);
+				if (insert_left)
+					candidate = x, x = x->left;
+				else
+					x = x->right;
+			}
+			if (candidate != NULL && !_comp(k, KeyOfValue()(candidate->val)))
+				return candidate;
+			parent = y;
+			return 0;
+		}
+		iterator _attach(rb_node z, rb_node parent, bool insert_left) {
+			_insert_and_rebalance(insert_left, z, parent);
+			++_size;
+			return iterator(z);
+		}
 		void _insert_and_rebalance(const bool insert_left, rb_node x, rb_node y) {
-			x->parent = y;
+			x->set_parent(y);
 			x->left = 0;
 			x->right = 0;
-			x->clr = red;
+			x->set_color(red);
+			node_traits::init(x, 1);
 			if (insert_left) {
 				y->left = x;
 				if (y == &_root) {
-					_root.parent = x;
+					_root.set_parent(x);
 					_root.right = x;
 				}
 				else if (y == _root.left)
@@ -743,46 +1537,54 @@ namespace ft {
 				if (y == _root.right)
 					_root.right = x;
 			}
-			while (x != _root.parent && x->parent->clr == red) {
-				rb_node xpp = x->parent->parent;
-				if (x->parent == xpp->left) {
+			_fix_counts(y);
+			_insert_fixup(x);
+		}
+		// restores the red rule above the red node x; true when the root
+		// had to turn black, which grows the black height by one
+		bool _insert_fixup(rb_node x) {
+			while (x != _root.get_parent() && x->get_parent()->color() == red) {
+				rb_node xpp = x->get_parent()->get_parent();
+				if (x->get_parent() == xpp->left) {
 					rb_node xppr = xpp->right;
-					if (xppr && xppr->clr == red) {
-						x->parent->clr = black;
-						xppr->clr = black;
-						xpp->clr = red;
+					if (xppr && xppr->color() == red) {
+						x->get_parent()->set_color(black);
+						xppr->set_color(black);
+						xpp->set_color(red);
 						x = xpp;
 					}
 					else {
-						if (x == x->parent->right) {
-							x = x->parent;
+						if (x == x->get_parent()->right) {
+							x = x->get_parent();
 							_leftRotation(x); // 4
 						}
-						x->parent->clr = black;
-						xpp->clr = red;
+						x->get_parent()->set_color(black);
+						xpp->set_color(red);
 						_rightRotation(xpp); // 1
 					}
 				}
 				else {
 					rb_node xppl = xpp->left;
-					if (xppl && xppl->clr == red) {
-						x->parent->clr = black;
-						xppl->clr = black;
-						xpp->clr = red;
+					if (xppl && xppl->color() == red) {
+						x->get_parent()->set_color(black);
+						xppl->set_color(black);
+						xpp->set_color(red);
 						x = xpp;
 					}
 					else {
-						if (x == x->parent->left) {
-							x = x->parent;
+						if (x == x->get_parent()->left) {
+							x = x->get_parent();
 							_rightRotation(x); // 3
 						}
-						x->parent->clr = black;
-						xpp->clr = red;
+						x->get_parent()->set_color(black);
+						xpp->set_color(red);
 						_leftRotation(xpp); // 2
 					}
 				}
 			}
-			_root.parent->clr = black;
+			bool grew = _root.get_parent()->color() == red;
+			_root.get_parent()->set_color(black);
+			return grew;
 		}
 		iterator _insert(const_rb_node x, const_rb_node y, const value_type& val) {
 			bool insert_left = (x != 0 || y == &_root || _comp(KeyOfValue()(val), KeyOfValue()(y->val)));
@@ -812,32 +1614,32 @@ namespace ft {
 			return false;
 		}
 	};
-    template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-    inline bool operator==(const rbTree<Key, Val, KeyOfValue, Compare, Alloc>& tr1, const rbTree<Key, Val, KeyOfValue, Compare, Alloc>& tr2) {
+    template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename NP>
+    inline bool operator==(const rbTree<Key, Val, KeyOfValue, Compare, Alloc, NP>& tr1, const rbTree<Key, Val, KeyOfValue, Compare, Alloc, NP>& tr2) {
         return tr1.size() == tr1.size() && ft::equal(tr1.begin(), tr1.end(), tr2.begin());
     }
-    template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-    inline bool operator!=(const rbTree<Key, Val, KeyOfValue, Compare, Alloc>& tr1, const rbTree<Key, Val, KeyOfValue, Compare, Alloc>& tr2) {
+    template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename NP>
+    inline bool operator!=(const rbTree<Key, Val, KeyOfValue, Compare, Alloc, NP>& tr1, const rbTree<Key, Val, KeyOfValue, Compare, Alloc, NP>& tr2) {
         return !(tr1 == tr2);
     }
-    template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-    inline bool operator<(const rbTree<Key, Val, KeyOfValue, Compare, Alloc>& tr1, const rbTree<Key, Val, KeyOfValue, Compare, Alloc>& tr2) {
+    template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename NP>
+    inline bool operator<(const rbTree<Key, Val, KeyOfValue, Compare, Alloc, NP>& tr1, const rbTree<Key, Val, KeyOfValue, Compare, Alloc, NP>& tr2) {
         return ft::lexicographical_compare(tr1.begin(), tr1.end(), tr2.begin(), tr2.end());
     }
-    template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-    inline bool operator>(const rbTree<Key, Val, KeyOfValue, Compare, Alloc>& tr1, const rbTree<Key, Val, KeyOfValue, Compare, Alloc>& tr2) {
+    template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename NP>
+    inline bool operator>(const rbTree<Key, Val, KeyOfValue, Compare, Alloc, NP>& tr1, const rbTree<Key, Val, KeyOfValue, Compare, Alloc, NP>& tr2) {
         return tr2 < tr1;
     }
-    template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-    inline bool operator<=(const rbTree<Key, Val, KeyOfValue, Compare, Alloc>& tr1, const rbTree<Key, Val, KeyOfValue, Compare, Alloc>& tr2) {
+    template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename NP>
+    inline bool operator<=(const rbTree<Key, Val, KeyOfValue, Compare, Alloc, NP>& tr1, const rbTree<Key, Val, KeyOfValue, Compare, Alloc, NP>& tr2) {
         return !(tr2 < tr1);
     }
-    template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-    inline bool operator>=(const rbTree<Key, Val, KeyOfValue, Compare, Alloc>& tr1, const rbTree<Key, Val, KeyOfValue, Compare, Alloc>& tr2) {
+    template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename NP>
+    inline bool operator>=(const rbTree<Key, Val, KeyOfValue, Compare, Alloc, NP>& tr1, const rbTree<Key, Val, KeyOfValue, Compare, Alloc, NP>& tr2) {
         return !(tr1 < tr2);
     }
-    template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
-    inline void swap(rbTree<Key, Val, KeyOfValue, Compare, Alloc>& sw1, rbTree<Key, Val, KeyOfValue, Compare, Alloc>& sw2) {
+    template<typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename NP>
+    inline void swap(rbTree<Key, Val, KeyOfValue, Compare, Alloc, NP>& sw1, rbTree<Key, Val, KeyOfValue, Compare, Alloc, NP>& sw2) {
         sw1.swap(sw2);
     }
 }
@@ -0,0 +1,348 @@
+#ifndef SIMD_TREE_HPP
+#define SIMD_TREE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include "../iterator/RandomAccess.hpp"
+#include "../iterator/reverse_iterator.hpp"
+#include "../vector/vector.hpp"
+#include "frozen_staging.hpp"
+#include "pair.hpp"
+#if defined(__x86_64__) || defined(__i386__)
+# include <immintrin.h>
+# define FT_SIMD_X86
+#endif
+
+namespace ft {
+	// Integer keys the SIMD index can hold under std::less. They are stored
+	// as signed words of the same width, unsigned ones with the top bit
+	// flipped so that a signed compare keeps their order.
+	template <typename Key, typename Compare, bool = std::is_integral<Key>::value && (sizeof(Key) == 4 || sizeof(Key) == 8)>
+	struct simd_key {
+		static const bool value = false;
+	};
+	template <typename Key>
+	struct simd_key<Key, std::less<Key>, true> {
+		static const bool value = true;
+		typedef typename std::conditional<sizeof(Key) == 4, std::int32_t, std::int64_t>::type word;
+		typedef typename std::make_unsigned<Key>::type unsigned_key;
+
+		static word encode(Key k) {
+			const unsigned_key flip = std::is_signed<Key>::value ? 0 : unsigned_key(1) << (sizeof(Key) * 8 - 1);
+			return static_cast<word>(static_cast<unsigned_key>(k) ^ flip);
+		}
+	};
+
+	// Descent through the index: every node is one cache line of sorted
+	// keys, and the number of keys below x picks the child (or, on the leaf
+	// level, the position). The scalar count is the fallback for CPUs and
+	// word sizes without a vector compare.
+	template <typename Word>
+	struct simd_scalar {
+		static const std::size_t node = 64 / sizeof(Word);
+		typedef std::size_t (*function)(const Word*, const std::size_t*, std::size_t, Word);
+
+		static std::size_t rank(const Word* p, Word x) {
+			std::size_t c = 0;
+			for (std::size_t j = 0; j < node; ++j)
+				c += p[j] < x;
+			return c;
+		}
+		static std::size_t search(const Word* index, const std::size_t* offset, std::size_t levels, Word x) {
+			std::size_t k = 0;
+			for (std::size_t h = levels - 1; h > 0; --h)
+				k = k * (node + 1) + rank(index + offset[h] + k * node, x);
+			return k * node + rank(index + offset[0] + k * node, x);
+		}
+	};
+
+	template <typename Word>
+	struct simd_search;
+
+	template <>
+	struct simd_search<std::int32_t> : simd_scalar<std::int32_t> {
+#ifdef __SSE2__
+		static std::size_t rank_sse2(const std::int32_t* p, std::int32_t x) {
+			const __m128i v = _mm_set1_epi32(x);
+			const __m128i* n = reinterpret_cast<const __m128i*>(p);
+			unsigned mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(v, _mm_load_si128(n))))
+				| _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(v, _mm_load_si128(n + 1)))) << 4
+				| _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(v, _mm_load_si128(n + 2)))) << 8
+				| _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(v, _mm_load_si128(n + 3)))) << 12;
+			return __builtin_popcount(mask);
+		}
+		static std::size_t sse2(const std::int32_t* index, const std::size_t* offset, std::size_t levels, std::int32_t x) {
+			std::size_t k = 0;
+			for (std::size_t h = levels - 1; h > 0; --h)
+				k = k * (node + 1) + rank_sse2(index + offset[h] + k * node, x);
+			return k * node + rank_sse2(index + offset[0] + k * node, x);
+		}
+#endif
+#ifdef FT_SIMD_X86
+		__attribute__((target("avx2")))
+		static std::size_t rank_avx2(const std::int32_t* p, std::int32_t x) {
+			const __m256i v = _mm256_set1_epi32(x);
+			const __m256i* n = reinterpret_cast<const __m256i*>(p);
+			unsigned mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(v, _mm256_load_si256(n))))
+				| _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(v, _mm256_load_si256(n + 1)))) << 8;
+			return __builtin_popcount(mask);
+		}
+		__attribute__((target("avx2")))
+		static std::size_t avx2(const std::int32_t* index, const std::size_t* offset, std::size_t levels, std::int32_t x) {
+			std::size_t k = 0;
+			for (std::size_t h = levels - 1; h > 0; --h)
+				k = k * (node + 1) + rank_avx2(index + offset[h] + k * node, x);
+			return k * node + rank_avx2(index + offset[0] + k * node, x);
+		}
+#endif
+		static function pick() {
+#ifdef FT_SIMD_X86
+			__builtin_cpu_init();
+			if (__builtin_cpu_supports("avx2"))
+				return &avx2;
+#endif
+#ifdef __SSE2__
+			return &sse2;
+#else
+			return &search;
+#endif
+		}
+	};
+
+	template <>
+	struct simd_search<std::int64_t> : simd_scalar<std::int64_t> {
+#ifdef FT_SIMD_X86
+		__attribute__((target("avx2")))
+		static std::size_t rank_avx2(const std::int64_t* p, std::int64_t x) {
+			const __m256i v = _mm256_set1_epi64x(x);
+			const __m256i* n = reinterpret_cast<const __m256i*>(p);
+			unsigned mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(v, _mm256_load_si256(n))))
+				| _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(v, _mm256_load_si256(n + 1)))) << 4;
+			return __builtin_popcount(mask);
+		}
+		__attribute__((target("avx2")))
+		static std::size_t avx2(const std::int64_t* index, const std::size_t* offset, std::size_t levels, std::int64_t x) {
+			std::size_t k = 0;
+			for (std::size_t h = levels - 1; h > 0; --h)
+				k = k * (node + 1) + rank_avx2(index + offset[h] + k * node, x);
+			return k * node + rank_avx2(index + offset[0] + k * node, x);
+		}
+#endif
+		// SSE2 has no 64-bit compare
+		static function pick() {
+#ifdef FT_SIMD_X86
+			__builtin_cpu_init();
+			if (__builtin_cpu_supports("avx2"))
+				return &avx2;
+#endif
+			return &search;
+		}
+	};
+
+	// Immutable sorted array of values with integer keys, searched through
+	// a static B+-tree of the keys (S+-tree): the leaf level is the keys
+	// themselves padded to whole nodes, every inner node holds the first
+	// key of each child but the first, and levels are stored top down in
+	// one 64-byte aligned block. A lookup is one node per level, each node
+	// ranked with a couple of vector compares.
+	template<typename Key, typename Val, typename KeyOfValue, typename Compare = std::less<Key>, typename Alloc = std::allocator<Val> >
+	class simdTree {
+	public:
+
+		typedef Val										value_type;
+		typedef Alloc									allocator_type;
+		typedef Key										key_type;
+		typedef std::size_t								size_type;
+		typedef ft::ConstRanIt<value_type>				iterator;
+		typedef ft::ConstRanIt<value_type>				const_iterator;
+		typedef ft::reverse_iterator<iterator>			reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>	const_reverse_iterator;
+	private:
+		typedef simd_key<Key, Compare>									keys;
+		typedef typename keys::word										word;
+		typedef simd_search<word>										search;
+		typedef typename Alloc::template rebind<word>::other			word_allocator;
+
+		static const size_type node = search::node;
+		static const size_type max_levels = 24;
+	public:
+
+		simdTree(const Compare& comp = Compare(), const allocator_type& a = allocator_type()) :
+			_values(0), _size(0), _raw(0), _raw_size(0), _index(0), _levels(0), _offset(),
+			_allocator(a), _comp(comp), _search(search::pick()) {}
+		simdTree(const simdTree& other) :
+			_values(0), _size(0), _raw(0), _raw_size(0), _index(0), _levels(0), _offset(),
+			_allocator(other._allocator), _comp(other._comp), _search(other._search) {
+			_build(other._values, other._size);
+		}
+		simdTree& operator=(const simdTree& other) {
+			if (this != &other) {
+				clear();
+				_comp = other._comp;
+				_build(other._values, other._size);
+			}
+			return *this;
+		}
+		~simdTree() {
+			clear();
+		}
+		// the range is sorted and holds no equal keys
+		template<class It>
+		void assign_sorted(It first, It last) {
+			ft::frozen_sorted<Val, It> staged(first, last);
+			_build(staged.begin(), staged.size());
+		}
+		// any order; of equal keys the first one is kept
+		template<class It>
+		void assign(It first, It last) {
+			ft::frozen_unique<Val, KeyOfValue, Compare> staged(first, last, _comp);
+			_build(staged.begin(), staged.size());
+		}
+		iterator begin() const {
+			return iterator(_values);
+		}
+		void clear() {
+			if (_values) {
+				for (size_type k = 0; k < _size; ++k)
+					_allocator.destroy(&_values[k]);
+				_allocator.deallocate(_values, _size);
+			}
+			if (_raw)
+				word_allocator(_allocator).deallocate(_raw, _raw_size);
+			_values = 0;
+			_size = 0;
+			_raw = 0;
+			_raw_size = 0;
+			_index = 0;
+			_levels = 0;
+		}
+		iterator end() const {
+			return iterator(_values + _size);
+		}
+		iterator find(const key_type& k) const {
+			size_type i = _lower_bound(k);
+			return (i == _size || _comp(k, KeyOfValue()(_values[i]))) ? end() : iterator(_values + i);
+		}
+		allocator_type get_allocator() const {
+			return _allocator;
+		}
+		Compare key_comp() const {
+			return _comp;
+		}
+		iterator lower_bound(const key_type& k) const {
+			return iterator(_values + _lower_bound(k));
+		}
+		size_type max_size() const {
+			return _allocator.max_size();
+		}
+		size_type size() const {
+			return _size;
+		}
+		void swap(simdTree& other) {
+			std::swap(_values, other._values);
+			std::swap(_size, other._size);
+			std::swap(_raw, other._raw);
+			std::swap(_raw_size, other._raw_size);
+			std::swap(_index, other._index);
+			std::swap(_levels, other._levels);
+			std::swap(_offset, other._offset);
+			std::swap(_allocator, other._allocator);
+			std::swap(_comp, other._comp);
+		}
+		// keys are integers, so the first key above k is the first one not below k + 1
+		iterator upper_bound(const key_type& k) const {
+			if (k == std::numeric_limits<key_type>::max())
+				return end();
+			return iterator(_values + _lower_bound(k + 1));
+		}
+	private:
+		Val*								_values;
+		size_type							_size;
+		word*								_raw;
+		size_type							_raw_size;
+		word*								_index;
+		size_type							_levels;
+		size_type							_offset[max_levels];
+		allocator_type						_allocator;
+		Compare								_comp;
+		typename search::function			_search;
+
+		size_type _lower_bound(const key_type& k) const {
+			if (_size == 0)
+				return 0;
+			return _search(_index, _offset, _levels, keys::encode(k));
+		}
+		// replaces the contents with n sorted, distinct values from first
+		template<class It>
+		void _build(It first, size_type n) {
+			clear();
+			if (n == 0)
+				return;
+			_values = _allocator.allocate(n);
+			size_type built = 0;
+			try {
+				for (; built < n; ++built, ++first)
+					_allocator.construct(&_values[built], *first);
+			}
+			catch (...) {
+				for (size_type k = 0; k < built; ++k)
+					_allocator.destroy(&_values[k]);
+				_allocator.deallocate(_values, n);
+				_values = 0;
+				throw;
+			}
+			_size = n;
+			try {
+				_build_index();
+			}
+			catch (...) {
+				clear();
+				throw;
+			}
+		}
+		void _build_index() {
+			size_type blocks[max_levels];
+			blocks[0] = (_size + node - 1) / node;
+			_levels = 1;
+			while (blocks[_levels - 1] > 1) {
+				blocks[_levels] = (blocks[_levels - 1] + node) / (node + 1);
+				++_levels;
+			}
+			size_type total = 0;
+			for (size_type h = _levels; h-- > 0;) {
+				_offset[h] = total;
+				total += blocks[h] * node;
+			}
+			// one spare node to round the start up to a cache line
+			word_allocator words(_allocator);
+			_raw_size = total + node;
+			_raw = words.allocate(_raw_size);
+			std::uintptr_t start = reinterpret_cast<std::uintptr_t>(_raw);
+			_index = _raw + ((64 - start % 64) % 64) / sizeof(word);
+			std::fill(_index, _index + total, std::numeric_limits<word>::max());
+			word* leaves = _index + _offset[0];
+			for (size_type i = 0; i < _size; ++i)
+				leaves[i] = keys::encode(KeyOfValue()(_values[i]));
+			// a block on level h starts at leaf block c * (node + 1)^h
+			size_type span = 1;
+			for (size_type h = 1; h < _levels; ++h, span *= node + 1) {
+				word* level = _index + _offset[h];
+				for (size_type j = 0; j < blocks[h]; ++j) {
+					for (size_type s = 0; s < node; ++s) {
+						size_type child = j * (node + 1) + s + 1;
+						if (child < blocks[h - 1])
+							level[j * node + s] = leaves[child * span * node];
+					}
+				}
+			}
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,400 @@
+#ifndef SKIP_LIST_HPP
+#define SKIP_LIST_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include "../utility/epoch.hpp"
+#include "pair.hpp"
+
+namespace ft {
+	// Tower of a lock-free skip list. next[i] is the link on level i with
+	// its low bit set once the node is erased, which freezes the link;
+	// the array runs past the struct for the node's height. pending is
+	// dropped by the inserter when it stops linking levels and by the
+	// eraser when it has marked them all, and the one dropping it last
+	// unlinks the node for good and retires it.
+	template <typename Val>
+	struct skipNode {
+		skipNode*					retired_next;
+		std::uint64_t				epoch;
+		std::atomic<int>			pending;
+		unsigned					height;
+		Val							val;
+		std::atomic<std::uintptr_t>	next[1];
+	};
+
+	// Walks level 0 past erased nodes; only good while the epoch the
+	// caller pinned before getting it is.
+	template <typename Val>
+	class skip_iterator {
+	public:
+		typedef Val							value_type;
+		typedef const Val&					reference;
+		typedef const Val*					pointer;
+		typedef std::forward_iterator_tag	iterator_category;
+		typedef std::ptrdiff_t				difference_type;
+		typedef skip_iterator<Val>			iterator;
+		typedef skipNode<Val>				node_type;
+
+		skip_iterator() : node(0) {}
+		explicit skip_iterator(node_type* x) : node(x) {}
+
+		reference operator*() const {
+			return node->val;
+		}
+		pointer operator->() const {
+			return &node->val;
+		}
+		iterator& operator++() {
+			node = live(next(node, 0));
+			return *this;
+		}
+		iterator operator++(int) {
+			iterator tmp = *this;
+			++*this;
+			return tmp;
+		}
+		bool operator==(const iterator& other) const {
+			return node == other.node;
+		}
+		bool operator!=(const iterator& other) const {
+			return node != other.node;
+		}
+
+		static bool marked(const node_type* x, unsigned level) {
+			return x->next[level].load(std::memory_order_acquire) & 1;
+		}
+		static node_type* next(const node_type* x, unsigned level) {
+			return reinterpret_cast<node_type*>(x->next[level].load(std::memory_order_acquire) & ~std::uintptr_t(1));
+		}
+		// x or the first node after it that is not erased
+		static node_type* live(node_type* x) {
+			while (x && marked(x, 0))
+				x = next(x, 0);
+			return x;
+		}
+
+		node_type* node;
+	};
+
+	// Lock-free ordered set of unique keys after Fraser and Herlihy-Shavit:
+	// a node is inserted by one CAS on level 0 and erased by marking its
+	// links top down, and searches unlink the marked nodes they pass.
+	// Every operation runs pinned in an epoch_domain, and unlinked nodes
+	// wait on a lock-free retired list until no pinned thread can reach
+	// them. No operation touches more than the links around its key, so
+	// writers on different keys do not wait for each other.
+	template<typename Key, typename Val, typename KeyOfValue, typename Compare = std::less<Key>, typename Alloc = std::allocator<Val> >
+	class skipList {
+	public:
+
+		typedef Val										value_type;
+		typedef Alloc									allocator_type;
+		typedef Key										key_type;
+		typedef std::size_t								size_type;
+		typedef skipNode<Val>							node_type;
+		typedef skip_iterator<Val>						iterator;
+		typedef skip_iterator<Val>						const_iterator;
+		typedef typename Alloc::template rebind<node_type>::other node_allocator;
+
+		// a quarter of the nodes reach each next level; 24 levels stay fast
+		// far beyond 2^40 nodes
+		static const unsigned max_height = 24;
+
+		skipList(const Compare& comp = Compare(), const allocator_type& a = allocator_type()) :
+			_allocator(a), _nodeAlloc(a), _comp(comp), _size(0), _height(1), _retired(0), _retires(0) {
+			_head = _nodeAlloc.allocate(_units(max_height));
+			_head->height = max_height;
+			for (unsigned i = 0; i < max_height; ++i)
+				new (&_head->next[i]) std::atomic<std::uintptr_t>(0);
+		}
+		// no thread may still be using the list
+		~skipList() {
+			node_type* x = iterator::next(_head, 0);
+			while (x) {
+				node_type* n = iterator::next(x, 0);
+				_destroy_node(x);
+				x = n;
+			}
+			for (x = _retired.load(std::memory_order_acquire); x;) {
+				node_type* n = x->retired_next;
+				_destroy_node(x);
+				x = n;
+			}
+			_nodeAlloc.deallocate(_head, _units(max_height));
+		}
+		iterator begin() const {
+			epoch_domain::guard g(_domain);
+			return iterator(iterator::live(iterator::next(_head, 0)));
+		}
+		void clear() {
+			epoch_domain::guard g(_domain);
+			for (node_type* x = iterator::live(iterator::next(_head, 0)); x; x = iterator::live(iterator::next(x, 0)))
+				erase(KeyOfValue()(x->val));
+		}
+		template<class K>
+		size_type count(const K& k) const {
+			return find(k) == end() ? 0 : 1;
+		}
+		epoch_domain& domain() const {
+			return _domain;
+		}
+		bool empty() const {
+			return size() == 0;
+		}
+		iterator end() const {
+			return iterator();
+		}
+		size_type erase(const key_type& k) {
+			epoch_domain::guard g(_domain);
+			node_type* preds[max_height];
+			node_type* succs[max_height];
+			if (!_search(k, preds, succs))
+				return 0;
+			node_type* victim = succs[0];
+			for (unsigned i = victim->height - 1; i > 0; --i) {
+				std::uintptr_t s = victim->next[i].load(std::memory_order_acquire);
+				while (!(s & 1) && !victim->next[i].compare_exchange_weak(s, s | 1, std::memory_order_acq_rel))
+					;
+			}
+			std::uintptr_t s = victim->next[0].load(std::memory_order_acquire);
+			for (;;) {
+				// another thread erased it first
+				if (s & 1)
+					return 0;
+				if (victim->next[0].compare_exchange_weak(s, s | 1, std::memory_order_acq_rel))
+					break;
+			}
+			_size.fetch_sub(1, std::memory_order_relaxed);
+			_release(victim);
+			return 1;
+		}
+		template<class K>
+		iterator find(const K& k) const {
+			iterator j = lower_bound(k);
+			return (j == end() || _comp(k, KeyOfValue()(*j))) ? end() : j;
+		}
+		allocator_type get_allocator() const {
+			return _allocator;
+		}
+		ft::pair<iterator, bool> insert(const value_type& val) {
+			epoch_domain::guard g(_domain);
+			const key_type& k = KeyOfValue()(val);
+			node_type* preds[max_height];
+			node_type* succs[max_height];
+			node_type* z = 0;
+			for (;;) {
+				if (_search(k, preds, succs)) {
+					if (z)
+						_destroy_node(z);
+					return ft::pair<iterator, bool>(iterator(succs[0]), false);
+				}
+				if (!z)
+					z = _create_node(val, _random_height());
+				for (unsigned i = 0; i < z->height; ++i)
+					z->next[i].store(_bits(succs[i]), std::memory_order_relaxed);
+				std::uintptr_t expected = _bits(succs[0]);
+				if (preds[0]->next[0].compare_exchange_strong(expected, _bits(z), std::memory_order_acq_rel))
+					break;
+			}
+			_size.fetch_add(1, std::memory_order_relaxed);
+			_raise(z->height);
+			// the upper levels only speed up searches, so give up on them
+			// once the node has been erased
+			for (unsigned i = 1; i < z->height; ++i) {
+				for (;;) {
+					std::uintptr_t s = z->next[i].load(std::memory_order_acquire);
+					if (s & 1)
+						goto linked;
+					if (s != _bits(succs[i]) && !z->next[i].compare_exchange_strong(s, _bits(succs[i]), std::memory_order_acq_rel))
+						goto linked;
+					std::uintptr_t expected = _bits(succs[i]);
+					if (preds[i]->next[i].compare_exchange_strong(expected, _bits(z), std::memory_order_acq_rel))
+						break;
+					_search(k, preds, succs);
+					if (iterator::marked(z, 0))
+						goto linked;
+				}
+			}
+		linked:
+			_release(z);
+			return ft::pair<iterator, bool>(iterator(z), true);
+		}
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last) {
+			for (; first != last; ++first)
+				insert(*first);
+		}
+		Compare key_comp() const {
+			return _comp;
+		}
+		template<class K>
+		iterator lower_bound(const K& k) const {
+			epoch_domain::guard g(_domain);
+			node_type* pred = _head;
+			node_type* curr = 0;
+			for (unsigned i = _height.load(std::memory_order_relaxed); i-- > 0;) {
+				curr = iterator::next(pred, i);
+				while (curr && _comp(KeyOfValue()(curr->val), k)) {
+					pred = curr;
+					curr = iterator::next(curr, i);
+				}
+			}
+			return iterator(iterator::live(curr));
+		}
+		size_type max_size() const {
+			return _nodeAlloc.max_size();
+		}
+		// exact when no write is under way
+		size_type size() const {
+			return _size.load(std::memory_order_relaxed);
+		}
+		template<class K>
+		iterator upper_bound(const K& k) const {
+			epoch_domain::guard g(_domain);
+			node_type* pred = _head;
+			node_type* curr = 0;
+			for (unsigned i = _height.load(std::memory_order_relaxed); i-- > 0;) {
+				curr = iterator::next(pred, i);
+				while (curr && !_comp(k, KeyOfValue()(curr->val))) {
+					pred = curr;
+					curr = iterator::next(curr, i);
+				}
+			}
+			return iterator(iterator::live(curr));
+		}
+	private:
+		allocator_type				_allocator;
+		node_allocator				_nodeAlloc;
+		Compare						_comp;
+		node_type*					_head;
+		std::atomic<size_type>		_size;
+		std::atomic<unsigned>		_height;
+		std::atomic<node_type*>		_retired;
+		std::atomic<size_type>		_retires;
+		mutable epoch_domain		_domain;
+
+		skipList(const skipList&);
+		skipList& operator=(const skipList&);
+
+		static std::uintptr_t _bits(const node_type* x) {
+			return reinterpret_cast<std::uintptr_t>(x);
+		}
+		// node_type units holding a node with height links
+		static size_type _units(unsigned height) {
+			return 1 + ((height - 1) * sizeof(std::atomic<std::uintptr_t>) + sizeof(node_type) - 1) / sizeof(node_type);
+		}
+		static unsigned _random_height() {
+			static thread_local std::uint64_t state = 0;
+			if (!state)
+				state = reinterpret_cast<std::uintptr_t>(&state) | 1;
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			return 1 + __builtin_ctzll(state | (std::uint64_t(1) << (2 * (max_height - 1)))) / 2;
+		}
+		node_type* _create_node(const value_type& val, unsigned height) {
+			node_type* z = _nodeAlloc.allocate(_units(height));
+			try {
+				_allocator.construct(&z->val, val);
+			}
+			catch (...) {
+				_nodeAlloc.deallocate(z, _units(height));
+				throw;
+			}
+			z->retired_next = 0;
+			z->epoch = 0;
+			new (&z->pending) std::atomic<int>(2);
+			z->height = height;
+			for (unsigned i = 0; i < height; ++i)
+				new (&z->next[i]) std::atomic<std::uintptr_t>(0);
+			return z;
+		}
+		void _destroy_node(node_type* x) {
+			_allocator.destroy(&x->val);
+			_nodeAlloc.deallocate(x, _units(x->height));
+		}
+		void _raise(unsigned height) {
+			unsigned h = _height.load(std::memory_order_relaxed);
+			while (h < height && !_height.compare_exchange_weak(h, height, std::memory_order_relaxed))
+				;
+		}
+		// fills the last node before k and the first from k on, on every
+		// level, unlinking the marked nodes met on the way; true when level
+		// 0 holds k. through walks past the nodes equal to k as well, which
+		// is what makes sure a marked node with key k is gone from them all.
+		template<class K>
+		bool _search(const K& k, node_type** preds, node_type** succs, bool through = false) {
+		retry:
+			node_type* pred = _head;
+			node_type* curr = 0;
+			for (unsigned i = max_height; i-- > 0;) {
+				curr = iterator::next(pred, i);
+				for (;;) {
+					if (!curr)
+						break;
+					std::uintptr_t s = curr->next[i].load(std::memory_order_acquire);
+					if (s & 1) {
+						std::uintptr_t expected = _bits(curr);
+						if (!pred->next[i].compare_exchange_strong(expected, s & ~std::uintptr_t(1), std::memory_order_acq_rel))
+							goto retry;
+						curr = reinterpret_cast<node_type*>(s & ~std::uintptr_t(1));
+						continue;
+					}
+					if (through ? _comp(k, KeyOfValue()(curr->val)) : !_comp(KeyOfValue()(curr->val), k))
+						break;
+					pred = curr;
+					curr = reinterpret_cast<node_type*>(s);
+				}
+				preds[i] = pred;
+				succs[i] = curr;
+			}
+			return curr && !_comp(k, KeyOfValue()(curr->val));
+		}
+		// the inserter and the eraser are both done with x; the last of them
+		// unlinks it from every level and retires it
+		void _release(node_type* x) {
+			if (x->pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+				return;
+			node_type* preds[max_height];
+			node_type* succs[max_height];
+			_search(KeyOfValue()(x->val), preds, succs, true);
+			x->epoch = _domain.advance();
+			x->retired_next = _retired.load(std::memory_order_relaxed);
+			while (!_retired.compare_exchange_weak(x->retired_next, x, std::memory_order_release, std::memory_order_relaxed))
+				;
+			if (_retires.fetch_add(1, std::memory_order_relaxed) % 64 == 63)
+				_reclaim();
+		}
+		// frees the retired nodes no pinned thread can reach and puts the
+		// rest back
+		void _reclaim() {
+			node_type* x = _retired.exchange(0, std::memory_order_acquire);
+			std::uint64_t oldest = _domain.oldest();
+			node_type* kept = 0;
+			node_type* last = 0;
+			while (x) {
+				node_type* n = x->retired_next;
+				if (x->epoch <= oldest)
+					_destroy_node(x);
+				else {
+					x->retired_next = kept;
+					kept = x;
+					if (!last)
+						last = x;
+				}
+				x = n;
+			}
+			if (!kept)
+				return;
+			last->retired_next = _retired.load(std::memory_order_relaxed);
+			while (!_retired.compare_exchange_weak(last->retired_next, kept, std::memory_order_release, std::memory_order_relaxed))
+				;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef TREE_SELECT_HPP
+#define TREE_SELECT_HPP
+
+#include "rbtree.hpp"
+#include "arena_tree.hpp"
+#include "btree.hpp"
+
+namespace ft {
+	// the tree map and set are built on, picked by their NodePolicy
+	template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, typename NodePolicy>
+	struct tree_select {
+		typedef rbTree<Key, Val, KeyOfValue, Compare, Alloc, NodePolicy> type;
+	};
+	template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc>
+	struct tree_select<Key, Val, KeyOfValue, Compare, Alloc, ft::arena_nodes> {
+		typedef arenaTree<Key, Val, KeyOfValue, Compare, Alloc> type;
+	};
+	template <typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, std::size_t Bytes>
+	struct tree_select<Key, Val, KeyOfValue, Compare, Alloc, ft::btree_nodes<Bytes> > {
+		typedef bTree<Key, Val, KeyOfValue, Compare, Alloc, Bytes> type;
+	};
+}
+
+#endif
@@ -0,0 +1,166 @@
+#include "unordered_map.hpp"
+#include "../map/map.hpp"
+#include "../tree/pair.hpp"
+#include <unordered_map>
+#include <string>
+#include <cstdlib>
+
+// iteration order is unspecified, so contents are printed through an ordered map
+template <class K, class V>
+void print_map(const ft::unordered_map<K, V> &m)
+{
+	ft::map<K, V> sorted;
+	typename ft::unordered_map<K, V>::const_iterator begin = m.begin();
+	typename ft::unordered_map<K, V>::const_iterator end = m.end();
+	for (; begin != end; begin++)
+		sorted[begin->first] = begin->second;
+	std::cout << "size=\t\t" << m.size() << std::endl;
+	for (typename ft::map<K, V>::iterator it = sorted.begin(); it != sorted.end(); ++it)
+		std::cout << "\033[38;5;46m" << it->first << "->" << it->second << "\033[0m ";
+	std::cout << std::endl;
+}
+
+void umap_test_construct() {
+	ft::unordered_map<char, int> one;
+	one['a'] = 1;
+	one['b'] = 2;
+	one['c'] = 3;
+	print_map(one);
+	ft::unordered_map<char, int> two(one.begin(), one.end());
+	print_map(two);
+	ft::unordered_map<char, int> three(two);
+	print_map(three);
+	ft::unordered_map<char, int> four;
+	four = three;
+	print_map(four);
+	std::cout << (one == four) << " " << (one != four) << std::endl;
+	four['d'] = 4;
+	std::cout << (one == four) << " " << (one != four) << std::endl;
+}
+
+void umap_test_insert() {
+	ft::unordered_map<std::string, int> m;
+	std::cout << m.insert(ft::pair<const std::string, int>("one", 1)).second << std::endl;
+	std::cout << m.insert(ft::pair<const std::string, int>("one", 10)).second << std::endl;
+	std::cout << m.insert(ft::pair<const std::string, int>("two", 2)).first->second << std::endl;
+	m.insert(m.begin(), ft::pair<const std::string, int>("three", 3));
+	m["four"] = 4;
+	m["one"] += 100;
+	print_map(m);
+	std::cout << m.at("two") << std::endl;
+	try {
+		m.at("five");
+	}
+	catch (std::out_of_range&) {
+		std::cout << "out_of_range" << std::endl;
+	}
+}
+
+void umap_test_find_count() {
+	ft::unordered_map<int, int> m;
+	for (int i = 0; i < 100; ++i)
+		m[i * 3] = i;
+	std::cout << m.count(30) << m.count(31) << std::endl;
+	std::cout << (m.find(33)->second) << " " << (m.find(34) == m.end()) << std::endl;
+	ft::pair<ft::unordered_map<int, int>::iterator, ft::unordered_map<int, int>::iterator> r = m.equal_range(3);
+	std::cout << r.first->second << std::endl;
+	r = m.equal_range(4);
+	std::cout << (r.first == r.second) << std::endl;
+	const ft::unordered_map<int, int>& cm = m;
+	std::cout << cm.find(297)->second << " " << cm.at(0) << std::endl;
+}
+
+void umap_test_erase() {
+	ft::unordered_map<int, int> m;
+	for (int i = 0; i < 50; ++i)
+		m[i] = i * i;
+	std::cout << m.erase(10) << m.erase(10) << std::endl;
+	m.erase(m.find(20));
+	print_map(m);
+	m.erase(m.begin(), m.end());
+	print_map(m);
+	std::cout << m.empty() << std::endl;
+	for (int i = 0; i < 50; ++i)
+		m[i] = -i;
+	print_map(m);
+	m.clear();
+	print_map(m);
+}
+
+void umap_test_swap() {
+	ft::unordered_map<int, char> a;
+	ft::unordered_map<int, char> b;
+	a[1] = 'a';
+	a[2] = 'b';
+	b[3] = 'c';
+	a.swap(b);
+	print_map(a);
+	print_map(b);
+	swap(a, b);
+	print_map(a);
+	print_map(b);
+}
+
+void umap_test_reserve() {
+	ft::unordered_map<int, int> m;
+	m.reserve(1000);
+	std::size_t buckets = m.bucket_count();
+	for (int i = 0; i < 1000; ++i)
+		m[i] = i;
+	std::cout << (m.bucket_count() == buckets) << " " << (m.load_factor() <= m.max_load_factor()) << std::endl;
+	m.rehash(0);
+	std::cout << m.size() << " " << m[999] << std::endl;
+}
+
+// random inserts and erases against a long-lived table, so probing has to
+// walk past tombstones and the table rehashes at the same size
+void umap_test_stress() {
+	ft::unordered_map<int, int> m;
+	std::srand(42);
+	long long sum = 0;
+	for (int i = 0; i < 200000; ++i) {
+		int k = std::rand() % 5000;
+		if (std::rand() % 3 == 0)
+			m.erase(k);
+		else
+			m[k] += i;
+	}
+	for (ft::unordered_map<int, int>::iterator it = m.begin(); it != m.end(); ++it)
+		sum += it->first * 31LL + it->second;
+	std::cout << m.size() << " " << sum << std::endl;
+	for (int k = 0; k < 5000; ++k)
+		sum -= m.count(k);
+	std::cout << sum << std::endl;
+}
+
+// a mapped type that counts how often it is built
+static int counted_built = 0;
+
+struct counted {
+	int v;
+	counted() : v(0) {
+		++counted_built;
+	}
+	counted(const counted& other) : v(other.v) {
+		++counted_built;
+	}
+};
+
+// operator[] builds a mapped value only for a key it inserts
+void umap_test_subscript_hit() {
+	ft::unordered_map<int, counted> m;
+	for (int i = 0; i < 100; ++i)
+		m[i % 10].v += i;
+	std::cout << m.size() << " " << m[3].v << " " << (counted_built <= 20) << std::endl;
+}
+
+int main() {
+	umap_test_construct();
+	umap_test_insert();
+	umap_test_find_count();
+	umap_test_erase();
+	umap_test_swap();
+	umap_test_reserve();
+	umap_test_stress();
+	umap_test_subscript_hit();
+}
@@ -0,0 +1,177 @@
+#ifndef UNORDERED_MAP_HPP
+#define UNORDERED_MAP_HPP
+
+#include <iostream>
+#include <stdexcept>
+#include "../hash/hash_table.hpp"
+#include "../map/get_first.hpp"
+
+namespace ft {
+	template <class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+		class Allocator = std::allocator<ft::pair<const Key, T> > >
+	class unordered_map {
+	public:
+
+		// DEF
+
+		typedef Key									key_type;
+		typedef T									mapped_type;
+		typedef ft::pair<const Key, T>				value_type;
+		typedef std::size_t							size_type;
+		typedef std::ptrdiff_t						difference_type;
+		typedef Hash								hasher;
+		typedef KeyEqual							key_equal;
+		typedef Allocator							allocator_type;
+		typedef value_type&							reference;
+		typedef const value_type&					const_reference;
+		typedef typename Allocator::pointer			pointer;
+		typedef typename Allocator::const_pointer	const_pointer;
+	private:
+		typedef hashTable<key_type, value_type, ft::get_first<value_type>, hasher, key_equal, allocator_type> table;
+		table _table;
+	public:
+		typedef typename table::iterator iterator;
+		typedef typename table::const_iterator const_iterator;
+
+		// CONSTRUCTORS + DESTRUCTOR
+
+		explicit unordered_map(size_type n = 0, const hasher& hf = hasher(), const key_equal& eql = key_equal(),
+			const allocator_type& alloc = allocator_type()) : _table(n, hf, eql, alloc) {}
+
+		template<class InputIterator>
+		unordered_map(InputIterator first, InputIterator last, size_type n = 0, const hasher& hf = hasher(),
+			const key_equal& eql = key_equal(), const allocator_type& alloc = allocator_type()) :
+				_table(n, hf, eql, alloc) {
+			_table.insert(first, last);
+		}
+
+		unordered_map(const unordered_map& x) : _table(x._table) {}
+
+		// OPERATORS
+
+		unordered_map& operator=(const unordered_map& other) {
+			_table = other._table;
+			return *this;
+		}
+		mapped_type& operator[](const key_type& k) {
+			return (*_table.try_emplace(k).first).second;
+		}
+
+		// MEMBER FUNCTIONS
+
+		mapped_type& at(const key_type& k) {
+			iterator it = find(k);
+			if (it == end())
+				throw std::out_of_range("unordered_map::at");
+			return (*it).second;
+		}
+		const mapped_type& at(const key_type& k) const {
+			const_iterator it = find(k);
+			if (it == end())
+				throw std::out_of_range("unordered_map::at");
+			return (*it).second;
+		}
+		iterator begin() {
+			return _table.begin();
+		}
+		const_iterator begin() const {
+			return _table.begin();
+		}
+		size_type bucket_count() const {
+			return _table.bucket_count();
+		}
+		void clear() {
+			_table.clear();
+		}
+		size_type count(const key_type& k) const {
+			return _table.count(k);
+		}
+		bool empty() const {
+			return _table.empty();
+		}
+		iterator end() {
+			return _table.end();
+		}
+		const_iterator end() const {
+			return _table.end();
+		}
+		ft::pair<iterator, iterator> equal_range(const key_type& k) {
+			return _table.equal_range(k);
+		}
+		ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+			return _table.equal_range(k);
+		}
+		void erase(iterator position) {
+			_table.erase(position);
+		}
+		size_type erase(const key_type& k) {
+			return _table.erase(k);
+		}
+		void erase(iterator first, iterator last) {
+			_table.erase(first, last);
+		}
+		iterator find(const key_type& k) {
+			return _table.find(k);
+		}
+		const_iterator find(const key_type& k) const {
+			return _table.find(k);
+		}
+		allocator_type get_allocator() const {
+			return _table.get_allocator();
+		}
+		hasher hash_function() const {
+			return _table.hash_function();
+		}
+		ft::pair<iterator, bool> insert(const value_type& val) {
+			return _table.insert(val);
+		}
+		iterator insert(const_iterator, const value_type& val) {
+			return _table.insert(val).first;
+		}
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last) {
+			_table.insert(first, last);
+		}
+		key_equal key_eq() const {
+			return _table.key_eq();
+		}
+		float load_factor() const {
+			return _table.load_factor();
+		}
+		float max_load_factor() const {
+			return _table.max_load_factor();
+		}
+		size_type max_size() const {
+			return _table.max_size();
+		}
+		void rehash(size_type n) {
+			_table.rehash(n);
+		}
+		void reserve(size_type n) {
+			_table.reserve(n);
+		}
+		size_type size() const {
+			return _table.size();
+		}
+		void swap(unordered_map& x) {
+			_table.swap(x._table);
+		}
+		template<typename K, typename T1, typename H, typename E, typename Alloc>
+		friend bool operator==(const unordered_map<K, T1, H, E, Alloc>& x, const unordered_map<K, T1, H, E, Alloc>& y);
+	};
+
+	template<typename K, typename T1, typename H, typename E, typename Alloc>
+	inline bool operator==(const unordered_map<K, T1, H, E, Alloc>& x, const unordered_map<K, T1, H, E, Alloc>& y) {
+		return x._table == y._table;
+	}
+	template<typename K, typename T1, typename H, typename E, typename Alloc>
+	inline bool operator!=(const unordered_map<K, T1, H, E, Alloc>& x, const unordered_map<K, T1, H, E, Alloc>& y) {
+		return !(x == y);
+	}
+	template<typename K, typename T1, typename H, typename E, typename Alloc>
+	inline void swap(unordered_map<K, T1, H, E, Alloc>& x, unordered_map<K, T1, H, E, Alloc>& y) {
+		x.swap(y);
+	}
+}
+
+#endif
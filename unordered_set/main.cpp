@@ -0,0 +1,105 @@
+#include "unordered_set.hpp"
+#include "../set/set.hpp"
+#include "../tree/pair.hpp"
+#include <unordered_set>
+#include <string>
+#include <cstdlib>
+
+// iteration order is unspecified, so contents are printed through an ordered set
+template <class T1>
+void print_set(const ft::unordered_set<T1> &v)
+{
+	ft::set<T1> sorted;
+	typename ft::unordered_set<T1>::const_iterator begin = v.begin();
+	typename ft::unordered_set<T1>::const_iterator end = v.end();
+	for (; begin != end; begin++)
+		sorted.insert(*begin);
+	std::cout << "size=\t\t" << v.size() << std::endl;
+	for (typename ft::set<T1>::iterator it = sorted.begin(); it != sorted.end(); ++it)
+		std::cout << "\033[38;5;46m" << *it << "\033[0m ";
+	std::cout << std::endl;
+}
+
+void uset_test_construct() {
+	ft::unordered_set<char> one;
+	one.insert('a');
+	one.insert('b');
+	one.insert('c');
+	print_set(one);
+	ft::unordered_set<char> two(one.begin(), one.end());
+	print_set(two);
+	ft::unordered_set<char> three(two);
+	print_set(three);
+	ft::unordered_set<char> four;
+	four = three;
+	print_set(four);
+	std::cout << (one == four) << " " << (one != four) << std::endl;
+	four.insert('d');
+	std::cout << (one == four) << " " << (one != four) << std::endl;
+}
+
+void uset_test_insert_find() {
+	ft::unordered_set<std::string> s;
+	std::cout << s.insert("one").second << s.insert("one").second << std::endl;
+	std::cout << *s.insert("two").first << std::endl;
+	s.insert(s.begin(), "three");
+	print_set(s);
+	std::cout << s.count("two") << s.count("four") << std::endl;
+	std::cout << (s.find("four") == s.end()) << " " << *s.find("three") << std::endl;
+	ft::pair<ft::unordered_set<std::string>::iterator, ft::unordered_set<std::string>::iterator> r = s.equal_range("one");
+	std::cout << *r.first << std::endl;
+}
+
+void uset_test_erase() {
+	ft::unordered_set<int> s;
+	for (int i = 0; i < 64; ++i)
+		s.insert(i * 7);
+	std::cout << s.erase(14) << s.erase(14) << std::endl;
+	s.erase(s.find(21));
+	print_set(s);
+	s.erase(s.begin(), s.end());
+	print_set(s);
+	for (int i = 0; i < 10; ++i)
+		s.insert(i);
+	print_set(s);
+	s.clear();
+	std::cout << s.empty() << std::endl;
+}
+
+void uset_test_swap() {
+	ft::unordered_set<int> a;
+	ft::unordered_set<int> b;
+	a.insert(1);
+	b.insert(2);
+	b.insert(3);
+	a.swap(b);
+	print_set(a);
+	print_set(b);
+	swap(a, b);
+	print_set(a);
+	print_set(b);
+}
+
+void uset_test_stress() {
+	ft::unordered_set<int> s;
+	std::srand(7);
+	for (int i = 0; i < 200000; ++i) {
+		int k = std::rand() % 3000;
+		if (std::rand() % 2)
+			s.erase(k);
+		else
+			s.insert(k);
+	}
+	long long sum = 0;
+	for (ft::unordered_set<int>::iterator it = s.begin(); it != s.end(); ++it)
+		sum += *it;
+	std::cout << s.size() << " " << sum << std::endl;
+}
+
+int main() {
+	uset_test_construct();
+	uset_test_insert_find();
+	uset_test_erase();
+	uset_test_swap();
+	uset_test_stress();
+}
@@ -0,0 +1,152 @@
+#ifndef UNORDERED_SET_HPP
+#define UNORDERED_SET_HPP
+
+#include <iostream>
+#include "../hash/hash_table.hpp"
+#include "../set/ret_value.hpp"
+
+namespace ft {
+	template <class T, class Hash = std::hash<T>, class KeyEqual = std::equal_to<T>, class Allocator = std::allocator<T> >
+	class unordered_set {
+	public:
+
+		// DEF
+
+		typedef T									key_type;
+		typedef T									value_type;
+		typedef std::size_t							size_type;
+		typedef std::ptrdiff_t						difference_type;
+		typedef Hash								hasher;
+		typedef KeyEqual							key_equal;
+		typedef Allocator							allocator_type;
+		typedef const value_type&					reference;
+		typedef const value_type&					const_reference;
+		typedef typename Allocator::const_pointer	pointer;
+		typedef typename Allocator::const_pointer	const_pointer;
+	private:
+		typedef hashTable<key_type, value_type, ft::ret_value<value_type>, hasher, key_equal, allocator_type> table;
+		table _table;
+	public:
+		typedef typename table::const_iterator iterator;
+		typedef typename table::const_iterator const_iterator;
+
+		// CONSTRUCTORS + DESTRUCTOR
+
+		explicit unordered_set(size_type n = 0, const hasher& hf = hasher(), const key_equal& eql = key_equal(),
+			const allocator_type& alloc = allocator_type()) : _table(n, hf, eql, alloc) {}
+
+		template<class InputIterator>
+		unordered_set(InputIterator first, InputIterator last, size_type n = 0, const hasher& hf = hasher(),
+			const key_equal& eql = key_equal(), const allocator_type& alloc = allocator_type()) :
+				_table(n, hf, eql, alloc) {
+			_table.insert(first, last);
+		}
+
+		unordered_set(const unordered_set& x) : _table(x._table) {}
+
+		// OPERATORS
+
+		unordered_set& operator=(const unordered_set& other) {
+			_table = other._table;
+			return *this;
+		}
+
+		// MEMBER FUNCTIONS
+
+		iterator begin() const {
+			return _table.begin();
+		}
+		size_type bucket_count() const {
+			return _table.bucket_count();
+		}
+		void clear() {
+			_table.clear();
+		}
+		size_type count(const key_type& k) const {
+			return _table.count(k);
+		}
+		bool empty() const {
+			return _table.empty();
+		}
+		iterator end() const {
+			return _table.end();
+		}
+		ft::pair<iterator, iterator> equal_range(const key_type& k) const {
+			return _table.equal_range(k);
+		}
+		void erase(iterator position) {
+			_table.erase(_mutable(position));
+		}
+		size_type erase(const key_type& k) {
+			return _table.erase(k);
+		}
+		void erase(iterator first, iterator last) {
+			_table.erase(_mutable(first), _mutable(last));
+		}
+		iterator find(const key_type& k) const {
+			return _table.find(k);
+		}
+		allocator_type get_allocator() const {
+			return _table.get_allocator();
+		}
+		hasher hash_function() const {
+			return _table.hash_function();
+		}
+		ft::pair<iterator, bool> insert(const value_type& val) {
+			ft::pair<typename table::iterator, bool> res = _table.insert(val);
+			return ft::pair<iterator, bool>(res.first, res.second);
+		}
+		iterator insert(iterator, const value_type& val) {
+			return _table.insert(val).first;
+		}
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last) {
+			_table.insert(first, last);
+		}
+		key_equal key_eq() const {
+			return _table.key_eq();
+		}
+		float load_factor() const {
+			return _table.load_factor();
+		}
+		float max_load_factor() const {
+			return _table.max_load_factor();
+		}
+		size_type max_size() const {
+			return _table.max_size();
+		}
+		void rehash(size_type n) {
+			_table.rehash(n);
+		}
+		void reserve(size_type n) {
+			_table.reserve(n);
+		}
+		size_type size() const {
+			return _table.size();
+		}
+		void swap(unordered_set& x) {
+			_table.swap(x._table);
+		}
+		template<typename T1, typename H, typename E, typename Alloc>
+		friend bool operator==(const unordered_set<T1, H, E, Alloc>& x, const unordered_set<T1, H, E, Alloc>& y);
+	private:
+		static typename table::iterator _mutable(iterator it) {
+			return typename table::iterator(const_cast<ctrl_t*>(it.ctrl), const_cast<value_type*>(it.slot));
+		}
+	};
+
+	template<typename T1, typename H, typename E, typename Alloc>
+	inline bool operator==(const unordered_set<T1, H, E, Alloc>& x, const unordered_set<T1, H, E, Alloc>& y) {
+		return x._table == y._table;
+	}
+	template<typename T1, typename H, typename E, typename Alloc>
+	inline bool operator!=(const unordered_set<T1, H, E, Alloc>& x, const unordered_set<T1, H, E, Alloc>& y) {
+		return !(x == y);
+	}
+	template<typename T1, typename H, typename E, typename Alloc>
+	inline void swap(unordered_set<T1, H, E, Alloc>& x, unordered_set<T1, H, E, Alloc>& y) {
+		x.swap(y);
+	}
+}
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef EPOCH_HPP
+#define EPOCH_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+namespace ft {
+	// Epoch-based reclamation for structures read without locks. A reader
+	// pins the current epoch in a free slot for the length of one read;
+	// memory unlinked by a writer is retired with the epoch that followed
+	// the unlink and may be freed once oldest() has reached it, as no
+	// pinned reader can still see it by then. A thread entering a domain
+	// it is already in reuses its slot, so guards nest.
+	class epoch_domain {
+	public:
+		static const std::size_t max_readers = 128;
+		// domains one thread can be inside at once
+		static const std::size_t max_entered = 16;
+
+		epoch_domain() : _epoch(1) {
+			for (std::size_t i = 0; i < max_readers; ++i)
+				_slots[i].epoch.store(0, std::memory_order_relaxed);
+		}
+
+		// a reader's guard; guards nest on one thread, and a new one spins
+		// when every slot is taken
+		class guard {
+		public:
+			explicit guard(epoch_domain& d) : _domain(d), _slot(d.enter()) {}
+			~guard() {
+				_domain.leave(_slot);
+			}
+		private:
+			guard(const guard&);
+			guard& operator=(const guard&);
+
+			epoch_domain&	_domain;
+			std::size_t		_slot;
+		};
+
+		// starts the next epoch after an unlink and returns it: memory
+		// unlinked before the call is retired with this value
+		std::uint64_t advance() {
+			return _epoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+		}
+		// pins the current epoch for this thread, or just counts the entry
+		// when the thread is already in: its slot holds an epoch no later
+		// than the current one, which keeps at least as much alive
+		std::size_t enter() {
+			static thread_local std::size_t hint = std::hash<std::thread::id>()(std::this_thread::get_id()) % max_readers;
+			entry* free = 0;
+			for (std::size_t k = 0; k < max_entered; ++k) {
+				entry& en = _entered()[k];
+				if (en.depth && en.domain == this) {
+					++en.depth;
+					return en.slot;
+				}
+				if (!en.depth && !free)
+					free = &en;
+			}
+			if (!free)
+				throw std::length_error("epoch_domain::enter");
+			std::size_t i = hint;
+			for (;;) {
+				std::uint64_t idle = 0;
+				std::uint64_t e = _epoch.load(std::memory_order_seq_cst);
+				if (_slots[i].epoch.compare_exchange_strong(idle, e, std::memory_order_seq_cst)) {
+					hint = i;
+					free->domain = this;
+					free->slot = i;
+					free->depth = 1;
+					return i;
+				}
+				i = (i + 1) % max_readers;
+				if (i == hint)
+					std::this_thread::yield();
+			}
+		}
+		// undoes one enter() on this thread; the slot is freed by the last
+		void leave(std::size_t slot) {
+			for (std::size_t k = 0; k < max_entered; ++k) {
+				entry& en = _entered()[k];
+				if (en.depth && en.domain == this) {
+					if (--en.depth == 0)
+						_slots[slot].epoch.store(0, std::memory_order_release);
+					return;
+				}
+			}
+		}
+		// the earliest epoch a reader is still pinned at, or the current
+		// one when there is no reader
+		std::uint64_t oldest() const {
+			std::uint64_t min = _epoch.load(std::memory_order_seq_cst);
+			for (std::size_t i = 0; i < max_readers; ++i) {
+				std::uint64_t e = _slots[i].epoch.load(std::memory_order_seq_cst);
+				if (e && e < min)
+					min = e;
+			}
+			return min;
+		}
+	private:
+		struct alignas(64) slot {
+			std::atomic<std::uint64_t> epoch;
+		};
+		// a domain the calling thread is in, and how many guards deep
+		struct entry {
+			const epoch_domain*	domain;
+			std::size_t			slot;
+			std::size_t			depth;
+		};
+
+		static entry* _entered() {
+			static thread_local entry entered[max_entered];
+			return entered;
+		}
+
+		alignas(64) std::atomic<std::uint64_t>	_epoch;
+		slot									_slots[max_readers];
+
+		epoch_domain(const epoch_domain&);
+		epoch_domain& operator=(const epoch_domain&);
+	};
+}
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef MEMORY_HPP
+#define MEMORY_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include "type_traits.hpp"
+
+namespace ft {
+
+	// Element-wise construction on raw storage. Every routine works on
+	// [first, last) and writes into uninitialized memory at dest.
+	// Elements are moved only when their move constructor cannot throw.
+	// copy, fill and move build all or nothing: on a throw, what they
+	// built is destroyed again.
+
+	template <bool Trivial>
+	struct uninitialized_base {
+		template <class Alloc, class InPtr, class OutPtr>
+		static OutPtr copy(Alloc& al, InPtr first, InPtr last, OutPtr dest) {
+			OutPtr out = dest;
+			try {
+				for (; first != last; ++first, ++out)
+					al.construct(out, *first);
+			}
+			catch (...) {
+				destroy(al, dest, out);
+				throw;
+			}
+			return out;
+		}
+		template <class Alloc, class Ptr, class T>
+		static Ptr fill(Alloc& al, Ptr dest, std::size_t n, const T& val) {
+			Ptr out = dest;
+			try {
+				for (; n > 0; --n, ++out)
+					al.construct(out, val);
+			}
+			catch (...) {
+				destroy(al, dest, out);
+				throw;
+			}
+			return out;
+		}
+		// into storage apart from the source, which is left for the caller
+		// to destroy once everything it needs is built
+		template <class Alloc, class Ptr>
+		static Ptr move(Alloc& al, Ptr first, Ptr last, Ptr dest) {
+			Ptr out = dest;
+			try {
+				for (; first != last; ++first, ++out)
+					al.construct(out, std::move_if_noexcept(*first));
+			}
+			catch (...) {
+				destroy(al, dest, out);
+				throw;
+			}
+			return out;
+		}
+		// shifts within one buffer, destroying each source as it goes;
+		// dest may overlap the source only if dest < first
+		template <class Alloc, class Ptr>
+		static Ptr relocate(Alloc& al, Ptr first, Ptr last, Ptr dest) {
+			for (; first != last; ++first, ++dest) {
+				al.construct(dest, std::move_if_noexcept(*first));
+				al.destroy(first);
+			}
+			return dest;
+		}
+		// dest_last may overlap the source only if dest_last > last
+		template <class Alloc, class Ptr>
+		static Ptr relocate_backward(Alloc& al, Ptr first, Ptr last, Ptr dest_last) {
+			while (last != first) {
+				--last, --dest_last;
+				al.construct(dest_last, std::move_if_noexcept(*last));
+				al.destroy(last);
+			}
+			return dest_last;
+		}
+		template <class Alloc, class Ptr>
+		static void destroy(Alloc& al, Ptr first, Ptr last) {
+			for (; first != last; ++first)
+				al.destroy(first);
+		}
+	};
+
+	template <>
+	struct uninitialized_base<true> {
+		template <class Alloc, class T>
+		static T* copy(Alloc&, const T* first, const T* last, T* dest) {
+			if (first != last)
+				std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), (last - first) * sizeof(T));
+			return dest + (last - first);
+		}
+		template <class Alloc, class T>
+		static T* fill(Alloc&, T* dest, std::size_t n, const T& val) {
+			for (; n > 0; --n, ++dest)
+				*dest = val;
+			return dest;
+		}
+		template <class Alloc, class T>
+		static T* move(Alloc&, T* first, T* last, T* dest) {
+			if (first != last)
+				std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), (last - first) * sizeof(T));
+			return dest + (last - first);
+		}
+		template <class Alloc, class T>
+		static T* relocate(Alloc&, T* first, T* last, T* dest) {
+			if (first != last)
+				std::memmove(static_cast<void*>(dest), static_cast<const void*>(first), (last - first) * sizeof(T));
+			return dest + (last - first);
+		}
+		template <class Alloc, class T>
+		static T* relocate_backward(Alloc&, T* first, T* last, T* dest_last) {
+			if (first != last)
+				std::memmove(static_cast<void*>(dest_last - (last - first)), static_cast<const void*>(first), (last - first) * sizeof(T));
+			return dest_last - (last - first);
+		}
+		template <class Alloc, class T>
+		static void destroy(Alloc&, T*, T*) {}
+	};
+
+	// Bulk memcpy/memmove is only used when the default allocator is in
+	// play, so a user allocator's construct/destroy is never bypassed.
+	template <class T, class Alloc>
+	struct uninitialized : uninitialized_base<ft::is_trivially_copyable<T>::value
+											  && ft::is_same<Alloc, std::allocator<T> >::value> {
+	};
+}
+
+#endif
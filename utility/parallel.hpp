@@ -0,0 +1,65 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace ft {
+	// how many threads work of this size is worth: one per grain units,
+	// and no more than the machine runs at once
+	inline std::size_t parallel_threads(std::size_t work, std::size_t grain) {
+		std::size_t threads = std::thread::hardware_concurrency();
+		if (threads > work / grain)
+			threads = work / grain;
+		return threads ? threads : 1;
+	}
+
+	// Runs f(i) for every i below tasks on up to threads threads, the
+	// caller being one of them, each taking the next task from a shared
+	// counter. If fewer threads start, the ones there do the rest. The
+	// first exception thrown is rethrown once every thread has joined.
+	template <class F>
+	void parallel_for(std::size_t tasks, std::size_t threads, F f) {
+		if (threads > tasks)
+			threads = tasks;
+		if (threads <= 1) {
+			for (std::size_t i = 0; i < tasks; ++i)
+				f(i);
+			return;
+		}
+		std::atomic<std::size_t> next(0);
+		std::exception_ptr error;
+		std::mutex error_lock;
+		auto run = [tasks, &f, &next, &error, &error_lock]() {
+			for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < tasks;) {
+				try {
+					f(i);
+				}
+				catch (...) {
+					std::lock_guard<std::mutex> lock(error_lock);
+					if (!error)
+						error = std::current_exception();
+				}
+			}
+		};
+		std::unique_ptr<std::thread[]> pool(new std::thread[threads - 1]);
+		std::size_t started = 0;
+		try {
+			for (; started < threads - 1; ++started)
+				pool[started] = std::thread(run);
+		}
+		catch (...) {
+		}
+		run();
+		for (std::size_t t = 0; t < started; ++t)
+			pool[t].join();
+		if (error)
+			std::rethrow_exception(error);
+	}
+}
+
+#endif
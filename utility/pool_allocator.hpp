@@ -0,0 +1,155 @@
+#ifndef POOL_ALLOCATOR_HPP
+#define POOL_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <utility>
+#include "type_traits.hpp"
+
+namespace ft {
+	// Slab allocator for single objects (tree nodes). Memory is carved out of
+	// chunks that double in size up to MaxChunk slots; freed slots go to an
+	// intrusive free list and all chunks are returned at once by release().
+	// Every instance owns its own pool: copies start empty, moves steal.
+	template <class T, std::size_t MaxChunk = 4096>
+	class pool_allocator {
+	public:
+		typedef T					value_type;
+		typedef T*					pointer;
+		typedef const T*			const_pointer;
+		typedef T&					reference;
+		typedef const T&			const_reference;
+		typedef std::size_t			size_type;
+		typedef std::ptrdiff_t		difference_type;
+
+		template <class U>
+		struct rebind {
+			typedef pool_allocator<U, MaxChunk> other;
+		};
+
+		pool_allocator() : _chunks(0), _free(0), _next(0), _end(0), _chunk_size(_first_chunk) {}
+		pool_allocator(const pool_allocator&) : _chunks(0), _free(0), _next(0), _end(0), _chunk_size(_first_chunk) {}
+		template <class U>
+		pool_allocator(const pool_allocator<U, MaxChunk>&) : _chunks(0), _free(0), _next(0), _end(0), _chunk_size(_first_chunk) {}
+		pool_allocator(pool_allocator&& other) noexcept : _chunks(other._chunks), _free(other._free),
+			_next(other._next), _end(other._end), _chunk_size(other._chunk_size) {
+			other._reset();
+		}
+		~pool_allocator() {
+			release();
+		}
+
+		pool_allocator& operator=(const pool_allocator&) {
+			return *this;
+		}
+		pool_allocator& operator=(pool_allocator&& other) noexcept {
+			if (this != &other) {
+				release();
+				_chunks = other._chunks, _free = other._free;
+				_next = other._next, _end = other._end;
+				_chunk_size = other._chunk_size;
+				other._reset();
+			}
+			return *this;
+		}
+
+		pointer address(reference x) const {
+			return &x;
+		}
+		const_pointer address(const_reference x) const {
+			return &x;
+		}
+		pointer allocate(size_type n, const void* = 0) {
+			if (n != 1)
+				return static_cast<pointer>(::operator new(n * sizeof(T)));
+			if (_free != 0) {
+				slot* s = _free;
+				_free = s->next;
+				return reinterpret_cast<pointer>(s);
+			}
+			if (_next == _end)
+				_grow();
+			return reinterpret_cast<pointer>(_next++);
+		}
+		void deallocate(pointer p, size_type n) {
+			if (n != 1) {
+				::operator delete(p);
+				return;
+			}
+			slot* s = reinterpret_cast<slot*>(p);
+			s->next = _free;
+			_free = s;
+		}
+		template <class U, class... Args>
+		void construct(U* p, Args&&... args) {
+			::new(static_cast<void*>(p)) U(std::forward<Args>(args)...);
+		}
+		template <class U>
+		void destroy(U* p) {
+			p->~U();
+		}
+		size_type max_size() const {
+			return std::numeric_limits<size_type>::max() / sizeof(T);
+		}
+		// frees every chunk; objects still living in the pool are not destroyed
+		void release() {
+			while (_chunks != 0) {
+				slot* prev = _chunks->next;
+				::operator delete(_chunks);
+				_chunks = prev;
+			}
+			_reset();
+		}
+
+		template <class U, std::size_t M>
+		friend class pool_allocator;
+	private:
+		union slot {
+			slot* next;
+			alignas(T) unsigned char data[sizeof(T)];
+		};
+		static const size_type _first_chunk = 16;
+
+		slot*		_chunks;
+		slot*		_free;
+		slot*		_next;
+		slot*		_end;
+		size_type	_chunk_size;
+
+		// the first slot of every chunk links to the previous chunk
+		void _grow() {
+			slot* chunk = static_cast<slot*>(::operator new(_chunk_size * sizeof(slot)));
+			chunk->next = _chunks;
+			_chunks = chunk;
+			_next = chunk + 1;
+			_end = chunk + _chunk_size;
+			if (_chunk_size < MaxChunk)
+				_chunk_size *= 2;
+		}
+		void _reset() {
+			_chunks = 0, _free = 0, _next = 0, _end = 0;
+			_chunk_size = _first_chunk;
+		}
+	};
+
+	template <class T, class U, std::size_t M>
+	inline bool operator==(const pool_allocator<T, M>& x, const pool_allocator<U, M>& y) {
+		return static_cast<const void*>(&x) == static_cast<const void*>(&y);
+	}
+	template <class T, class U, std::size_t M>
+	inline bool operator!=(const pool_allocator<T, M>& x, const pool_allocator<U, M>& y) {
+		return !(x == y);
+	}
+
+	// Allocators whose release() drops every allocation at once; containers
+	// use it to tear down in O(chunks) instead of freeing node by node.
+	template <class Alloc>
+	struct has_bulk_release : ft::false_type {
+	};
+	template <class T, std::size_t M>
+	struct has_bulk_release<pool_allocator<T, M> > : ft::true_type {
+	};
+}
+
+#endif
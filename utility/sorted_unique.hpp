@@ -0,0 +1,13 @@
+#ifndef SORTED_UNIQUE_HPP
+#define SORTED_UNIQUE_HPP
+
+namespace ft {
+	// Tag for range constructors: the input is already sorted by the
+	// container's comparator and holds no equivalent keys.
+	struct sorted_unique_t {
+		sorted_unique_t() {}
+	};
+	static const sorted_unique_t sorted_unique = sorted_unique_t();
+}
+
+#endif
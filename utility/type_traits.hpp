@@ -2,6 +2,15 @@
 #define TYPE_TRAITS_HPP
 
 namespace ft {
+	template <typename T, T v>
+	struct integral_constant {
+		const static T value = v;
+		typedef T value_type;
+		typedef integral_constant type;
+	};
+	typedef integral_constant<bool, true> true_type;
+	typedef integral_constant<bool, false> false_type;
+
 	template <typename T>
 	struct remove_const {
 		typedef T type;
@@ -72,6 +81,34 @@ namespace ft {
 		const static bool value = is_integral_base<typename remove_const<T>::type>::value;
 	};
 
+	template <typename T>
+	struct is_trivially_copyable {
+		const static bool value = __is_trivially_copyable(T);
+	};
+
+	template <typename T>
+	struct is_trivially_destructible {
+		const static bool value = __has_trivial_destructor(T);
+	};
+
+	template <typename T, typename U>
+	struct is_same {
+		const static bool value = false;
+	};
+	template <typename T>
+	struct is_same<T, T> {
+		const static bool value = true;
+	};
+
+	template <bool B, class T, class F>
+	struct conditional {
+		typedef T type;
+	};
+	template <class T, class F>
+	struct conditional<false, T, F> {
+		typedef F type;
+	};
+
 	template<bool B, class T = void>
 	struct enable_if {
 
@@ -80,6 +117,21 @@ namespace ft {
 	struct enable_if<true, T> {
 		typedef T type;
 	};
+
+	template <class T>
+	struct void_type {
+		typedef void type;
+	};
+
+	// Comparators that define is_transparent compare keys of any type they
+	// accept; K only keeps the check inside overload resolution.
+	template <class Compare, class K, class = void>
+	struct transparent_key {
+	};
+	template <class Compare, class K>
+	struct transparent_key<Compare, K, typename void_type<typename Compare::is_transparent>::type> {
+		typedef K type;
+	};
 }
 
 #endif
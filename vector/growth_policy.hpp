@@ -0,0 +1,21 @@
+#ifndef GROWTH_POLICY_HPP
+#define GROWTH_POLICY_HPP
+
+#include <cstddef>
+
+namespace ft {
+	// Capacity growth for ft::vector: grow(cap) returns the next capacity,
+	// the vector then takes the max of that and what it actually needs.
+	template <std::size_t Num, std::size_t Den>
+	struct geometric_growth {
+		static std::size_t grow(std::size_t cap) {
+			std::size_t next = cap / Den * Num + cap % Den * Num / Den;
+			return (next > cap) ? next : cap + 1;
+		}
+	};
+
+	typedef geometric_growth<2, 1> double_growth;
+	typedef geometric_growth<3, 2> one_and_half_growth;
+}
+
+#endif
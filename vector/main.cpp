@@ -1,5 +1,7 @@
 #include <iostream>
 #include <vector>
+#include <stdexcept>
+#include <string>
 #include "vector.hpp"
 
 class B
@@ -630,6 +632,112 @@ void test_swap() {
 	b.swap(c);
 }
 
+void test_relocation() {
+	ft::vector<std::string> str;
+	for (int i = 0; i < 50; ++i)
+		str.push_back(std::string(20 + i, 'a' + i % 26));
+	str.insert(str.begin() + 3, "inserted");
+	str.insert(str.begin() + 5, 10, "filled");
+	str.insert(str.end() - 2, str.begin(), str.begin() + 4);
+	str.erase(str.begin() + 1, str.begin() + 6);
+	str.erase(str.begin() + 7);
+	str.resize(100, "resized");
+	str.reserve(500);
+	str.resize(20);
+	ft::vector<std::string> str_copy(str);
+	std::cout << "size=\t\t" << str_copy.size() << std::endl;
+	for (size_t i = 0; i < str_copy.size(); i++)
+		std::cout << str_copy[i] << ' ';
+	std::cout << std::endl;
+
+	ft::vector<double> dbl;
+	for (int i = 0; i < 1000; ++i)
+		dbl.insert(dbl.begin() + dbl.size() / 2, i * 0.5);
+	dbl.erase(dbl.begin() + 100, dbl.begin() + 900);
+	ft::vector<double> dbl_copy;
+	dbl_copy = dbl;
+	std::cout << "size=\t\t" << dbl_copy.size() << std::endl;
+	for (size_t i = 0; i < dbl_copy.size(); i++)
+		std::cout << dbl_copy[i] << ' ';
+	std::cout << std::endl;
+}
+
+void test_move() {
+	ft::vector<std::string> a;
+	std::string s(40, 's');
+	a.push_back(std::move(s));
+	a.push_back(std::string(40, 't'));
+	for (int i = 0; i < 20; ++i)
+		a.emplace_back(10 + i, 'a' + i);
+	a.emplace(a.begin() + 3, "emplaced");
+	a.emplace(a.end(), 5, 'e');
+	a.emplace(a.begin(), a[4]);
+	a.insert(a.begin() + 2, std::string("moved in"));
+	std::string &back = a.emplace_back("back");
+	back += "!";
+	ft::vector<std::string> b(std::move(a));
+	std::cout << "size=\t\t" << b.size() << ' ' << a.size() << std::endl;
+	ft::vector<std::string> c;
+	c.push_back("old");
+	c = std::move(b);
+	std::cout << "size=\t\t" << c.size() << ' ' << b.size() << std::endl;
+	for (size_t i = 0; i < c.size(); i++)
+		std::cout << c[i] << ' ';
+	std::cout << std::endl;
+}
+
+// a copy that throws once its budget runs out, and a move that may throw,
+// so growing has to copy and may fail half way
+struct fragile {
+	static int budget;
+	std::string s;
+	fragile(const std::string& str) : s(str) {}
+	fragile(const fragile& other) : s(other.s) {
+		if (budget-- == 0)
+			throw std::runtime_error("fragile copy");
+	}
+	fragile(fragile&& other) : s(other.s) {
+		if (budget-- == 0)
+			throw std::runtime_error("fragile move");
+	}
+	fragile& operator=(const fragile& other) {
+		s = other.s;
+		return *this;
+	}
+};
+
+int fragile::budget = -1;
+
+void test_throwing_copy() {
+	ft::vector<fragile> v;
+	for (int i = 0; i < 8; ++i)
+		v.push_back(fragile(std::string(20, 'a' + i)));
+	v.reserve(v.size());
+	fragile extra(std::string(20, 'z'));
+	for (int fail_at = 0; fail_at < 10; ++fail_at) {
+		fragile::budget = fail_at;
+		try {
+			v.push_back(extra);
+		}
+		catch (std::runtime_error& e) {
+			std::cout << e.what() << ' ';
+		}
+		fragile::budget = -1;
+		std::cout << v.size() << ' ' << v[0].s << ' ' << v[v.size() - 1].s[0] << std::endl;
+		v.resize(8, extra);
+		ft::vector<fragile>(v).swap(v);
+	}
+	fragile::budget = 3;
+	try {
+		v.insert(v.begin() + 2, 20, extra);
+	}
+	catch (std::runtime_error& e) {
+		std::cout << e.what() << ' ';
+	}
+	fragile::budget = -1;
+	std::cout << v.size() << ' ' << v[2].s[0] << std::endl;
+}
+
 int main()
 {
 	test_reverse_iterators();
@@ -650,4 +758,7 @@ int main()
 	test_pop_back();
 	test_insert();
 	test_swap();
+	test_relocation();
+	test_move();
+	test_throwing_copy();
 }
@@ -2,12 +2,15 @@
 #define VECTOR_HPP
 
 #include <iostream>
+#include <utility>
 #include "../iterator/RandomAccess.hpp"
 #include "../utility/type_traits.hpp"
 #include "../utility/algorithm.hpp"
+#include "../utility/memory.hpp"
 #include "../iterator/reverse_iterator.hpp"
+#include "growth_policy.hpp"
 namespace ft {
-	template <class T, class Allocator = std::allocator<T> >
+	template <class T, class Allocator = std::allocator<T>, class GrowthPolicy = ft::double_growth>
 	class vector {
 	public:
 
@@ -15,6 +18,7 @@ namespace ft {
 
 		typedef T										value_type;
 		typedef Allocator								allocator_type;
+		typedef GrowthPolicy							growth_policy;
 		typedef std::size_t								size_type;
 		typedef std::ptrdiff_t							difference_type;
 		typedef value_type&								reference;
@@ -32,24 +36,28 @@ namespace ft {
 
 		explicit vector(const Allocator & al)  : _vec(0), _size(0), _capacity(0), _allocator(al) {}
 
-		explicit vector(size_type n) : _size(n), _capacity(n) {
+		// each element value-initialized in place, as std::vector does, not
+		// copied from one temporary
+		explicit vector(size_type n) : _size(0), _capacity(n) {
 			_vec = _allocator.allocate(n);
-			for (size_type i = 0; i < n; i++) {
-				_allocator.construct(_vec + i, T());
+			try {
+				for (; _size < n; ++_size)
+					_allocator.construct(_vec + _size);
+			}
+			catch (...) {
+				_uninit::destroy(_allocator, _vec, _vec + _size);
+				_allocator.deallocate(_vec, _capacity);
+				throw;
 			}
 		}
 		vector(size_type n, const T & val) : _size(n), _capacity(n), _allocator(allocator_type()) {
 			_vec = _allocator.allocate(n);
-			for (size_type i = 0; i < n; i++) {
-				_allocator.construct(_vec + i, val);
-			}
+			_uninit::fill(_allocator, _vec, n, val);
 		}
 
 		vector(size_type n, const T & val, const Allocator & al) : _size(n), _capacity(n), _allocator(al) {
 			_vec = _allocator.allocate(n);
-			for (size_type i = 0; i < n; i++) {
-				_allocator.construct(_vec + i, val);
-			}
+			_uninit::fill(_allocator, _vec, n, val);
 		}
 
 		template<class It>
@@ -67,14 +75,17 @@ namespace ft {
 			_size = other.size();
 			_capacity = other.capacity();
 			_vec = _allocator.allocate(_capacity);
-			for (size_type i = 0; i < _size; i++)
-				_allocator.construct(_vec + i, *(other._vec + i));
+			_uninit::copy(_allocator, other._vec, other._vec + _size, _vec);
+		}
+
+		vector(vector && other) noexcept : _vec(other._vec), _size(other._size), _capacity(other._capacity),
+			_allocator(std::move(other._allocator)) {
+			other._vec = 0, other._size = 0, other._capacity = 0;
 		}
 
 		~vector() {
 			if (_vec != 0) {
-//				for (size_type i = 0; i < _size; i++)
-//					_allocator.destroy(_vec + i);
+				_uninit::destroy(_allocator, _vec, _vec + _size);
 				_allocator.deallocate(_vec, _capacity);
 			}
 			_vec = 0, _size = 0, _capacity = 0;
@@ -105,9 +116,7 @@ namespace ft {
                 _vec = _allocator.allocate(_capacity);
             }
             _size = n;
-            for (size_type i = 0; i < n; ++i) {
-                _allocator.construct(_vec + i, val);
-            }
+            _uninit::fill(_allocator, _vec, n, val);
 		}
 		reference at(size_type n) {
 			if (size() <= n)
@@ -135,12 +144,53 @@ namespace ft {
 			return _capacity;
 		}
 		void clear() {
-			if (_vec != 0) {
-				for (size_type i = 0; _vec + i != _vec + _size; i++)
-					_allocator.destroy(_vec + i);
-			}
+			if (_vec != 0)
+				_uninit::destroy(_allocator, _vec, _vec + _size);
 			_size = 0;
 		}
+		template<class... Args>
+		iterator emplace(const_iterator position, Args&&... args) {
+			size_type pos = position - const_iterator(_vec);
+			if (_size == _capacity) {
+				size_type new_cap = _next_capacity(_size + 1);
+				pointer temp_arr = _allocator.allocate(new_cap);
+				try {
+					_allocator.construct(temp_arr + pos, std::forward<Args>(args)...);
+				}
+				catch (...) {
+					_allocator.deallocate(temp_arr, new_cap);
+					throw;
+				}
+				_relocate_around(temp_arr, new_cap, pos, 1);
+			}
+			else if (pos == _size)
+				_allocator.construct(_vec + pos, std::forward<Args>(args)...);
+			else {
+				value_type tmp(std::forward<Args>(args)...);
+				_uninit::relocate_backward(_allocator, _vec + pos, _vec + _size, _vec + _size + 1);
+				_allocator.construct(_vec + pos, std::move(tmp));
+			}
+			_size++;
+			return begin() + pos;
+		}
+		template<class... Args>
+		reference emplace_back(Args&&... args) {
+			if (_size == _capacity) {
+				size_type new_cap = _next_capacity(_size + 1);
+				pointer temp_arr = _allocator.allocate(new_cap);
+				try {
+					_allocator.construct(temp_arr + _size, std::forward<Args>(args)...);
+				}
+				catch (...) {
+					_allocator.deallocate(temp_arr, new_cap);
+					throw;
+				}
+				_relocate_around(temp_arr, new_cap, _size, 1);
+			}
+			else
+				_allocator.construct(_vec + _size, std::forward<Args>(args)...);
+			return _vec[_size++];
+		}
 		bool empty() const {
 			return size() == 0;
 		}
@@ -151,31 +201,17 @@ namespace ft {
 			return const_iterator(_vec + _size);
 		}
 		iterator erase(iterator position) {
-			if (position == end() - 1) {
-				_allocator.destroy(_vec + _size);
-				_size--;
-				return position;
-			}
-			size_type pos = std::distance(begin(), position);
-			_allocator.destroy(_vec + pos);
-			for (size_type i = pos; i < _size - 1; ++i) {
-				_allocator.construct(_vec + i, *(_vec + i + 1));
-			}
-			_size--;
-			return begin() + pos;
+			return erase(position, position + 1);
 		}
 		iterator erase(iterator first, iterator last) {
 			size_type posf = std::distance(begin(), first);
 			size_type posl = std::distance(begin(), last);
-			size_type len = std::distance(begin(), end());
-			_size -= (posl - posf);
-			for (size_type i = posf; i < posl; ++i) {
-				_allocator.destroy(_vec + i);
+			if (posf != posl) {
+				_uninit::destroy(_allocator, _vec + posf, _vec + posl);
+				_uninit::relocate(_allocator, _vec + posl, _vec + _size, _vec + posf);
+				_size -= (posl - posf);
 			}
-			for (size_type i = posl; i < len; ++i) {
-				_allocator.construct(_vec + posf++, *(_vec + i));
-			}
-			return begin() + posl;
+			return begin() + posf;
 		}
 		reference front() {
 			return (*begin());
@@ -189,77 +225,37 @@ namespace ft {
         iterator insert (iterator position, const value_type & val) {
 			if (position < begin() || (_capacity ==  0 && position != begin()))
 				throw std::out_of_range("out of range 🤡");
-            size_type pos = std::distance(begin(), position);
-            if (_size == _capacity) {
-                _capacity = (_capacity == 0) ? 1 : _capacity * 2;
-                pointer temp_arr = _allocator.allocate(_capacity);
-                for (size_type i = 0; i < pos; ++i)
-                    _allocator.construct(temp_arr + i, *(_vec + i));
-                _allocator.construct(temp_arr + pos, val);
-                _size++;
-                for (size_type i = pos; i < _size - 1; ++i)
-					_allocator.construct(temp_arr + i + 1, *(_vec + i));
-                _allocator.deallocate(_vec, _size - 1);
-                _vec = temp_arr;
-            }
-            else {
-                for (size_type i = _size; i > pos; i--) {
-					_allocator.construct(_vec + i, *(_vec + i - 1));
-					_allocator.destroy(_vec + i - 1);
-				}
-                _allocator.construct(_vec + pos, val);
-                _size++;
-            }
-            return begin() + pos;
+            return emplace(position, val);
+        }
+        iterator insert (iterator position, value_type && val) {
+			if (position < begin() || (_capacity ==  0 && position != begin()))
+				throw std::out_of_range("out of range 🤡");
+            return emplace(position, std::move(val));
         }
         void insert(iterator position, size_type n, const value_type & val) {
 			if (position < begin() || (_capacity ==  0 && position != begin()))
 				throw std::out_of_range("out of range 🤡");
             size_type pos = std::distance(begin(), position);
             if (_size + n > _capacity) {
-                size_type temp_cap = _capacity;
-                _capacity = (_capacity == 0) ? 1 : _capacity * 2;
-                if (_capacity < _size + n)
-                    _capacity = _size + n;
-                pointer temp_arr = _allocator.allocate(_capacity);
-                size_type i, j;
-                for (i = 0; i < pos; ++i)
-					_allocator.construct(temp_arr + i, *(_vec + i));
-                for (j = pos; j < pos + n; ++j)
-                    _allocator.construct(temp_arr + j, val);
-                for (; i < _size; ++i, ++j)
-					_allocator.construct(temp_arr + j, *(_vec + i));
-                _allocator.deallocate(_vec, temp_cap);
-                _vec = temp_arr;
-                _size += n;
-            }
-            else {
-                size_type cnt;
-                if (pos + n > _size) {
-                    cnt = _size - pos;
-                    _size += n;
-                    for (size_type i = _size - 1; cnt > 0; --i, --cnt) {
-						_allocator.construct(_vec + i, *(_vec + i - n));
-						_allocator.destroy(_vec + i - n);
-					}
-                    for (size_type i = pos; i < pos + n; ++i)
-                        _allocator.construct(_vec + i, val);
+                size_type new_cap = _next_capacity(_size + n);
+                pointer temp_arr = _allocator.allocate(new_cap);
+                try {
+                    _uninit::fill(_allocator, temp_arr + pos, n, val);
                 }
-                else
-                {
-                    _size += n;
-                    for (size_type i = _size - 1; i > pos + n - 1; i--) {
-						_allocator.construct(_vec + i, *(_vec + i - n));
-						_allocator.destroy(_vec + i - n);
-					}
-                    for (size_type i = pos; i < pos + n; ++i)
-                        _allocator.construct(_vec + i, val);
+                catch (...) {
+                    _allocator.deallocate(temp_arr, new_cap);
+                    throw;
                 }
+                _relocate_around(temp_arr, new_cap, pos, n);
+            }
+            else {
+                _uninit::relocate_backward(_allocator, _vec + pos, _vec + _size, _vec + _size + n);
+                _uninit::fill(_allocator, _vec + pos, n, val);
             }
+            _size += n;
         }
         template<class InputIterator>
-        void insert(InputIterator position,
-                    typename enable_if<!is_integral<InputIterator>::value, InputIterator>::type first,
+        void insert(iterator position, InputIterator first,
                     typename enable_if<!is_integral<InputIterator>::value, InputIterator>::type last) {
 			if (position < begin() || (_capacity ==  0 && position != begin()))
 				throw std::out_of_range("out of range 🤡");
@@ -268,45 +264,26 @@ namespace ft {
             size_type pos = std::distance(begin(), position);
             size_type num = std::distance(first, last);
             if (_size + num > _capacity) {
-                _size += num;
-                size_type temp_cap = _capacity;
-                _capacity = (_capacity == 0) ? 1 : _capacity * 2;
-                if (_capacity < _size)
-                    _capacity = _size;
-                pointer temp_arr = _allocator.allocate(_capacity);
-                size_type i, j = 0;
-                for (i = 0; i < pos; ++i, ++j)
-					_allocator.construct(temp_arr + i, *(_vec + i));
-				for (; first != last; first++, i++)
-                    _allocator.construct(temp_arr + i, *first);
-                for (; i < _size; ++i, ++j)
-					_allocator.construct(temp_arr + i, *(_vec + j));
-                _allocator.deallocate(_vec, temp_cap);
-                _vec = temp_arr;
-            }
-            else {
-                size_type cnt;
-                if (pos + num > _size) {
-                    cnt = _size - pos;
-                    _size += num;
-                    for (size_type i = _size - 1; cnt > 0; --i, --cnt) {
-						_allocator.construct(_vec + i, *(_vec + i - num));
-						_allocator.destroy(_vec + i - num);
-					}
-                    for (size_type i = pos; first != last; first++, i++)
-                        _allocator.construct(_vec + i, *first);
+                size_type new_cap = _next_capacity(_size + num);
+                pointer temp_arr = _allocator.allocate(new_cap);
+                size_type i = pos;
+                try {
+                    for (; first != last; first++, i++)
+                        _allocator.construct(temp_arr + i, *first);
                 }
-                else
-                {
-                    _size += num;
-                    for (size_type i = _size - 1; i > pos + num - 1; i--) {
-						_allocator.construct(_vec + i, *(_vec + i - num));
-						_allocator.destroy(_vec + i - num);
-					}
-                    for (size_type i = pos; first != last; first++, i++)
-                        _allocator.construct(_vec + i, *first);
+                catch (...) {
+                    _uninit::destroy(_allocator, temp_arr + pos, temp_arr + i);
+                    _allocator.deallocate(temp_arr, new_cap);
+                    throw;
                 }
+                _relocate_around(temp_arr, new_cap, pos, num);
             }
+            else {
+                _uninit::relocate_backward(_allocator, _vec + pos, _vec + _size, _vec + _size + num);
+                for (size_type i = pos; first != last; first++, i++)
+                    _allocator.construct(_vec + i, *first);
+            }
+            _size += num;
         }
 		size_type max_size() const {
 			return _allocator.max_size();
@@ -320,8 +297,18 @@ namespace ft {
 				_capacity = other._capacity;
 				_size = other._size;
 				_vec = _allocator.allocate(_capacity);
-				for (size_type i = 0; i < _size; ++i)
-					_allocator.construct(_vec + i, *(other._vec + i));
+				_uninit::copy(_allocator, other._vec, other._vec + _size, _vec);
+			}
+			return *this;
+		}
+		vector & operator=(vector && other) noexcept {
+			if (this != &other) {
+				clear();
+				if (_vec != 0)
+					_allocator.deallocate(_vec, _capacity);
+				_allocator = std::move(other._allocator);
+				_vec = other._vec, _size = other._size, _capacity = other._capacity;
+				other._vec = 0, other._size = 0, other._capacity = 0;
 			}
 			return *this;
 		}
@@ -335,28 +322,10 @@ namespace ft {
 			erase(end() - 1);
 		}
 		void push_back(const T & val) {
-			_size++;
-			if (_capacity == 0) {
-			    _capacity = 1;
-			    _vec = _allocator.allocate(_capacity);
-			}
-			if (_size > _capacity) {
-				pointer temp_arr = _allocator.allocate(_size);
-				for (size_type i = 0; i < _size - 1; i++) {
-					_allocator.construct(temp_arr + i, *(_vec + i));
-					_allocator.destroy(_vec + i);
-				}
-				_allocator.construct(temp_arr + _size - 1, val);
-				_allocator.deallocate(_vec, _capacity);
-				_capacity *= 2;
-				_vec = _allocator.allocate(_capacity);
-				for (size_type i = 0; i < _size; ++i)
-					_allocator.construct(_vec + i, *(temp_arr + i));
-				_allocator.deallocate(temp_arr, _size);
-			}
-			else {
-				_allocator.construct(_vec + _size - 1, val);
-			}
+			emplace_back(val);
+		}
+		void push_back(T && val) {
+			emplace_back(std::move(val));
 		}
 		reverse_iterator rbegin() {
 			return reverse_iterator(_vec + _size);
@@ -373,54 +342,22 @@ namespace ft {
 		void reserve(size_type new_cap) {
 		    if (max_size() < new_cap)
                 throw std::length_error("vector");
-		    else if (capacity() < new_cap) {
-		        pointer temp_arr = _allocator.allocate(new_cap);
-                for (size_type i = 0; i < _size; i++) {
-                    _allocator.construct(temp_arr + i, *(_vec + i));
-                    _allocator.destroy(_vec + i);
-                }
-                _allocator.deallocate(_vec, _capacity);
-                _capacity = new_cap;
-                _vec = _allocator.allocate(_capacity);
-                for (size_type i = 0; i < _size; ++i)
-                    _allocator.construct(_vec + i, *(temp_arr + i));
-                _allocator.deallocate(temp_arr, new_cap);
-		    }
+		    else if (capacity() < new_cap)
+		        _reallocate(new_cap);
 		}
 		void resize(size_type n, T val = value_type()) {
 			if (n > max_size()) {
 				throw (std::length_error("vector"));
 			}
 		    if (_size > n) {
-                for (size_type i = n; i < _size; ++i)
-                    _allocator.destroy(_vec + i);
+                _uninit::destroy(_allocator, _vec + n, _vec + _size);
                 _size = n;
 		    }
 		    else if (_size < n) {
-		        if (_capacity < n) {
-		            pointer temp_arr = _allocator.allocate(_size);
-		            for (size_type i = 0; i < _size; ++i) {
-		                _allocator.construct(temp_arr + i, *(_vec + i));
-		                _allocator.destroy(_vec + i);
-		            }
-		            _allocator.deallocate(_vec, _capacity);
-		            _capacity *= 2;
-		            if (capacity() < n)
-		                _capacity = n;
-		            _vec = _allocator.allocate(_capacity);
-		            size_type i;
-                    for (i = 0; i < _size; ++i)
-                        _allocator.construct(_vec + i, *(temp_arr + i));
-                    for (; i < n; ++i)
-                        _allocator.construct(_vec + i, val);
-                    _size = n;
-                    _allocator.deallocate(temp_arr, _size);
-		        }
-		        else {
-                    for (size_type i = _size; i < n; ++i)
-                        _allocator.construct(_vec + i, val);
-                    _size = n;
-		        }
+		        if (_capacity < n)
+		            _reallocate(_next_capacity(n));
+                _uninit::fill(_allocator, _vec + _size, n - _size, val);
+                _size = n;
 		    }
 		}
 		size_type size() const {
@@ -432,43 +369,92 @@ namespace ft {
 			std::swap(_capacity, x._capacity);
 		}
 	private:
+		typedef ft::uninitialized<T, Allocator> _uninit;
+
 		pointer _vec;
 		size_type _size, _capacity;
 		allocator_type _allocator;
+
+		size_type _next_capacity(size_type required) const {
+			if (required > max_size())
+				throw std::length_error("vector");
+			size_type grown = growth_policy::grow(_capacity);
+			if (grown > max_size() || grown < _capacity)
+				grown = max_size();
+			return (grown < required) ? required : grown;
+		}
+		void _reallocate(size_type new_cap) {
+			pointer temp_arr = _allocator.allocate(new_cap);
+			try {
+				_uninit::move(_allocator, _vec, _vec + _size, temp_arr);
+			}
+			catch (...) {
+				_allocator.deallocate(temp_arr, new_cap);
+				throw;
+			}
+			_adopt(temp_arr, new_cap);
+		}
+		// moves the current elements into temp_arr leaving a gap of n slots
+		// at pos (already filled by the caller) and adopts temp_arr; if a
+		// copy throws, temp_arr and the gap are dropped and the old buffer
+		// is left whole
+		void _relocate_around(pointer temp_arr, size_type new_cap, size_type pos, size_type n) {
+			pointer built = temp_arr;
+			try {
+				built = _uninit::move(_allocator, _vec, _vec + pos, temp_arr);
+				_uninit::move(_allocator, _vec + pos, _vec + _size, temp_arr + pos + n);
+			}
+			catch (...) {
+				_uninit::destroy(_allocator, temp_arr, built);
+				_uninit::destroy(_allocator, temp_arr + pos, temp_arr + pos + n);
+				_allocator.deallocate(temp_arr, new_cap);
+				throw;
+			}
+			_adopt(temp_arr, new_cap);
+		}
+		// the elements are all built in temp_arr: drops the old ones
+		void _adopt(pointer temp_arr, size_type new_cap) {
+			if (_vec != 0) {
+				_uninit::destroy(_allocator, _vec, _vec + _size);
+				_allocator.deallocate(_vec, _capacity);
+			}
+			_vec = temp_arr;
+			_capacity = new_cap;
+		}
 	};
 
-	template <typename T, typename Alloc>
-	inline bool operator==(const vector<T, Alloc> & x, const vector<T, Alloc> & y) {
+	template <typename T, typename Alloc, typename Growth>
+	inline bool operator==(const vector<T, Alloc, Growth> & x, const vector<T, Alloc, Growth> & y) {
 		if (x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin()))
 			return true;
 		else
 			return false;
 	}
-	template<typename T, typename Alloc>
-	inline bool operator!=(const vector<T, Alloc> & x, const vector<T, Alloc> & y) {
+	template<typename T, typename Alloc, typename Growth>
+	inline bool operator!=(const vector<T, Alloc, Growth> & x, const vector<T, Alloc, Growth> & y) {
 		if (x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin()))
 			return false;
 		else
 			return true;
 	}
-	template <typename T, typename Alloc>
-	inline bool operator<(const vector<T, Alloc> & x, const vector<T, Alloc> & y) {
+	template <typename T, typename Alloc, typename Growth>
+	inline bool operator<(const vector<T, Alloc, Growth> & x, const vector<T, Alloc, Growth> & y) {
 		return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
 	}
-	template <typename T, typename Alloc>
-	inline bool operator<=(const vector<T, Alloc> & x, const vector<T, Alloc> & y) {
+	template <typename T, typename Alloc, typename Growth>
+	inline bool operator<=(const vector<T, Alloc, Growth> & x, const vector<T, Alloc, Growth> & y) {
 		return !(y < x);
 	}
-	template <typename T, typename Alloc>
-	inline bool operator>(const vector<T, Alloc> & x, const vector<T, Alloc> & y) {
+	template <typename T, typename Alloc, typename Growth>
+	inline bool operator>(const vector<T, Alloc, Growth> & x, const vector<T, Alloc, Growth> & y) {
 		return y < x;
 	}
-	template <typename T, typename Alloc>
-	inline bool operator>=(const vector<T, Alloc> & x, const vector<T, Alloc> & y) {
+	template <typename T, typename Alloc, typename Growth>
+	inline bool operator>=(const vector<T, Alloc, Growth> & x, const vector<T, Alloc, Growth> & y) {
 		return !(x < y);
 	}
-	template <typename T, typename Alloc>
-	inline void swap(vector<T, Alloc> & x, vector<T, Alloc> & y) {
+	template <typename T, typename Alloc, typename Growth>
+	inline void swap(vector<T, Alloc, Growth> & x, vector<T, Alloc, Growth> & y) {
 		x.swap(y);
 	}
 }